@@ -53,8 +53,8 @@ void addBackup(int varIndex, IntegerSet domain, varPos seqPos, Backup backup) {
 	}
 }
 
-void printBackup(Backup b) {
-  addLog("BEGIN BACKUP\n");
+void printBackup(FILE *out, Backup b) {
+  fprintf(out, "BEGIN BACKUP\n");
   BackupList list = b->first;
   while(list != NULL) {
     Variable v = list->sequencePos.var;
@@ -67,10 +67,10 @@ void printBackup(Backup b) {
     if(list->sequencePos.next != NULL) {
       nextIdx = indexOfVar(list->sequencePos.next->var);
     } 
-    addLog("Variable X%d, prev: %d, next: %d\n", varIndex, prevIdx, nextIdx);
+    fprintf(out, "Variable X%d, prev: %d, next: %d\n", varIndex, prevIdx, nextIdx);
     list = list->next;
   }
-  addLog("END BACKUP\n");
+  fprintf(out, "END BACKUP\n");
 }
 
 
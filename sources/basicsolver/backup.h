@@ -27,7 +27,7 @@ void freeBackup(Backup db);
 void restoreBackup(Backup db, Problem p);
 void addBackup(int varIndex, IntegerSet domain, varPos sequencePos, Backup db);
 
-void printBackup(Backup b);
+void printBackup(FILE *out, Backup b);
 
 
 #endif
@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "binary.h"
+#include "solve.h"
+#include "stats.h"
+#include "data.h"
+#include "batch.h"
+
+typedef struct instance {
+	char *path;
+	char *name;					/* used in the output, the path if not named */
+} instance;
+
+typedef struct batch {
+	instance *instances;
+	int count;
+	int next;					/* first instance not taken by a worker */
+	pthread_mutex_t lock;		/* guards next and the standard output */
+	int optionCount;			/* solver options of every worker */
+	char **options;
+	char *model;				/* binary image of -model, NULL: instances are models */
+	size_t modelSize;
+	char *streamFormat;			/* NULL: values in the JSON objects */
+	char *streamDir;
+} batch;
+
+/* reads the instances of the list file, one per line, optionally followed by a tab and a name */
+static void readList(batch *b, char *listPath) {
+	FILE *list = fopen(listPath, "r");
+	char *line = NULL, *tab;
+	size_t space = 0;
+	ssize_t length;
+	int allocated = 0;
+
+	if(list == NULL) {
+		fprintf(stderr, "[ERROR] Could not open file %s\n", listPath);
+		exit(-1);
+	}
+	b->instances = NULL;
+	b->count = 0;
+	while((length = getline(&line, &space, list)) != -1) {
+		while(length > 0 && (line[length-1] == '\n' || line[length-1] == '\r')) {
+			line[--length] = '\0';
+		}
+		if(length == 0) {
+			continue;
+		}
+		if(b->count == allocated) {
+			allocated = (allocated == 0 ? 64 : 2*allocated);
+			b->instances = safeRealloc(b->instances, allocated*sizeof(instance));
+		}
+		b->instances[b->count].path = strdup(line);
+		tab = strchr(b->instances[b->count].path, '\t');
+		if(tab != NULL) {
+			*tab = '\0';
+			b->instances[b->count].name = tab+1;
+		} else {
+			b->instances[b->count].name = b->instances[b->count].path;
+		}
+		b->count++;
+	}
+	free(line);
+	fclose(list);
+}
+
+/* callback sink writing the solutions as JSON arrays, separated by commas */
+static int emitJSON(const int *values, int varCount, void *data) {
+	FILE *out = data;
+	int i;
+	if(ftell(out) > 0) {
+		fputc(',', out);
+	}
+	fputc('[', out);
+	for(i = 0; i < varCount; i++) {
+		fprintf(out, (i == 0 ? "%d" : ",%d"), values[i]);
+	}
+	fputc(']', out);
+	return 0;
+}
+
+static double secondsSince(struct timespec *start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec)*1.0e-9;
+}
+
+/* solves instance i and writes its JSON object to out */
+static void solveInstance(batch *b, Solver s, int i, FILE *out) {
+	char *data, *values = NULL, output[4096];
+	size_t size, valuesSize;
+	FILE *valuesOut = NULL;
+	SolutionSink sink;
+	struct timespec start;
+	Problem p;
+	int count, ok;
+
+	fprintf(out, "{\"index\":%d,\"instance\":", i);
+	printJSONString(out, b->instances[i].name);
+	/* csp leaves out the instances it could not ground or translate */
+	data = readFileContents(b->instances[i].path, &size);
+	if(data == NULL) {
+		fprintf(out, ",\"error\":\"could not read file\"}\n");
+		return;
+	}
+	if(b->model != NULL) {
+		/* the instance is data for the compiled model, its errors name the instance */
+		p = decodeBinaryProblem(b->model, b->modelSize, "model");
+		ok = applyData(p, data, b->instances[i].name);
+		free(data);
+		if(!ok) {
+			fprintf(out, ",\"error\":\"invalid data\"}\n");
+			freeProblem(p);
+			return;
+		}
+	} else {
+		p = loadProblemFromMemory(data, size, (size >= 4 && !memcmp(data, BINARY_MAGIC, 4)));
+		free(data);
+		if(p == NULL) {
+			fprintf(out, ",\"error\":\"invalid model\"}\n");
+			return;
+		}
+	}
+
+	if(b->streamFormat == NULL) {
+		valuesOut = open_memstream(&values, &valuesSize);
+		sink = newCallbackSink(emitJSON, valuesOut, solutionLimit(p));
+	} else if(!strcmp(b->streamFormat, "count")) {
+		sink = newCountSink(solutionLimit(p));
+	} else {
+		snprintf(output, sizeof(output), "%s/%d.%s", b->streamDir, i, 
+			(!strcmp(b->streamFormat, "text") ? "txt" : "bin"));
+		valuesOut = fopen(output, "w");
+		if(valuesOut == NULL) {
+			fprintf(out, ",\"error\":\"could not open output\"}\n");
+			freeProblem(p);
+			return;
+		}
+		sink = (!strcmp(b->streamFormat, "text") ? newTextSink(valuesOut, solutionLimit(p)) :
+			newBinarySink(valuesOut, p->varCount, solutionLimit(p)));
+	}
+
+	resetSolver(s);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	count = solveToSink(s, p, sink);
+	if(count < 0) {
+		fprintf(out, ",\"error\":\"solving failed\"");
+	} else {
+		fprintf(out, ",\"solutions\":%d,\"states\":%ld,\"seconds\":%.6f", count, s->stateCount, secondsSince(&start));
+	}
+	if(b->streamFormat == NULL) {
+		fclose(valuesOut);
+		if(count >= 0) {
+			fprintf(out, ",\"values\":[%s]", values);
+		}
+		free(values);
+	} else if(valuesOut != NULL) {
+		fclose(valuesOut);
+		if(count >= 0) {
+			fprintf(out, ",\"output\":");
+			printJSONString(out, output);
+		}
+	}
+	fprintf(out, "}\n");
+	freeSolutionSink(sink);
+	freeProblem(p);
+}
+
+static void *worker(void *arg) {
+	batch *b = arg;
+	Solver s = newSolver();
+	char *record;
+	size_t size;
+	FILE *out;
+	int i;
+
+	enableHeuristics(s, b->optionCount, b->options);
+	/* workers have no log */
+	s->traceLevel = TRACE_OFF;
+	s->profiling = 0;
+	for(;;) {
+		pthread_mutex_lock(&b->lock);
+		i = b->next++;
+		pthread_mutex_unlock(&b->lock);
+		if(i >= b->count) {
+			break;
+		}
+		/* the object is written at once, so that lines of different workers do not mix */
+		out = open_memstream(&record, &size);
+		solveInstance(b, s, i, out);
+		fclose(out);
+		pthread_mutex_lock(&b->lock);
+		fputs(record, stdout);
+		fflush(stdout);
+		pthread_mutex_unlock(&b->lock);
+		free(record);
+	}
+	freeSolver(s);
+	return NULL;
+}
+
+/*
+  Solves the instances listed in listPath. argv holds the solver options,
+  including -j N and -stream FORMAT DIR.
+*/
+int batchMain(int argc, char **argv, char *listPath) {
+	batch b;
+	pthread_t *threads;
+	int i, kept = 0;
+	int workers = sysconf(_SC_NPROCESSORS_ONLN);
+	char *modelPath = NULL;
+	Problem p;
+	Solver check;
+
+	b.model = NULL;
+	b.streamFormat = NULL;
+	b.streamDir = NULL;
+	for(i = 0; i < argc; i++) {
+		if(!strcmp(argv[i], "-model")) {
+			if(i+1 >= argc) {
+				fprintf(stderr, "[ERROR] Expecting a filename following flag '-model'.\n");
+				exit(1);
+			}
+			modelPath = argv[++i];
+			continue;
+		}
+		if(!strcmp(argv[i], "-j")) {
+			if(i+1 >= argc || atoi(argv[i+1]) < 1) {
+				fprintf(stderr, "[ERROR] Expecting a positive number following flag '-j'.\n");
+				exit(1);
+			}
+			workers = atoi(argv[++i]);
+			continue;
+		}
+		if(!strcmp(argv[i], "-stream")) {
+			if(i+2 >= argc) {
+				fprintf(stderr, "[ERROR] Expecting a format and directory following flag '-stream'.\n");
+				exit(1);
+			}
+			b.streamFormat = argv[++i];
+			b.streamDir = argv[++i];
+			if(strcmp(b.streamFormat, "text") && strcmp(b.streamFormat, "binary") && 
+			   strcmp(b.streamFormat, "count")) {
+				fprintf(stderr, "[ERROR] Unknown stream format '%s', expecting text, binary or count.\n", b.streamFormat);
+				exit(1);
+			}
+			continue;
+		}
+		argv[kept++] = argv[i];
+	}
+	/* unknown options are reported now, not by every worker */
+	check = newSolver();
+	enableHeuristics(check, kept, argv);
+	freeSolver(check);
+
+	/* the model is parsed once, every instance decodes its compiled image */
+	if(modelPath != NULL) {
+		p = loadProblem(modelPath);
+		b.model = encodeBinaryProblem(p, &b.modelSize);
+		freeProblem(p);
+	}
+	readList(&b, listPath);
+	b.next = 0;
+	b.optionCount = kept;
+	b.options = argv;
+	pthread_mutex_init(&b.lock, NULL);
+	if(workers > b.count) {
+		workers = b.count;
+	}
+	if(workers < 1) {
+		workers = 1;
+	}
+
+	threads = safeMalloc(workers*sizeof(pthread_t));
+	for(i = 0; i < workers; i++) {
+		if(pthread_create(&threads[i], NULL, worker, &b) != 0) {
+			fprintf(stderr, "[ERROR] Could not start worker thread\n");
+			exit(-1);
+		}
+	}
+	for(i = 0; i < workers; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+	for(i = 0; i < b.count; i++) {
+		free(b.instances[i].path);
+	}
+	free(b.instances);
+	free(b.model);
+	pthread_mutex_destroy(&b.lock);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,37 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+/*
+ * Batch mode, started with
+ *
+ *   solver [OPTION]... [-j N] [-stream FORMAT DIR] [-model MODEL] -batch LIST
+ *
+ * Solves every model listed in the file LIST (one file per line, textual
+ * or binary normal form) on N worker threads (default: one per processor).
+ * A line may name the instance after a tab; the name is used in the output
+ * instead of the file name. With -model MODEL the listed files hold data
+ * (see data.h) instead: MODEL is loaded and compiled once, and solved with
+ * the data of every instance. The options of the solver program apply to
+ * all instances; solution.txt and csp.log are not written.
+ *
+ * For every instance one JSON object is written on the standard output as
+ * soon as it is solved, so the lines are in order of completion:
+ *
+ *   {"index":I,"instance":NAME,"solutions":N,"states":S,"seconds":T,"values":[[...],...]}
+ *   {"index":I,"instance":NAME,"error":MESSAGE}
+ *
+ * where I is the position of the instance in LIST, counting from 0 (blank
+ * lines are skipped). With -stream the solutions of instance I are written
+ * to DIR/I.txt (text) or DIR/I.bin (binary) instead, and the object holds
+ * "output":PATH rather than the values; with format count only the amounts
+ * are written.
+ *
+ * Known limit: the generated scanner and parser are not reentrant, so
+ * instances in textual normal form are parsed one at a time, under the
+ * process-wide lock parserLock in problem.c. Binary instances, and data
+ * with -model, are read without it.
+ */
+
+int batchMain(int argc, char **argv, char *listPath);
+
+#endif
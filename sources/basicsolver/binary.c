@@ -0,0 +1,760 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "variable.h"
+#include "constraint.h"
+#include "binary.h"
+
+/* growable array of code words, used while writing a problem */
+typedef struct codeBuffer {
+	int size;
+	int space;
+	int *words;
+} codeBuffer;
+
+static void emit(codeBuffer *buf, int word) {
+	if(buf->size == buf->space) {
+		buf->space = (buf->space == 0 ? 64 : 2*buf->space);
+		buf->words = safeRealloc(buf->words, buf->space*sizeof(int));
+	}
+	buf->words[buf->size++] = word;
+}
+
+static void encodeNumExp(codeBuffer *buf, NumExp exp);
+static void encodeFactor(codeBuffer *buf, Factor f);
+
+static void encodeConstraint(codeBuffer *buf, Constraint c) {
+	encodeNumExp(buf, firstExp(c));
+	if(secondExp(c) != NULL) {
+		encodeNumExp(buf, secondExp(c));
+		emit(buf, OP_RELATION);
+		emit(buf, operatorOfConstraint(c));
+	} else {
+		emit(buf, OP_CONSTRAINT);
+	}
+}
+
+static void encodeValue(codeBuffer *buf, Value v) {
+	int i;
+	switch(v->type) {
+		case INTVAL:
+			emit(buf, OP_INT);
+			emit(buf, v->data.intval);
+			break;
+		case VARVAL:
+			emit(buf, OP_VAR);
+			emit(buf, v->data.varIndex);
+			break;
+		case NUMEXP:
+			encodeNumExp(buf, v->data.numexp);
+			emit(buf, OP_PAREN);
+			break;
+		case FUNCVAL:
+			if(v->data.funcCall->name == ANY || v->data.funcCall->name == ALL) {
+				ConstraintList *lists = v->data.funcCall->argv;
+				ConstraintList list = lists[0];
+				int count = 0;
+				while(list != NULL) {
+					encodeConstraint(buf, list->constraint);
+					count++;
+					list = list->next;
+				}
+				emit(buf, (v->data.funcCall->name == ANY ? OP_ANY : OP_ALL));
+				emit(buf, count);
+			} else {
+				NumExp *numExps = v->data.funcCall->argv;
+				for(i = 0; i < v->data.funcCall->argc; i++) {
+					encodeNumExp(buf, numExps[i]);
+				}
+				emit(buf, OP_FUNC);
+				emit(buf, v->data.funcCall->name);
+				emit(buf, v->data.funcCall->argc);
+			}
+			break;
+	}
+	if(v->exponent != NULL) {
+		encodeFactor(buf, v->exponent);
+		emit(buf, OP_POW);
+	}
+}
+
+static void encodeFactor(codeBuffer *buf, Factor f) {
+	if(f->type == NUMNEG) {
+		encodeFactor(buf, f->data.factor);
+		emit(buf, OP_NEG);
+	} else {
+		encodeValue(buf, f->data.value);
+		emit(buf, OP_FACTOR);
+	}
+}
+
+static void encodeTerm(codeBuffer *buf, Term t) {
+	if(t->next == NULL) {
+		encodeFactor(buf, t->data);
+		emit(buf, OP_TERM);
+	} else {
+		encodeTerm(buf, t->data);
+		encodeTerm(buf, t->next);
+		emit(buf, OP_FACTOROP);
+		emit(buf, t->factorop);
+	}
+}
+
+static void encodeNumExp(codeBuffer *buf, NumExp exp) {
+	if(exp->next == NULL) {
+		encodeTerm(buf, exp->data);
+		emit(buf, OP_NUMEXP);
+	} else {
+		encodeNumExp(buf, exp->data);
+		encodeNumExp(buf, exp->next);
+		emit(buf, OP_TERMOP);
+		emit(buf, exp->termop);
+	}
+}
+
+/*
+ * Returns the postfix code of constraint c, which is equal for two
+ * constraints exactly if they are written the same. Used by presolve to
+ * find duplicates.
+ */
+int *encodeConstraintCode(Constraint c, int *length) {
+	codeBuffer buf = {0, 0, NULL};
+	encodeConstraint(&buf, c);
+	*length = buf.size;
+	return buf.words;
+}
+
+/* orders codes by length, codes of the same length by their words */
+static int compareBuffers(const codeBuffer *x, const codeBuffer *y) {
+	if(x->size != y->size) {
+		return (x->size < y->size ? -1 : 1);
+	}
+	return memcmp(x->words, y->words, x->size*sizeof(int));
+}
+
+/*
+ * Like encodeConstraintCode, but with the sides of the relation in a fixed
+ * order: X1 <> X0 and X0 <> X1, or X0 < X1 and X1 > X0, get the same code.
+ */
+int *encodeCanonicalCode(Constraint c, int *length) {
+	static const RelOperator mirrored[] = {IS, GREATER, SMALLER, LEQ, GEQ, NEQ};
+	codeBuffer first = {0, 0, NULL}, second = {0, 0, NULL}, swap;
+	RelOperator op = operatorOfConstraint(c);
+	int i;
+	if(secondExp(c) == NULL) {
+		return encodeConstraintCode(c, length);
+	}
+	encodeNumExp(&first, firstExp(c));
+	encodeNumExp(&second, secondExp(c));
+	if(compareBuffers(&first, &second) > 0) {
+		swap = first;
+		first = second;
+		second = swap;
+		op = mirrored[op];
+	}
+	for(i = 0; i < second.size; i++) {
+		emit(&first, second.words[i]);
+	}
+	emit(&first, OP_RELATION);
+	emit(&first, op);
+	free(second.words);
+	*length = first.size;
+	return first.words;
+}
+
+static void writeOrDie(const void *data, size_t size, size_t count, FILE *out, const char *path) {
+	if(count > 0 && fwrite(data, size, count, out) != count) {
+		fprintf(stderr, "[ERROR] Could not write to %s\n", path);
+		exit(-1);
+	}
+}
+
+/* growable array of bytes, a section of the image while it is written */
+typedef struct byteBuffer {
+	size_t size;
+	size_t space;
+	unsigned char *bytes;
+} byteBuffer;
+
+static void putByte(byteBuffer *buf, unsigned char byte) {
+	if(buf->size == buf->space) {
+		buf->space = (buf->space == 0 ? 256 : 2*buf->space);
+		buf->bytes = safeRealloc(buf->bytes, buf->space);
+	}
+	buf->bytes[buf->size++] = byte;
+}
+
+/* 7 bits per byte, low bits first, the high bit is set on all but the last byte */
+static void putUnsigned(byteBuffer *buf, unsigned int n) {
+	while(n >= 0x80) {
+		putByte(buf, (n & 0x7f) | 0x80);
+		n >>= 7;
+	}
+	putByte(buf, n);
+}
+
+/* zigzag: 0, -1, 1, -2, ... are stored as 0, 1, 2, 3, ... */
+static void putSigned(byteBuffer *buf, int n) {
+	putUnsigned(buf, ((unsigned int) n << 1) ^ (unsigned int) -(n < 0));
+}
+
+/* the variable of exp if it is a plain variable, -1 otherwise */
+static int plainVariable(NumExp exp) {
+	Term t = exp->data;
+	Factor f;
+	if(exp->next != NULL || t->next != NULL) {
+		return -1;
+	}
+	f = t->data;
+	if(f->type == NUMNEG || f->data.value->type != VARVAL || f->data.value->exponent != NULL) {
+		return -1;
+	}
+	return f->data.value->data.varIndex;
+}
+
+/* the number of operand words that follow opcode op */
+static int operandsOf(int op) {
+	switch(op) {
+		case OP_FUNC:
+			return 2;
+		case OP_INT: case OP_VAR: case OP_ANY: case OP_ALL:
+		case OP_FACTOROP: case OP_TERMOP: case OP_RELATION:
+		case OP_INT_TERM: case OP_VAR_TERM: case OP_INT_EXP: case OP_VAR_EXP:
+			return 1;
+	}
+	return 0;
+}
+
+/*
+  Replaces every integer or variable that is followed by the opcodes that
+  make it a term, or an expression, by one instruction. Returns the new
+  length of the code.
+*/
+static int fuseLeaves(int *words, int length) {
+	int pc = 0, out = 0, op, i;
+	while(pc < length) {
+		op = words[pc];
+		if((op == OP_INT || op == OP_VAR) && pc+3 < length &&
+		   words[pc+2] == OP_FACTOR && words[pc+3] == OP_TERM) {
+			int expression = (pc+4 < length && words[pc+4] == OP_NUMEXP);
+			if(op == OP_INT) {
+				words[out++] = (expression ? OP_INT_EXP : OP_INT_TERM);
+			} else {
+				words[out++] = (expression ? OP_VAR_EXP : OP_VAR_TERM);
+			}
+			words[out++] = words[pc+1];
+			pc += 4 + expression;
+			continue;
+		}
+		for(i = 0; i <= operandsOf(op); i++) {
+			words[out++] = words[pc++];
+		}
+	}
+	return out;
+}
+
+/* a relation of two variables gets a short record, other constraints their code */
+static void writeConstraintRecord(byteBuffer *buf, codeBuffer *code, Constraint c) {
+	int a = -1, b = -1, i;
+	if(secondExp(c) != NULL) {
+		a = plainVariable(firstExp(c));
+		b = plainVariable(secondExp(c));
+	}
+	if(a >= 0 && b >= 0) {
+		putUnsigned(buf, RECORD_RELATION);
+		putUnsigned(buf, a);
+		putUnsigned(buf, operatorOfConstraint(c));
+		putUnsigned(buf, b);
+		return;
+	}
+	code->size = 0;
+	encodeConstraint(code, c);
+	code->size = fuseLeaves(code->words, code->size);
+	putUnsigned(buf, RECORD_EXPRESSION);
+	putUnsigned(buf, code->size);
+	for(i = 0; i < code->size; i++) {
+		putUnsigned(buf, code->words[i]);
+	}
+}
+
+/*
+ * Writes Problem p to out in the binary normal form.
+ * Domains are stored as runs of consecutive values.
+ */
+static void writeBinaryImage(Problem p, FILE *out, const char *path) {
+	byteBuffer vars = {0, 0, NULL}, constraints = {0, 0, NULL};
+	codeBuffer code = {0, 0, NULL};
+	int i, j, k;
+
+	for(i = 0; i < p->varCount; i++) {
+		Variable var = varByIndex(p, i);
+		int *values = domainValuesOfVar(var);
+		int size = domainSizeOfVar(var), runs = 0;
+		for(j = 0; j < size; j++) {
+			runs += (j == 0 || values[j] != values[j-1]+1);
+		}
+		putUnsigned(&vars, dataTypeOfVar(var));
+		putUnsigned(&vars, runs);
+		for(j = 0; j < size; j = k) {
+			k = j+1;
+			while(k < size && values[k] == values[k-1]+1) {
+				k++;
+			}
+			putSigned(&vars, values[j]);
+			putUnsigned(&vars, (unsigned int) values[k-1] - (unsigned int) values[j]);
+		}
+	}
+	for(i = 0; i < p->constraintCount; i++) {
+		writeConstraintRecord(&constraints, &code, constraintByIndex(p, i));
+	}
+
+	binaryHeader header;
+	memcpy(header.magic, BINARY_MAGIC, 4);
+	header.version = BINARY_VERSION;
+	header.varCount = p->varCount;
+	header.constraintCount = p->constraintCount;
+	header.solveType = p->solvespec.type;
+	header.solveMax = p->solvespec.max;
+	header.varBytes = vars.size;
+	header.constraintBytes = constraints.size;
+
+	writeOrDie(&header, sizeof(binaryHeader), 1, out, path);
+	writeOrDie(vars.bytes, 1, vars.size, out, path);
+	writeOrDie(constraints.bytes, 1, constraints.size, out, path);
+
+	free(vars.bytes);
+	free(constraints.bytes);
+	free(code.words);
+}
+
+void writeBinaryProblem(Problem p, const char *path) {
+	FILE *out = fopen(path, "wb");
+	if(out == NULL) {
+		fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+		exit(-1);
+	}
+	writeBinaryImage(p, out, path);
+	fclose(out);
+}
+
+/* the binary normal form of p in memory, to be decoded by decodeBinaryProblem */
+char *encodeBinaryProblem(Problem p, size_t *size) {
+	char *image = NULL;
+	FILE *out = open_memstream(&image, size);
+	if(out == NULL) {
+		fprintf(stderr, "[ERROR] Out of memory\n");
+		exit(-1);
+	}
+	writeBinaryImage(p, out, "memory");
+	fclose(out);
+	return image;
+}
+
+/* the kinds of node that decoding keeps on its stack */
+typedef enum {
+	NODE_VALUE, NODE_FACTOR, NODE_TERM, NODE_NUMEXP, NODE_CONSTRAINT
+} NodeKind;
+
+typedef struct stackSlot {
+	NodeKind kind;
+	void *node;
+} stackSlot;
+
+/* the stack and code words of the problem being decoded, freed if decoding fails */
+static __thread stackSlot *decodeStack = NULL;
+static __thread int *decodeWords = NULL;
+
+static void corrupt(const char *path, const char *reason) {
+	fprintf(stderr, "[ERROR] %s is not a valid binary problem: %s\n", path, reason);
+	free(decodeStack);
+	free(decodeWords);
+	decodeStack = NULL;
+	decodeWords = NULL;
+	loadFailed(-1);
+}
+
+/* reads the numbers of one section of an image */
+typedef struct reader {
+	const unsigned char *at;
+	const unsigned char *end;
+	const char *path;
+} reader;
+
+static unsigned int readUnsigned(reader *r) {
+	unsigned int n = 0;
+	int shift;
+	for(shift = 0; shift < 35; shift += 7) {
+		if(r->at == r->end) {
+			corrupt(r->path, "truncated section");
+		}
+		unsigned char byte = *r->at++;
+		if(shift == 28 && byte > 0x0f) {
+			corrupt(r->path, "number out of range");
+		}
+		n |= (unsigned int) (byte & 0x7f) << shift;
+		if(!(byte & 0x80)) {
+			return n;
+		}
+	}
+	return n;
+}
+
+static int readSigned(reader *r) {
+	unsigned int n = readUnsigned(r);
+	return (int) ((n >> 1) ^ -(n & 1));
+}
+
+/* a count of items that each take at least one byte of the rest of the section */
+static int readCount(reader *r) {
+	unsigned int n = readUnsigned(r);
+	if(n > (size_t) (r->end - r->at)) {
+		corrupt(r->path, "count exceeds section");
+	}
+	return n;
+}
+
+/* prepends constraint c to list */
+static ConstraintList prependConstraint(ConstraintList list, Constraint c) {
+	ConstraintList new = allocExpression(sizeof(constraintList));
+	new->constraint = c;
+	new->next = list;
+	return new;
+}
+
+/* checks that the count topmost nodes of the stack are of the given kind */
+static void expectNodes(stackSlot *stack, int top, int count, NodeKind kind, const char *path) {
+	int i;
+	if(count > top) {
+		corrupt(path, "stack underflow");
+	}
+	for(i = top-count; i < top; i++) {
+		if(stack[i].kind != kind) {
+			corrupt(path, "operand of the wrong kind");
+		}
+	}
+}
+
+static void pushNode(stackSlot *stack, int *top, NodeKind kind, void *node) {
+	stack[*top].kind = kind;
+	stack[*top].node = node;
+	(*top)++;
+}
+
+/*
+ * Decodes the postfix code of a single constraint back into the tree
+ * representation that is used by the solver. Every opcode consumes nodes
+ * of fixed kinds and produces one node; the stack records the kind of
+ * every node, so that code of a malformed image is rejected instead of
+ * building a tree of the wrong nodes.
+ */
+static Constraint decodeConstraint(const int *code, int length, int varCount, stackSlot *stack, const char *path) {
+	int pc = 0;
+	int top = 0;
+	int i;
+	while(pc < length) {
+		int op = code[pc++];
+		if(operandsOf(op) > length - pc) {
+			corrupt(path, "truncated instruction");
+		}
+		switch(op) {
+			case OP_INT:
+				pushNode(stack, &top, NODE_VALUE, newIntVal(code[pc++]));
+				break;
+			case OP_VAR:
+				if(code[pc] < 0 || code[pc] >= varCount) {
+					corrupt(path, "variable index out of range");
+				}
+				pushNode(stack, &top, NODE_VALUE, newVarVal(code[pc++]));
+				break;
+			case OP_VAR_TERM:
+			case OP_VAR_EXP:
+				if(code[pc] < 0 || code[pc] >= varCount) {
+					corrupt(path, "variable index out of range");
+				}
+				/* fall through */
+			case OP_INT_TERM:
+			case OP_INT_EXP: {
+				Value v = (op == OP_INT_TERM || op == OP_INT_EXP ? newIntVal(code[pc]) : newVarVal(code[pc]));
+				Term t = newTerm(newValueFactor(v));
+				pc++;
+				if(op == OP_INT_EXP || op == OP_VAR_EXP) {
+					pushNode(stack, &top, NODE_NUMEXP, newNumExp(t));
+				} else {
+					pushNode(stack, &top, NODE_TERM, t);
+				}
+				break;
+			}
+			case OP_FUNC: {
+				int name = code[pc++];
+				int argc = code[pc++];
+				if(argc < 1 || ((name < MAX || name > ABS) && name != ELEMENT) ||
+				   (name == ELEMENT && argc < 2) || (name == ABS && argc != 1)) {
+					corrupt(path, "bad function call");
+				}
+				expectNodes(stack, top, argc, NODE_NUMEXP, path);
+				NumExp *args = allocExpression(argc*sizeof(NumExp));
+				top -= argc;
+				for(i = 0; i < argc; i++) {
+					args[i] = stack[top+i].node;
+				}
+				pushNode(stack, &top, NODE_VALUE, newFuncVal(newFunctionCall(name, argc, args)));
+				break;
+			}
+			case OP_ANY:
+			case OP_ALL: {
+				int count = code[pc++];
+				if(count < 1) {
+					corrupt(path, "bad constraint list");
+				}
+				expectNodes(stack, top, count, NODE_CONSTRAINT, path);
+				ConstraintList list = NULL;
+				for(i = 0; i < count; i++) {
+					list = prependConstraint(list, stack[--top].node);
+				}
+				ConstraintList *lists = allocExpression(sizeof(ConstraintList));
+				lists[0] = list;
+				pushNode(stack, &top, NODE_VALUE, newFuncVal(newFunctionCall((op == OP_ANY ? ANY : ALL), 1, lists)));
+				break;
+			}
+			case OP_PAREN:
+				expectNodes(stack, top, 1, NODE_NUMEXP, path);
+				stack[top-1].kind = NODE_VALUE;
+				stack[top-1].node = newNumExpVal(stack[top-1].node);
+				break;
+			case OP_POW:
+				expectNodes(stack, top-1, 1, NODE_VALUE, path);
+				expectNodes(stack, top, 1, NODE_FACTOR, path);
+				((Value) stack[top-2].node)->exponent = stack[top-1].node;
+				top--;
+				break;
+			case OP_FACTOR:
+				expectNodes(stack, top, 1, NODE_VALUE, path);
+				stack[top-1].kind = NODE_FACTOR;
+				stack[top-1].node = newValueFactor(stack[top-1].node);
+				break;
+			case OP_NEG:
+				expectNodes(stack, top, 1, NODE_FACTOR, path);
+				stack[top-1].node = newMinusFactor(stack[top-1].node);
+				break;
+			case OP_TERM:
+				expectNodes(stack, top, 1, NODE_FACTOR, path);
+				stack[top-1].kind = NODE_TERM;
+				stack[top-1].node = newTerm(stack[top-1].node);
+				break;
+			case OP_FACTOROP: {
+				int factorop = code[pc++];
+				if(factorop < MUL || factorop > MOD) {
+					corrupt(path, "unknown factor operator");
+				}
+				expectNodes(stack, top, 2, NODE_TERM, path);
+				Term t = newTerm(stack[top-2].node);
+				t->factorop = factorop;
+				t->next = stack[top-1].node;
+				stack[top-2].node = t;
+				top--;
+				break;
+			}
+			case OP_NUMEXP:
+				expectNodes(stack, top, 1, NODE_TERM, path);
+				stack[top-1].kind = NODE_NUMEXP;
+				stack[top-1].node = newNumExp(stack[top-1].node);
+				break;
+			case OP_TERMOP: {
+				int termop = code[pc++];
+				if(termop < MINUS || termop > PLUS) {
+					corrupt(path, "unknown term operator");
+				}
+				expectNodes(stack, top, 2, NODE_NUMEXP, path);
+				NumExp e = newNumExp(stack[top-2].node);
+				e->termop = termop;
+				e->next = stack[top-1].node;
+				stack[top-2].node = e;
+				top--;
+				break;
+			}
+			case OP_CONSTRAINT:
+				expectNodes(stack, top, 1, NODE_NUMEXP, path);
+				stack[top-1].kind = NODE_CONSTRAINT;
+				stack[top-1].node = newValConstraint(stack[top-1].node);
+				break;
+			case OP_RELATION: {
+				int relation = code[pc++];
+				if(relation < IS || relation > NEQ) {
+					corrupt(path, "unknown relation");
+				}
+				expectNodes(stack, top, 2, NODE_NUMEXP, path);
+				stack[top-2].kind = NODE_CONSTRAINT;
+				stack[top-2].node = newBoolConstraint(stack[top-2].node, relation, stack[top-1].node);
+				top--;
+				break;
+			}
+			default:
+				corrupt(path, "unknown opcode");
+		}
+	}
+	if(top != 1 || stack[0].kind != NODE_CONSTRAINT) {
+		corrupt(path, "constraint code does not reduce to a single constraint");
+	}
+	return stack[0].node;
+}
+
+/* checks whether the file at path starts with the binary magic */
+int isBinaryProblemFile(const char *path) {
+	char magic[4];
+	FILE *f = fopen(path, "rb");
+	if(f == NULL) {
+		return 0;
+	}
+	int isBinary = (fread(magic, 1, 4, f) == 4 && memcmp(magic, BINARY_MAGIC, 4) == 0);
+	fclose(f);
+	return isBinary;
+}
+
+/*
+ * Builds a Problem from the binary image of size bytes, path is the name
+ * used in error messages. The Problem does not refer to the image.
+ */
+Problem decodeBinaryProblem(const char *image, size_t size, const char *path) {
+	int i, j;
+	if(size < sizeof(binaryHeader)) {
+		corrupt(path, "file too small");
+	}
+
+	const binaryHeader *header = (const binaryHeader *) image;
+	if(memcmp(header->magic, BINARY_MAGIC, 4) != 0) {
+		corrupt(path, "bad magic");
+	}
+	if(header->version != BINARY_VERSION) {
+		corrupt(path, "unsupported version");
+	}
+	if(header->varCount < 0 || header->constraintCount < 0 ||
+	   header->varBytes < 0 || header->constraintBytes < 0) {
+		corrupt(path, "negative section size");
+	}
+	if(size != sizeof(binaryHeader) + (size_t) header->varBytes + (size_t) header->constraintBytes) {
+		corrupt(path, "section sizes do not match file size");
+	}
+	/* a variable or constraint takes at least two bytes */
+	if(header->varCount > header->varBytes || header->constraintCount > header->constraintBytes) {
+		corrupt(path, "more records than the sections can hold");
+	}
+	if(header->solveType != SOLVEALL && header->solveType != SOLVENR) {
+		corrupt(path, "unknown solution amount");
+	}
+
+	const unsigned char *sections = (const unsigned char *) (header+1);
+	reader vars = {sections, sections + header->varBytes, path};
+	reader constraints = {vars.end, vars.end + header->constraintBytes, path};
+
+	Problem p = emptyProblem();
+	p->solvespec.type = header->solveType;
+	p->solvespec.max = header->solveMax;
+	p->varCount = header->varCount;
+	p->vars = safeMalloc((p->varCount+1)*sizeof(Variable));
+	for(i = 0; i < p->varCount; i++) {
+		int type = readUnsigned(&vars);
+		if(type != INTEGER && type != BOOLEAN) {
+			corrupt(path, "unknown variable type");
+		}
+		Variable var = newVariable(i, type);
+		int intervals = readCount(&vars);
+		for(j = 0; j < intervals; j++) {
+			long long min = readSigned(&vars);
+			long long max = min + readUnsigned(&vars);
+			if(max > INT_MAX) {
+				corrupt(path, "domain interval out of range");
+			}
+			addIntervalToSet(domainOfVar(var), min, max);
+		}
+		setVarAtIndex(p, i, var);
+	}
+	if(vars.at != vars.end) {
+		corrupt(path, "variable section too long");
+	}
+
+	/* the expressions are owned by the problem, see setExpressionArena */
+	Arena previous = setExpressionArena(newArena());
+	/* every code word takes at least a byte, and a stack slot at most */
+	decodeStack = safeMalloc((header->constraintBytes+1)*sizeof(stackSlot));
+	decodeWords = safeMalloc((header->constraintBytes+1)*sizeof(int));
+	p->constraintCount = header->constraintCount;
+	p->constraints = safeMalloc((p->constraintCount+1)*sizeof(Constraint));
+	for(i = 0; i < p->constraintCount; i++) {
+		Constraint c;
+		int kind = readUnsigned(&constraints);
+		if(kind != RECORD_RELATION && kind != RECORD_EXPRESSION) {
+			corrupt(path, "unknown constraint record");
+		}
+		if(kind == RECORD_RELATION) {
+			int a = readUnsigned(&constraints);
+			int relation = readUnsigned(&constraints);
+			int b = readUnsigned(&constraints);
+			if(a < 0 || a >= p->varCount || b < 0 || b >= p->varCount) {
+				corrupt(path, "variable index out of range");
+			}
+			if(relation < IS || relation > NEQ) {
+				corrupt(path, "unknown relation");
+			}
+			c = newBoolConstraint(newNumExp(newTerm(newValueFactor(newVarVal(a)))), relation,
+			                      newNumExp(newTerm(newValueFactor(newVarVal(b)))));
+		} else {
+			int length = readCount(&constraints);
+			if(length < 1) {
+				corrupt(path, "empty constraint code");
+			}
+			for(j = 0; j < length; j++) {
+				decodeWords[j] = readUnsigned(&constraints);
+			}
+			c = decodeConstraint(decodeWords, length, p->varCount, decodeStack, path);
+		}
+		setIndexOfConstraint(c, i);
+		setConstraintAtIndex(p, i, c);
+	}
+	if(constraints.at != constraints.end) {
+		corrupt(path, "constraint section too long");
+	}
+	free(decodeStack);
+	free(decodeWords);
+	decodeStack = NULL;
+	decodeWords = NULL;
+
+	dropDuplicateConstraints(p);
+	linkConstraintsAndVars(p);
+	p->arena = setExpressionArena(previous);
+	return p;
+}
+
+/*
+ * Maps the binary problem at path into memory and builds a Problem from it.
+ * The mapping is released before returning: the Problem owns all its data.
+ */
+Problem loadBinaryProblem(const char *path) {
+	struct stat st;
+	Problem p;
+	int fd = open(path, O_RDONLY);
+	if(fd < 0 || fstat(fd, &st) != 0) {
+		fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+		exit(-1);
+	}
+	size_t size = st.st_size;
+	if(size < sizeof(binaryHeader)) {
+		corrupt(path, "file too small");
+	}
+	char *image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(image == MAP_FAILED) {
+		fprintf(stderr, "[ERROR] Could not map file %s\n", path);
+		exit(-1);
+	}
+	p = decodeBinaryProblem(image, size, path);
+	munmap(image, size);
+	return p;
+}
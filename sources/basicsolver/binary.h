@@ -0,0 +1,64 @@
+#ifndef BINARY_H
+#define BINARY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "problem.h"
+
+/*
+ * Binary normal form: a versioned image of a Problem that can be loaded
+ * with mmap and decoded in a single pass, without lexing or parsing.
+ *
+ * Layout:
+ *   header             native 32 bit integers
+ *   variables          header.varBytes bytes, per variable its type and
+ *                      number of intervals, then every interval as its
+ *                      minimum and its width
+ *   constraints        header.constraintBytes bytes, per constraint a
+ *                      record kind and then
+ *                        RECORD_RELATION    Xa rel Xb: a, rel and b
+ *                        RECORD_EXPRESSION  the number of code words and
+ *                                           the postfix expression code,
+ *                                           with the leaves fused
+ *
+ * All numbers after the header are varints: 7 bits per byte, low bits
+ * first, with the high bit set on every byte but the last. Minimums are
+ * zigzag encoded, negative code words take 5 bytes.
+ */
+
+#define BINARY_MAGIC "CSPB"
+#define BINARY_VERSION 2
+
+typedef enum {
+	OP_INT, OP_VAR, OP_FUNC, OP_ANY, OP_ALL, OP_PAREN, OP_POW,
+	OP_FACTOR, OP_NEG, OP_TERM, OP_FACTOROP, OP_NUMEXP, OP_TERMOP,
+	OP_CONSTRAINT, OP_RELATION,
+	/* only in images: an integer or variable made a term or an expression */
+	OP_INT_TERM, OP_VAR_TERM, OP_INT_EXP, OP_VAR_EXP
+} BinaryOp;
+
+typedef enum {
+	RECORD_EXPRESSION, RECORD_RELATION
+} RecordKind;
+
+typedef struct binaryHeader {
+	char magic[4];
+	int version;
+	int varCount;
+	int constraintCount;
+	int solveType;
+	int solveMax;
+	int varBytes;
+	int constraintBytes;
+} binaryHeader;
+
+int isBinaryProblemFile(const char *path);
+Problem loadBinaryProblem(const char *path);
+Problem decodeBinaryProblem(const char *image, size_t size, const char *path);
+void writeBinaryProblem(Problem p, const char *path);
+char *encodeBinaryProblem(Problem p, size_t *size);
+int *encodeConstraintCode(Constraint c, int *length);
+int *encodeCanonicalCode(Constraint c, int *length);
+
+#endif
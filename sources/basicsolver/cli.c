@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <assert.h>
+#include "datatypes.h"
+#include "solve.h"
+#include "binary.h"
+#include "stats.h"
+#include "cspsolver.h"
+#include "server.h"
+#include "batch.h"
+#include "data.h"
+#include <limits.h>
+#include <string.h>
+
+/* the options that the solver program handles itself, see mainOptions */
+typedef struct cliOptions {
+	/* if set, the loaded problem is written in binary normal form to this file */
+	char *binaryOutput;
+	/* if set, the loaded problem is also written in binary normal form to this file, before it is solved */
+	char *savedOutput;
+	/* if set, the data in this file is applied to the loaded problem */
+	char *dataFile;
+	/* if set, solutions are streamed in this format (text/binary/count) to streamOutput */
+	char *streamFormat;
+	char *streamOutput;
+	/* statistics reported at exit: as text on stderr and/or appended as JSON to statsFile */
+	int statsText;
+	char *statsFile;
+} cliOptions;
+
+/* opens the file solutions are streamed to, "-" being the standard output */
+FILE *openStreamOutput(cliOptions *o, char *mode) {
+	FILE *out;
+	if(!strcmp(o->streamOutput, "-")) {
+		/* stdout itself is redirected to solution.txt, descriptor 1 is not */
+		out = fdopen(STDOUT_FILENO, mode);
+	} else {
+		out = fopen(o->streamOutput, mode);
+	}
+	if(out == NULL) {
+		fprintf(stderr, "[ERROR] Could not open file %s\n", o->streamOutput);
+		exit(-1);
+	}
+	return out;
+}
+
+SolutionSink newStreamSink(cliOptions *o, Problem p) {
+	if(!strcmp(o->streamFormat, "text")) {
+		return newTextSink(openStreamOutput(o, "w"), solutionLimit(p));
+	}
+	if(!strcmp(o->streamFormat, "binary")) {
+		return newBinarySink(openStreamOutput(o, "wb"), p->varCount, solutionLimit(p));
+	}
+	return newCountSink(solutionLimit(p));
+}
+
+/* solves p while streaming the solutions, only the counts go to solution.txt */
+void streamMain(cliOptions *o, Solver s, Problem p) {
+	SolutionSink sink = newStreamSink(o, p);
+	int count = solveToSink(s, p, sink);
+	if(count < 0) {
+		exit(-1);
+	}
+	printf("%ld\n", s->stateCount);
+	printf("%d \n", count);
+	if(sink->out != NULL) {
+		fclose(sink->out);
+	}
+	freeSolutionSink(sink);
+}
+
+void Main(cliOptions *o, Solver s, char *inputName) {
+	startPhase(s, PHASE_PARSE);
+  	Problem p = loadProblem(inputName);
+	if(o->savedOutput != NULL) {
+		writeBinaryProblem(p, o->savedOutput);
+	}
+	if(o->dataFile != NULL && !applyDataFile(p, o->dataFile)) {
+		exit(-1);
+	}
+	endPhase(s, PHASE_PARSE);
+  
+  	traceText(s, TRACE_INFO, "Accepted\n"); 	
+
+	if(o->binaryOutput != NULL) {
+		writeBinaryProblem(p, o->binaryOutput);
+		freeProblem(p);
+		return;
+	}
+
+	if(o->streamFormat != NULL) {
+		streamMain(o, s, p);
+		freeProblem(p);
+		return;
+	}
+  		
+  	SolutionSet solset = solve(s, p);
+  	SolutionList solution = solset->first;
+	
+	printf("%ld\n", s->stateCount);
+	printf("%d \n", solset->solutionCount);
+	
+	  int i = 0;
+	  while(solution != NULL) {
+		  //printf("\n########## SOLUTION #%d ##########\n", i+1);
+		  printSolution(solution->values, p->varCount);
+		  solution = solution->next;
+		  i++;
+	  }
+		
+		/*
+	  if(solset->solutionCount == 0) {
+		  printf("\nNo solution could be found\n");
+	  } else if(p->solvespec.type == SOLVEALL) {
+		  printf("\nFound %d solution(s).\n", solset->solutionCount);
+	  } else if(solset->solutionCount < p->solvespec.max) { 
+		 
+		  printf("\nNo more than %d solution(s) "
+		  "could be found.\n", solset->solutionCount);
+	  }
+	  */
+	
+	  freeSolutionSet(solset);
+  	
+  	freeProblem(p);
+}
+
+/* 
+  Removes the options that are handled by main itself from argv and
+  returns the number of remaining arguments.
+*/
+int mainOptions(cliOptions *o, int argc, char **argv) {
+	int i, kept = 0;
+	for(i = 0; i < argc; i++) {
+		if(!strcmp(argv[i], "-writenf")) {
+			if(i+1 >= argc) {
+				fprintf(stderr, "[ERROR] Expecting a filename following flag '-writenf'.\n");
+				exit(1);
+			}
+			o->binaryOutput = argv[++i];
+			continue;
+		}
+		if(!strcmp(argv[i], "-savenf")) {
+			if(i+1 >= argc) {
+				fprintf(stderr, "[ERROR] Expecting a filename following flag '-savenf'.\n");
+				exit(1);
+			}
+			o->savedOutput = argv[++i];
+			continue;
+		}
+		if(!strcmp(argv[i], "-data")) {
+			if(i+1 >= argc) {
+				fprintf(stderr, "[ERROR] Expecting a filename following flag '-data'.\n");
+				exit(1);
+			}
+			o->dataFile = argv[++i];
+			continue;
+		}
+		if(!strcmp(argv[i], "-stats")) {
+			o->statsText = 1;
+			continue;
+		}
+		if(!strcmp(argv[i], "-statsjson")) {
+			if(i+1 >= argc) {
+				fprintf(stderr, "[ERROR] Expecting a filename following flag '-statsjson'.\n");
+				exit(1);
+			}
+			o->statsFile = argv[++i];
+			continue;
+		}
+		if(!strcmp(argv[i], "-stream")) {
+			if(i+2 >= argc) {
+				fprintf(stderr, "[ERROR] Expecting a format and filename following flag '-stream'.\n");
+				exit(1);
+			}
+			o->streamFormat = argv[++i];
+			o->streamOutput = argv[++i];
+			if(strcmp(o->streamFormat, "text") && strcmp(o->streamFormat, "binary") && 
+			   strcmp(o->streamFormat, "count")) {
+				fprintf(stderr, "[ERROR] Unknown stream format '%s', expecting text, binary or count.\n", o->streamFormat);
+				exit(1);
+			}
+			continue;
+		}
+		argv[kept++] = argv[i];
+	}
+	return kept;
+}
+
+int cspSolverMain(int argc, char *argv[]) { 	
+	cliOptions options = {NULL, NULL, NULL, NULL, NULL, 0, NULL};
+	Solver s;
+
+	if(argc >= 3 && !strcmp(argv[argc-2], "-serve")) {
+		return serveMain(argc-3, &(argv[1]), argv[argc-1]);
+	}
+	if(argc >= 3 && !strcmp(argv[argc-2], "-batch")) {
+		return batchMain(argc-3, &(argv[1]), argv[argc-1]);
+	}
+	if(argc < 2) {
+		fprintf(stderr, "[ERROR] No filename given\n");
+		exit(-1);
+	}
+
+	s = newSolver();
+	s->traceLevel = TRACE_INFO;
+  	enableHeuristics(s, mainOptions(&options, argc-2, &(argv[1])), &(argv[1]));
+
+	stdout = fopen("solution.txt", "w");
+	if(stdout == NULL) {
+		fprintf(stderr, "[ERROR] Could not open file solution.txt\n");
+		exit(-1);
+	}
+
+  	s->log = fopen("csp.log", "w");
+
+	if (s->log == NULL) {
+  	 	fprintf(stderr, "[ERROR] Error opening log file!\n");
+   		exit(-1);
+	}
+
+
+	enableStatistics(s, options.statsText, options.statsFile, argv[argc-1]);
+	
+	Main(&options, s, argv[argc-1]);
+	
+	flushTrace(s);
+	fclose(s->log);
+	fclose(stdout);
+	  
+  	return EXIT_SUCCESS;
+}
@@ -7,10 +7,31 @@
 #include "solve.h"
 #include <limits.h>
 
-extern FILE *logFile;
+/* the arena new expressions are allocated from, NULL for the heap */
+static __thread Arena expressionArena = NULL;
+
+/*
+  Makes a the arena of the expressions created from now on, NULL for the
+  heap, and returns the previous one. The parts of expressions in an arena
+  are released with the arena only, freeing them is a no-op meanwhile.
+*/
+Arena setExpressionArena(Arena a) {
+	Arena previous = expressionArena;
+	expressionArena = a;
+	return previous;
+}
+
+/* memory for a part of an expression */
+void *allocExpression(size_t size) {
+	if(expressionArena != NULL) {
+		return arenaAlloc(expressionArena, size);
+	}
+	return safeMalloc(size);
+}
 
 Constraint newValConstraint(NumExp e1) {
-	Constraint c = safeMalloc(sizeof(constraint));
+	Constraint c = allocExpression(sizeof(constraint));
+	c->arena = expressionArena;
 	c->arity = 0;
 	c->exp1 = e1;
 	c->exp2 = NULL;
@@ -62,46 +83,61 @@ int indexOfConstraint(Constraint c) {
 }
 
 void freeConstraint(Constraint c) {
+	Arena previous;
+	freeIntegerSet(c->vars);
+	if(c->arena != NULL) {
+		/* released with its arena */
+		return;
+	}
+	previous = setExpressionArena(NULL);
 	freeNumExp(c->exp1);
 	if(c->exp2 != NULL) {
 		freeNumExp(c->exp2);
 	}
-	freeIntegerSet(c->vars);
 	free(c);
+	setExpressionArena(previous);
 }
 
-ConstraintList addConstraint(ConstraintList list, Constraint constraint) {
-	ConstraintList temp = list;
-	ConstraintList new = safeMalloc(sizeof(constraintList));
+/* 
+  appends constraint to list in constant time, last is the last item of
+  list and is updated; both are NULL for an empty list
+*/
+ConstraintList addConstraint(ConstraintList list, ConstraintList *last, Constraint constraint) {
+	ConstraintList new = allocExpression(sizeof(constraintList));
 	new->constraint = constraint;
 	new->next = NULL;
 	if(list == NULL) {
-		return new;
-	}
-	while(temp->next != NULL) {
-		temp = temp->next;
-	}
-	if(temp->next == NULL) {
-		temp->next = new;
+		list = new;
+	} else {
+		(*last)->next = new;
 	}
+	*last = new;
 	return list;
 }
 
 void freeConstraintList(ConstraintList cl) {
-	if(cl != NULL) {
-		freeConstraintList(cl->next);
+	ConstraintList next;
+	if(expressionArena != NULL) {
+		return;
+	}
+	while(cl != NULL) {
+		next = cl->next;
 		free(cl);
+		cl = next;
 	}
 }
 
 NumExp newNumExp(void *data) {
-	NumExp numExp = safeMalloc(sizeof(numExp));
+	NumExp numExp = allocExpression(sizeof(struct numExp));
 	numExp->data = data;
 	numExp->next = NULL;
 	return numExp;
 }
 
 void freeNumExp(NumExp numexp) {
+	if(expressionArena != NULL) {
+		return;
+	}
 	if(numexp->next == NULL) {
 		freeTerm(numexp->data);
 	} else {
@@ -129,6 +165,24 @@ int matchVarExpression(Variable v, NumExp exp) {
 	return (val->type == VARVAL && val->data.varIndex == v->index);
 }
 
+/* the index of the variable if exp is a single variable, -1 otherwise */
+int varOfNumExp(NumExp exp) {
+	Term t;
+	Factor f;
+	if(exp->next != NULL) {
+		return -1;
+	}
+	t = exp->data;
+	if(t->next != NULL) {
+		return -1;
+	}
+	f = t->data;
+	if(f->type != VALUE || f->data.value->type != VARVAL || f->data.value->exponent != NULL) {
+		return -1;
+	}
+	return f->data.value->data.varIndex;
+}
+
 NumExp addTerm(NumExp old, TermOperator termop, Term t) {
 	NumExp new = newNumExp(old);
 	new->termop = termop;
@@ -147,13 +201,16 @@ int singletonNumExp(NumExp n, Problem p) {
 }
 
 Term newTerm(void *data) {
-	Term t = safeMalloc(sizeof(term));
+	Term t = allocExpression(sizeof(term));
 	t->next = NULL;
 	t->data = data;
 	return t;
 } 
 
 void freeTerm(Term t) {
+	if(expressionArena != NULL) {
+		return;
+	}
 	if(t->next == NULL) {
 		freeFactor(t->data);
 	} else {
@@ -178,12 +235,15 @@ int singletonTerm(Term t, Problem p) {
 }
 
 Factor newFactor(FactorType type) {
-	Factor f = safeMalloc(sizeof(factor));
+	Factor f = allocExpression(sizeof(factor));
 	f->type = type;
 	return f;
 }
 
 void freeFactor(Factor f) {
+	if(expressionArena != NULL) {
+		return;
+	}
 	if(f->type == NUMNEG) {
 		freeFactor(f->data.factor);
 	} else { /* VALUE */
@@ -205,7 +265,7 @@ Value subValueOfFactor(Factor f) {
 }
 
 FunctionCall newFunctionCall(FunctionName name, int argc, void *argv) {
-	FunctionCall f = safeMalloc(sizeof(functionCall));
+	FunctionCall f = allocExpression(sizeof(functionCall));
 	f->name = name;
 	f->argc = argc;
 	f->argv = argv;
@@ -216,6 +276,9 @@ void freeFunctionCall(FunctionCall f) {
 	int i;
 	ConstraintList *lists;
 	NumExp *exps;
+	if(expressionArena != NULL) {
+		return;
+	}
 	if(f->name == ANY || f->name == ALL) {
 		lists = (ConstraintList *) f->argv;
 		for(i = 0; i < f->argc; i++) {
@@ -265,13 +328,16 @@ int singletonFactor(Factor f, Problem p) {
 
 
 Value newValue(ValueType type) {
-	Value v = safeMalloc(sizeof(value));
+	Value v = allocExpression(sizeof(value));
 	v->type = type;
 	v->exponent = NULL;
 	return v;
 }
 
 void freeValue(Value v) {
+	if(expressionArena != NULL) {
+		return;
+	}
 	if(v->type == NUMEXP) {
 		freeNumExp(v->data.numexp);
 	} else if(v->type == FUNCVAL) {
@@ -343,117 +409,117 @@ Value newNumExpVal(NumExp numexp) {
 	return v;
 }
 
-void printRelOperator(RelOperator op) {
+void printRelOperator(FILE *out, RelOperator op) {
 	char *relops[] = {"=", "<", ">", ">=", "<=", "<>"};
-	addLog(" %s ", relops[op]);
+	fprintf(out, " %s ", relops[op]);
 }
 
-void printTermOperator(TermOperator op) {
+void printTermOperator(FILE *out, TermOperator op) {
 	char *termops[] = {"-", "+"};
-	addLog(" %s ", termops[op]);
+	fprintf(out, " %s ", termops[op]);
 }
 
-void printFactorOperator(FactorOperator op) {
+void printFactorOperator(FILE *out, FactorOperator op) {
 	char *factorops[] = {"*", "/", "%"};
-	addLog(" %s ", factorops[op]);
+	fprintf(out, " %s ", factorops[op]);
 }
 
-void printValue(Value v) {
-	char *functions[] = {"MAX", "MIN", "ABS", "ANY", "ALL"};
+void printValue(FILE *out, Value v) {
+	char *functions[] = {"MAX", "MIN", "ABS", "ANY", "ALL", "ELEMENT"};
 	int i;
 	switch(v->type) {
 		case NUMEXP:
-			addLog("(");
-			printNumExp(v->data.numexp);
-			addLog(")");
+			fprintf(out, "(");
+			printNumExp(out, v->data.numexp);
+			fprintf(out, ")");
 			break;
 		case INTVAL:
-			addLog("%d", v->data.intval);
+			fprintf(out, "%d", v->data.intval);
 			break;
 		case FUNCVAL:
-			addLog("%s(", functions[v->data.funcCall->name]);
+			fprintf(out, "%s(", functions[v->data.funcCall->name]);
 			if(v->data.funcCall->name == ANY || v->data.funcCall->name == ALL) {
 				ConstraintList *lists = v->data.funcCall->argv;
 				ConstraintList list = lists[0];
 				while(list != NULL) {
-					printNumExp(firstExp(list->constraint));
+					printNumExp(out, firstExp(list->constraint));
 					if(secondExp(list->constraint) != NULL) {
-						printRelOperator(operatorOfConstraint(list->constraint));
-						printNumExp(secondExp(list->constraint));
+						printRelOperator(out, operatorOfConstraint(list->constraint));
+						printNumExp(out, secondExp(list->constraint));
 					}
 					list = list->next;
 				}
 			} else {
 				NumExp *numExps = v->data.funcCall->argv;
-				printNumExp(numExps[0]);
+				printNumExp(out, numExps[0]);
 				for(i = 1; i < v->data.funcCall->argc; i++) {
-					addLog(", ");
-					printNumExp(numExps[i]);	
+					fprintf(out, ", ");
+					printNumExp(out, numExps[i]);	
 				}
 			}
-			addLog(")");
+			fprintf(out, ")");
 			break;
 		default: /* VARVAL */
-			addLog("X%d", v->data.varIndex);
+			fprintf(out, "X%d", v->data.varIndex);
 			break;
 	}
 	if(v->exponent != NULL) {
-		addLog("^");
-		printFactor(v->exponent);
+		fprintf(out, "^");
+		printFactor(out, v->exponent);
 	}
 }
 
-void printFactor(Factor f) {
+void printFactor(FILE *out, Factor f) {
 	if(f->type == NUMNEG) {
-		addLog("-(");
-		printFactor(f->data.factor);
-		addLog(")");
+		fprintf(out, "-(");
+		printFactor(out, f->data.factor);
+		fprintf(out, ")");
 	} else {	/* VALUE */
-		printValue(f->data.value);
+		printValue(out, f->data.value);
 	}
 }
 
-void printTerm(Term t) {
+void printTerm(FILE *out, Term t) {
 	if(t->next == NULL) {
-		printFactor(t->data);
+		printFactor(out, t->data);
 	} else {
-		addLog("(");
-		printTerm(t->data);
-		addLog(")");
-		printFactorOperator(t->factorop);
-		addLog("(");
-		printTerm(t->next);
-		addLog(")");
+		fprintf(out, "(");
+		printTerm(out, t->data);
+		fprintf(out, ")");
+		printFactorOperator(out, t->factorop);
+		fprintf(out, "(");
+		printTerm(out, t->next);
+		fprintf(out, ")");
 	}
 }
 
-void printNumExp(NumExp numExp) {
+void printNumExp(FILE *out, NumExp numExp) {
 	if(numExp->next == NULL) {
-		printTerm(numExp->data);
+		printTerm(out, numExp->data);
 	} else {
-		addLog("(");
-		printNumExp(numExp->data);
-		addLog(")");
-		printTermOperator(numExp->termop);
-		addLog("(");
-		printNumExp(numExp->next);
-		addLog(")");
+		fprintf(out, "(");
+		printNumExp(out, numExp->data);
+		fprintf(out, ")");
+		printTermOperator(out, numExp->termop);
+		fprintf(out, "(");
+		printNumExp(out, numExp->next);
+		fprintf(out, ")");
 	}
 }
 
-void printConstraint(Constraint c) {
-	printNumExp(c->exp1);
+void printConstraint(FILE *out, Constraint c) {
+	printNumExp(out, c->exp1);
 	if(c->exp2 != NULL) {
-		printRelOperator(c->op);
-		printNumExp(c->exp2);
+		printRelOperator(out, c->op);
+		printNumExp(out, c->exp2);
 	}
-	addLog("\n");
+	fprintf(out, "\n");
 }
 
-void printConstraintList(ConstraintList cl) {
+void printConstraintList(FILE *out, ConstraintList cl) {
 	while(cl !=  NULL) {
-		addLog("\t\t");
-		printConstraint(cl->constraint);
+		fprintf(out, "\t\t");
+		printConstraint(out, cl->constraint);
 		cl = cl->next;
 	}
 }
@@ -462,20 +528,43 @@ int *varIndicesOfConstraint(Constraint c) {
 	return valuesOfSet(c->vars);
 }
 
-/* returns the maximum of numerical expressions exp1 and exp2 */
-int max(NumExp exp1, NumExp exp2, Problem p) {
-	int a, b;
-	a = calcExp(exp1, p);
-	b = calcExp(exp2, p);
-	return (a > b ? a : b);
+/* returns the maximum of the count numerical expressions exps */
+int max(NumExp *exps, int count, Problem p) {
+	int result = calcExp(exps[0], p), a, i;
+	for(i = 1; i < count; i++) {
+		a = calcExp(exps[i], p);
+		if(a > result) {
+			result = a;
+		}
+	}
+	return result;
 }
 
-/* returns the minimum of numerical expressions exp1 and exp2 */
-int min(NumExp exp1, NumExp exp2, Problem p) {
-	int a, b;
-	a = calcExp(exp1, p);
-	b = calcExp(exp2, p);
-	return (a < b ? a : b);
+/* returns the minimum of the count numerical expressions exps */
+int min(NumExp *exps, int count, Problem p) {
+	int result = calcExp(exps[0], p), a, i;
+	for(i = 1; i < count; i++) {
+		a = calcExp(exps[i], p);
+		if(a < result) {
+			result = a;
+		}
+	}
+	return result;
+}
+
+/*
+  returns the entry of [exps[1], .., exps[count-1]] at the index exps[0],
+  counting from 0. An index out of range is taken as the nearest index, the
+  rewriter restricts the index to the range of the array.
+*/
+int element(NumExp *exps, int count, Problem p) {
+	int index = calcExp(exps[0], p);
+	if(index < 0) {
+		index = 0;
+	} else if(index > count-2) {
+		index = count-2;
+	}
+	return calcExp(exps[index+1], p);
 }
 
 /* returns the absolute value of numerical expression exp1 */
@@ -496,15 +585,17 @@ int calcFuncVal(FunctionCall fc, Problem p) {
 		}
 		return and(lists[0], p);
 	}
-	/* not ANY or ALL -> MAX, MIN or ABS */
+	/* not ANY or ALL -> MAX, MIN, ELEMENT or ABS */
 	NumExp *numExps = arguments;
-	if(argCount == 2) { /* MAX or MIN */
-		if(funcName == MIN) {
-			return min(numExps[0], numExps[1], p);
-		}
-		return max(numExps[0], numExps[1], p);
+	if(funcName == ELEMENT) {
+		return element(numExps, argCount, p);
+	}
+	if(funcName == MIN) {
+		return min(numExps, argCount, p);
+	}
+	if(funcName == MAX) {
+		return max(numExps, argCount, p);
 	}
-	/* argCount == 1 -> ABS */
 	return absVal(numExps[0], p);
 }
 
@@ -521,7 +612,7 @@ int calcValue(Value v, Problem p) {
 		base = v->data.intval;
 	}
 	if(v->exponent != NULL) {
-		return pow(base, calcFactor(v->exponent, p));
+		return intPower(base, calcFactor(v->exponent, p));
 	}
 	return base;
 }
@@ -546,8 +637,8 @@ int calcTerm(Term t, Problem p) {
 	}
 	/* div or mod */
 	if(val2 == 0) {
-		addLog("Division by zero: abort\n");
-		exit(-1);	
+		fprintf(stderr, "[ERROR] Division by zero\n");
+		solveFailed(-1);
 	}
 	if(t->factorop == DIV) {
 		return (val1 / val2);
@@ -568,6 +659,143 @@ int calcExp(NumExp exp, Problem p) {
 	return calcTerm(exp->data, p);
 }
 
+
+/* 
+  Constant folding: subexpressions without variables are replaced by their
+  value. Every fold function returns 1 and stores the value in val if its
+  expression is constant. Divisions by zero are left to the evaluation.
+*/
+static int foldNumExp(NumExp exp, int *val);
+static int foldFactor(Factor f, int *val);
+
+static int foldFuncCall(FunctionCall fc, int *val) {
+	NumExp *numExps = fc->argv;
+	int a, constant = 1, i;
+	if(fc->name == ANY || fc->name == ALL) {
+		ConstraintList *lists = fc->argv;
+		ConstraintList l;
+		for(l = lists[0]; l != NULL; l = l->next) {
+			foldConstraint(l->constraint);
+		}
+		return 0;
+	}
+	if(fc->name == ABS) {
+		if(!foldNumExp(numExps[0], &a)) {
+			return 0;
+		}
+		*val = (a >= 0 ? a : -a);
+		return 1;
+	}
+	if(fc->name == ELEMENT) {
+		/* constant if the index is in range and selects a constant entry */
+		for(i = 1; i < fc->argc; i++) {
+			foldNumExp(numExps[i], &a);
+		}
+		if(!foldNumExp(numExps[0], &a) || a < 0 || a > fc->argc-2) {
+			return 0;
+		}
+		return foldNumExp(numExps[a+1], val);
+	}
+	/* evaluated in full, all arguments are folded */
+	for(i = 0; i < fc->argc; i++) {
+		if(!foldNumExp(numExps[i], &a)) {
+			constant = 0;
+		} else if(constant && (i == 0 || (fc->name == MIN ? a < *val : a > *val))) {
+			*val = a;
+		}
+	}
+	return constant;
+}
+
+static int foldValue(Value v, int *val) {
+	int constant = 0, exponent;
+	if(v->type == INTVAL) {
+		*val = v->data.intval;
+		constant = 1;
+	} else if(v->type == NUMEXP) {
+		constant = foldNumExp(v->data.numexp, val);
+	} else if(v->type == FUNCVAL) {
+		constant = foldFuncCall(v->data.funcCall, val);
+	}
+	if(v->exponent != NULL) {
+		if(!foldFactor(v->exponent, &exponent) || !constant || (*val == 0 && exponent < 0)) {
+			return 0;
+		}
+		*val = intPower(*val, exponent);
+	}
+	if(constant && (v->type != INTVAL || v->exponent != NULL)) {
+		if(v->type == NUMEXP) {
+			freeNumExp(v->data.numexp);
+		} else if(v->type == FUNCVAL) {
+			freeFunctionCall(v->data.funcCall);
+		}
+		if(v->exponent != NULL) {
+			freeFactor(v->exponent);
+			v->exponent = NULL;
+		}
+		v->type = INTVAL;
+		v->data.intval = *val;
+	}
+	return constant;
+}
+
+static int foldFactor(Factor f, int *val) {
+	if(f->type == VALUE) {
+		return foldValue(f->data.value, val);
+	}
+	if(!foldFactor(f->data.factor, val)) {
+		return 0;
+	}
+	*val = -*val;
+	freeFactor(f->data.factor);
+	f->type = VALUE;
+	f->data.value = newIntVal(*val);
+	return 1;
+}
+
+static int foldTerm(Term t, int *val) {
+	int a, b;
+	if(t->next == NULL) {
+		return foldFactor(t->data, val);
+	}
+	if(!(foldTerm(t->data, &a) & foldTerm(t->next, &b)) || (t->factorop != MUL && b == 0)) {
+		return 0;
+	}
+	*val = (t->factorop == MUL ? a*b : (t->factorop == DIV ? a/b : a%b));
+	freeTerm(t->data);
+	freeTerm(t->next);
+	t->next = NULL;
+	t->data = newValueFactor(newIntVal(*val));
+	return 1;
+}
+
+static int foldNumExp(NumExp exp, int *val) {
+	int a, b;
+	if(exp->next == NULL) {
+		return foldTerm(exp->data, val);
+	}
+	if(!(foldNumExp(exp->data, &a) & foldNumExp(exp->next, &b))) {
+		return 0;
+	}
+	*val = (exp->termop == PLUS ? a+b : a-b);
+	freeNumExp(exp->data);
+	freeNumExp(exp->next);
+	exp->next = NULL;
+	exp->data = newTerm(newValueFactor(newIntVal(*val)));
+	return 1;
+}
+
+/* folds the constant subexpressions of c, before it is linked to its variables */
+void foldConstraint(Constraint c) {
+	Arena previous = setExpressionArena(c->arena);
+	int val;
+	foldNumExp(c->exp1, &val);
+	if(c->exp2 != NULL) {
+		foldNumExp(c->exp2, &val);
+	}
+	setExpressionArena(previous);
+}
+
 int arityOfConstraint(Constraint c) {
   return sizeOfSet(c->vars);
 }
@@ -4,7 +4,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
-#include <math.h> 
 
 struct Constraint;
 typedef struct value *Value;
@@ -29,7 +28,7 @@ typedef enum {
 } ValueType;
 
 typedef enum {
-	MAX, MIN, ABS, ANY, ALL
+	MAX, MIN, ABS, ANY, ALL, ELEMENT
 } FunctionName;
 
 typedef enum Rel{
@@ -97,6 +96,8 @@ typedef struct constraint {		/* exp1 [op exp2]? */
 	/* optional: if exp2 != NULL. constraint: exp1 [op exp2]? */
 	RelOperator op;			
 	NumExp exp2;		
+
+	Arena arena;			/* owner of the expressions, NULL if they are on the heap */
 } constraint;
 
 typedef struct constraintList {
@@ -104,6 +105,9 @@ typedef struct constraintList {
 	ConstraintList next;
 } constraintList;
 
+Arena setExpressionArena(Arena a);
+void *allocExpression(size_t size);
+
 Constraint newValConstraint(NumExp e1);
 Constraint newBoolConstraint(NumExp e1, RelOperator o, NumExp e2);
 
@@ -119,41 +123,41 @@ RelOperator operatorOfConstraint(Constraint c);
 int indexOfConstraint(Constraint c);
 
 void freeConstraint(Constraint c);
-void printConstraint(Constraint c);
+void printConstraint(FILE *out, Constraint c);
 
-ConstraintList addConstraint(ConstraintList list, Constraint constraint);
+ConstraintList addConstraint(ConstraintList list, ConstraintList *last, Constraint constraint);
 void freeConstraintList(ConstraintList cl);
-void printConstraintList(ConstraintList cl);
+void printConstraintList(FILE *out, ConstraintList cl);
 int *varIndicesOfConstraint(Constraint c);
 
 NumExp newNumExp(void *data);
 NumExp addTerm(NumExp old, TermOperator termop, Term t);
 void freeNumExp(NumExp numexp);
-void printNumExp(NumExp numExp);
-void printRelOperator(RelOperator op);
+void printNumExp(FILE *out, NumExp numExp);
+void printRelOperator(FILE *out, RelOperator op);
 
 Term newTerm(void *data);
 Term addFactor(Term old, FactorOperator factorop, Factor f);
 void freeTerm(Term t);
-void printTerm(Term t);
-void printTermOperator(TermOperator op);
+void printTerm(FILE *out, Term t);
+void printTermOperator(FILE *out, TermOperator op);
 int singletonTerm(Term t, Problem p);
 
 Factor newFactor(FactorType type);
 Factor newValueFactor(Value v);
 Factor newMinusFactor(Factor next);
 void freeFactor(Factor f);
-void printFactor(Factor f);
-void printFactorOperator(FactorOperator op);
+void printFactor(FILE *out, Factor f);
+void printFactorOperator(FILE *out, FactorOperator op);
 int singletonFactor(Factor f, Problem p);
 FactorType typeOfFactor(Factor f);
 Factor subFactorOfFactor(Factor f);
 Value subValueOfFactor(Factor f);
 
 FunctionCall newFunctionCall(FunctionName name, int argc, void *argv);
-FunctionName nameOfFuncCall(FunctionCall fc);
+FunctionName nameOfFunctionCall(FunctionCall fc);
 int argCountOfFunctionCall(FunctionCall fc);
-void *argumentsOfFuncCall(FunctionCall fc);
+void *argsOfFunctionCall(FunctionCall fc);
 void freeFunctionCall(FunctionCall f);
 
 Value newValue(ValueType type);
@@ -162,31 +166,34 @@ Value newVarVal(int varIndex);
 Value newFuncVal(FunctionCall fc);
 Value newNumExpVal(NumExp numexp);
 void freeValue(Value v);
-void printValue(Value v);
+void printValue(FILE *out, Value v);
 int singletonValue(Value v, Problem p);
 
 
 Term newTerm(void *data);
 Term addFactor(Term old, FactorOperator factorop, Factor f);
 void freeTerm(Term t);
-void printTerm(Term t);
+void printTerm(FILE *out, Term t);
 
 NumExp newNumExp(void *data);
 NumExp addTerm(NumExp numExp, TermOperator termop, Term t);
 void freeNumExp(NumExp numexp);
 int singletonNumExp(NumExp n, Problem p);
 int matchVarExpression(Variable v, NumExp exp);
+int varOfNumExp(NumExp exp);
 
 
 /* Functions regarding calculation expressions */
-int max(NumExp exp1, NumExp exp2, Problem p);
-int min(NumExp exp1, NumExp exp2, Problem p);
+int max(NumExp *exps, int count, Problem p);
+int min(NumExp *exps, int count, Problem p);
+int element(NumExp *exps, int count, Problem p);
 int absVal(NumExp exp1, Problem p);
 int calcFuncVal(FunctionCall fc, Problem p);
 int calcValue(Value v, Problem p);
 int calcFactor(Factor f, Problem p);
 int calcTerm(Term t, Problem p);
 int calcExp(NumExp exp, Problem p);
+void foldConstraint(Constraint c);
 
 /* Functions regarding properties of constraints */
 int arityOfConstraint(Constraint c);
@@ -0,0 +1,421 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "variable.h"
+#include "constraint.h"
+#include "solve.h"
+#include "binary.h"
+#include "data.h"
+#include "cspsolver.h"
+
+typedef struct cspModel {
+	Problem problem;
+	Solver solver;
+	int varSpace;				/* allocated size of problem->vars */
+	int constraintSpace;		/* allocated size of problem->constraints */
+	int solved;
+	int linked;					/* constraints and variables refer to each other */
+} cspModel;
+
+/* a CspExpr is a NumExp of the solver */
+#define EXP(e) ((NumExp) (e))
+#define EXPR(e) ((CspExpr) (e))
+
+static void modelError(char *message) {
+	fprintf(stderr, "[ERROR] %s\n", message);
+	exit(-1);
+}
+
+static void checkVariable(CspModel m, int var) {
+	if(var < 0 || var >= m->problem->varCount) {
+		fprintf(stderr, "[ERROR] Unknown variable X%d\n", var);
+		exit(-1);
+	}
+}
+
+static void checkNotSolved(CspModel m) {
+	if(m->solved) {
+		modelError("The model has already been solved");
+	}
+}
+
+CspModel cspNewModel() {
+	CspModel m = safeMalloc(sizeof(cspModel));
+	m->problem = emptyProblem();
+	m->problem->solvespec.type = SOLVEALL;
+	m->solver = newSolver();
+	m->varSpace = 0;
+	m->constraintSpace = 0;
+	m->solved = 0;
+	m->linked = 0;
+	return m;
+}
+
+/* a copy of the unsolved model m and its options, compiled through the binary normal form */
+CspModel cspCopyModel(CspModel m) {
+	CspModel copy = safeMalloc(sizeof(cspModel));
+	size_t size;
+	char *image;
+	checkNotSolved(m);
+	image = encodeBinaryProblem(m->problem, &size);
+	copy->problem = decodeBinaryProblem(image, size, "model");
+	free(image);
+	copy->solver = newSolver();
+	copySolverOptions(copy->solver, m->solver);
+	copy->varSpace = copy->problem->varCount;
+	copy->constraintSpace = copy->problem->constraintCount;
+	copy->solved = 0;
+	copy->linked = 1;
+	return copy;
+}
+
+void cspFreeModel(CspModel m) {
+	freeProblem(m->problem);
+	freeSolver(m->solver);
+	free(m);
+}
+
+int cspNewVariable(CspModel m, int min, int max) {
+	Problem p = m->problem;
+	Variable var;
+	checkNotSolved(m);
+	if(min > max) {
+		modelError("Empty domain for new variable");
+	}
+	if(p->varCount == m->varSpace) {
+		m->varSpace = (m->varSpace == 0 ? 16 : 2*m->varSpace);
+		p->vars = safeRealloc(p->vars, m->varSpace*sizeof(Variable));
+	}
+	var = newVariable(p->varCount, INTEGER);
+	addIntervalToSet(domainOfVar(var), min, max);
+	setVarAtIndex(p, p->varCount, var);
+	return p->varCount++;
+}
+
+void cspSetDomain(CspModel m, int var, const int *values, int count) {
+	Variable v;
+	IntegerSet domain = emptyIntegerSet();
+	int i;
+	checkNotSolved(m);
+	checkVariable(m, var);
+	for(i = 0; i < count; i++) {
+		addIntegerToSet(domain, values[i]);
+	}
+	v = varByIndex(m->problem, var);
+	freeIntegerSet(domainOfVar(v));
+	setDomainOfVar(v, domain);
+}
+
+int cspApplyData(CspModel m, const char *data) {
+	checkNotSolved(m);
+	return applyData(m->problem, data, "data");
+}
+
+int cspVariableCount(CspModel m) {
+	return m->problem->varCount;
+}
+
+/* the expression e as a single term, in parentheses if needed */
+static Term termOf(NumExp e) {
+	Term t;
+	if(e->next != NULL) {
+		return newTerm(newValueFactor(newNumExpVal(e)));
+	}
+	t = e->data;
+	free(e);
+	return t;
+}
+
+/* the expression e as a single factor, in parentheses if needed */
+static Factor factorOf(NumExp e) {
+	Term t = e->data;
+	Factor f;
+	if(e->next != NULL || t->next != NULL) {
+		return newValueFactor(newNumExpVal(e));
+	}
+	f = t->data;
+	free(t);
+	free(e);
+	return f;
+}
+
+/* the expression e as a value without exponent, in parentheses if needed */
+static Value valueOf(NumExp e) {
+	Factor f = factorOf(e);
+	Value v;
+	if(f->type == NUMNEG || f->data.value->exponent != NULL) {
+		return newNumExpVal(newNumExp(newTerm(f)));
+	}
+	v = f->data.value;
+	free(f);
+	return v;
+}
+
+static CspExpr valueExpr(Value v) {
+	return EXPR(newNumExp(newTerm(newValueFactor(v))));
+}
+
+CspExpr cspConstant(int value) {
+	return valueExpr(newIntVal(value));
+}
+
+CspExpr cspVariable(CspModel m, int var) {
+	checkVariable(m, var);
+	return valueExpr(newVarVal(var));
+}
+
+CspExpr cspPlus(CspExpr left, CspExpr right) {
+	return EXPR(addTerm(EXP(left), PLUS, termOf(EXP(right))));
+}
+
+CspExpr cspMinus(CspExpr left, CspExpr right) {
+	return EXPR(addTerm(EXP(left), MINUS, termOf(EXP(right))));
+}
+
+static CspExpr factorExpr(CspExpr left, FactorOperator op, CspExpr right) {
+	Term t = termOf(EXP(left));
+	return EXPR(newNumExp(addFactor(t, op, factorOf(EXP(right)))));
+}
+
+CspExpr cspTimes(CspExpr left, CspExpr right) {
+	return factorExpr(left, MUL, right);
+}
+
+CspExpr cspDivide(CspExpr left, CspExpr right) {
+	return factorExpr(left, DIV, right);
+}
+
+CspExpr cspModulo(CspExpr left, CspExpr right) {
+	return factorExpr(left, MOD, right);
+}
+
+CspExpr cspPower(CspExpr base, CspExpr exponent) {
+	Value v = valueOf(EXP(base));
+	v->exponent = factorOf(EXP(exponent));
+	return valueExpr(v);
+}
+
+CspExpr cspNegate(CspExpr e) {
+	return EXPR(newNumExp(newTerm(newMinusFactor(factorOf(EXP(e))))));
+}
+
+static CspExpr functionExpr(FunctionName name, int argc, CspExpr arg1, CspExpr arg2) {
+	NumExp *args = allocExpression(argc*sizeof(NumExp));
+	args[0] = EXP(arg1);
+	if(argc > 1) {
+		args[1] = EXP(arg2);
+	}
+	return valueExpr(newFuncVal(newFunctionCall(name, argc, args)));
+}
+
+CspExpr cspAbs(CspExpr e) {
+	return functionExpr(ABS, 1, e, NULL);
+}
+
+CspExpr cspMax(CspExpr left, CspExpr right) {
+	return functionExpr(MAX, 2, left, right);
+}
+
+CspExpr cspMin(CspExpr left, CspExpr right) {
+	return functionExpr(MIN, 2, left, right);
+}
+
+CspExpr cspElement(CspExpr index, const CspExpr *entries, int count) {
+	NumExp *args;
+	int i;
+	if(count < 1) {
+		modelError("An element needs at least one entry");
+	}
+	args = allocExpression((count+1)*sizeof(NumExp));
+	args[0] = EXP(index);
+	for(i = 0; i < count; i++) {
+		args[i+1] = EXP(entries[i]);
+	}
+	return valueExpr(newFuncVal(newFunctionCall(ELEMENT, count+1, args)));
+}
+
+/* a sum any(X1 = value) + .. + any(Xn = value), which the solver propagates as a count constraint */
+CspExpr cspCount(CspModel m, const int *vars, int count, int value) {
+	CspExpr sum = NULL, term;
+	ConstraintList *args, last;
+	int i;
+	for(i = 0; i < count; i++) {
+		args = allocExpression(sizeof(ConstraintList));
+		args[0] = addConstraint(NULL, &last, newBoolConstraint(EXP(cspVariable(m, vars[i])), IS, EXP(cspConstant(value))));
+		term = valueExpr(newFuncVal(newFunctionCall(ANY, 1, args)));
+		sum = (sum == NULL ? term : cspPlus(sum, term));
+	}
+	return (sum == NULL ? cspConstant(0) : sum);
+}
+
+void cspFreeExpr(CspExpr e) {
+	freeNumExp(EXP(e));
+}
+
+static void postConstraint(CspModel m, Constraint c) {
+	Problem p = m->problem;
+	checkNotSolved(m);
+	if(p->constraintCount == m->constraintSpace) {
+		m->constraintSpace = (m->constraintSpace == 0 ? 16 : 2*m->constraintSpace);
+		p->constraints = safeRealloc(p->constraints, m->constraintSpace*sizeof(Constraint));
+	}
+	setIndexOfConstraint(c, p->constraintCount);
+	setConstraintAtIndex(p, p->constraintCount, c);
+	p->constraintCount++;
+	if(m->linked) {
+		linkConstraint(p, c);
+	}
+}
+
+void cspPost(CspModel m, CspExpr left, CspRelation rel, CspExpr right) {
+	Constraint c = newValConstraint(EXP(left));
+	if(right != NULL) {
+		setOperatorOfConstraint(c, (RelOperator) rel);
+		setSecondExp(c, EXP(right));
+	}
+	postConstraint(m, c);
+}
+
+void cspPostString(CspModel m, const char *constraint) {
+	postConstraint(m, parseConstraint(constraint));
+}
+
+/* all different, as the binary inequalities of every pair */
+void cspAllDifferent(CspModel m, const int *vars, int count) {
+	int i, j;
+	for(i = 0; i < count; i++) {
+		for(j = i+1; j < count; j++) {
+			cspPost(m, cspVariable(m, vars[i]), CSP_NEQ, cspVariable(m, vars[j]));
+		}
+	}
+}
+
+/* coefficients[0]*X(vars[0]) + ... rel rhs, coefficients NULL for all 1 */
+void cspSum(CspModel m, const int *coefficients, const int *vars, int count, CspRelation rel, int rhs) {
+	CspExpr sum = NULL, term;
+	int i;
+	for(i = 0; i < count; i++) {
+		term = cspVariable(m, vars[i]);
+		if(coefficients != NULL && coefficients[i] != 1) {
+			term = cspTimes(cspConstant(coefficients[i]), term);
+		}
+		sum = (sum == NULL ? term : cspPlus(sum, term));
+	}
+	if(sum == NULL) {
+		sum = cspConstant(0);
+	}
+	cspPost(m, sum, rel, cspConstant(rhs));
+}
+
+/* a table, as any(all(X1 = a1, .., Xn = an), ..) which the solver propagates as a table constraint */
+void cspTable(CspModel m, const int *vars, int count, const int *tuples, int tupleCount) {
+	ConstraintList alternatives = NULL, lastAlternative = NULL, assignments, last;
+	ConstraintList *args;
+	int i, t;
+	if(count < 1 || tupleCount < 1) {
+		modelError("A table needs at least one variable and one tuple");
+	}
+	for(t = 0; t < tupleCount; t++) {
+		assignments = NULL;
+		for(i = 0; i < count; i++) {
+			Constraint c = newBoolConstraint(EXP(cspVariable(m, vars[i])), IS, EXP(cspConstant(tuples[t*count+i])));
+			assignments = addConstraint(assignments, &last, c);
+		}
+		args = allocExpression(sizeof(ConstraintList));
+		args[0] = assignments;
+		alternatives = addConstraint(alternatives, &lastAlternative,
+		                             newValConstraint(EXP(valueExpr(newFuncVal(newFunctionCall(ALL, 1, args))))));
+	}
+	args = allocExpression(sizeof(ConstraintList));
+	args[0] = alternatives;
+	cspPost(m, valueExpr(newFuncVal(newFunctionCall(ANY, 1, args))), CSP_EQ, NULL);
+}
+
+/* a global cardinality constraint as a count per value */
+void cspGcc(CspModel m, const int *vars, int count, const int *values, const int *lows, const int *highs, int valueCount) {
+	int k;
+	for(k = 0; k < valueCount; k++) {
+		if(lows[k] == highs[k]) {
+			cspPost(m, cspCount(m, vars, count, values[k]), CSP_EQ, cspConstant(lows[k]));
+			continue;
+		}
+		cspPost(m, cspCount(m, vars, count, values[k]), CSP_GEQ, cspConstant(lows[k]));
+		cspPost(m, cspCount(m, vars, count, values[k]), CSP_LEQ, cspConstant(highs[k]));
+	}
+}
+
+void cspSetOption(CspModel m, CspOption option, int value) {
+	Solver s = m->solver;
+	switch(option) {
+		case CSP_OPTION_INITIAL_CONSISTENCY:
+			if(value < 0 || value > 2) {
+				modelError("Expecting initial consistency in [0..2]");
+			}
+			s->makeConsistent = value;
+			break;
+		case CSP_OPTION_MRV:
+			s->mrv = (value != 0);
+			break;
+		case CSP_OPTION_DEGREE:
+			s->degreeHeuristic = (value != 0);
+			break;
+		case CSP_OPTION_MOST_CONNECTED:
+			s->mostConnected = (value != 0);
+			break;
+		case CSP_OPTION_PROPAGATION:
+			if(value < CSP_PROPAGATION_NONE || value > CSP_PROPAGATION_MAC) {
+				modelError("Unknown propagation");
+			}
+			s->cp = value;
+			break;
+		case CSP_OPTION_TRACE:
+			setTraceLevel(s, value);
+			break;
+		case CSP_OPTION_PROFILE:
+			s->profiling = (value > 0 ? value : 0);
+			break;
+		case CSP_OPTION_PRESOLVE:
+			s->presolve = (value != 0);
+			break;
+		case CSP_OPTION_ALLDIFF:
+			s->alldiff = (value != 0);
+			break;
+		case CSP_OPTION_MAXMIN:
+			s->maxmin = (value != 0);
+			break;
+		default:
+			modelError("Unknown option");
+	}
+}
+
+void cspSetOptions(CspModel m, int argc, char **argv) {
+	enableHeuristics(m->solver, argc, argv);
+}
+
+void cspSetLog(CspModel m, FILE *log) {
+	m->solver->log = log;
+}
+
+int cspSolve(CspModel m, int limit, CspSolutionCallback callback, void *data) {
+	SolutionSink sink;
+	int count;
+	checkNotSolved(m);
+	m->solved = 1;
+	if(m->solver->log == NULL) {
+		m->solver->traceLevel = TRACE_OFF;
+	}
+	if(!m->linked) {
+		dropDuplicateConstraints(m->problem);
+		linkConstraintsAndVars(m->problem);
+		m->linked = 1;
+	}
+	sink = (callback != NULL ? newCallbackSink(callback, data, limit) : newCountSink(limit));
+	count = solveToSink(m->solver, m->problem, sink);
+	freeSolutionSink(sink);
+	return count;
+}
+
+long cspStateCount(CspModel m) {
+	return m->solver->stateCount;
+}
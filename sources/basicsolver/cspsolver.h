@@ -0,0 +1,121 @@
+#ifndef CSPSOLVER_H
+#define CSPSOLVER_H
+
+/*
+ * libcspsolver: the solver as a library.
+ *
+ * A model holds integer variables X0, X1, ... (numbered in order of
+ * creation) and constraints on them, and is solved in-process:
+ *
+ *   CspModel m = cspNewModel();
+ *   int x = cspNewVariable(m, 1, 3), y = cspNewVariable(m, 1, 3);
+ *   cspPost(m, cspPlus(cspVariable(m, x), cspVariable(m, y)), CSP_EQ, cspConstant(4));
+ *   cspPostString(m, "X0 <> X1");
+ *   cspSetOption(m, CSP_OPTION_PROPAGATION, CSP_PROPAGATION_FC);
+ *   cspSolve(m, -1, printValues, NULL);
+ *   cspFreeModel(m);
+ *
+ * Expressions are trees that are owned by the constraint they are posted
+ * in, every expression can be used only once. A model is solved once.
+ * Different models can be built and solved at the same time in different
+ * threads; parsing constraint strings is serialized by the process-wide
+ * lock of the parser, which is not reentrant. Errors are fatal, as
+ * in the solver program: they are reported on stderr and end the process.
+ */
+
+#include <stdio.h>
+
+typedef struct cspModel *CspModel;
+typedef struct cspExpr *CspExpr;
+
+/* relations, in the order of the solver */
+typedef enum {
+	CSP_EQ, CSP_LT, CSP_GT, CSP_GEQ, CSP_LEQ, CSP_NEQ
+} CspRelation;
+
+typedef enum {
+	CSP_OPTION_INITIAL_CONSISTENCY,	/* 0: none, 1: node, 2: arc (-iconst) */
+	CSP_OPTION_MRV,					/* 0/1 (-mrv) */
+	CSP_OPTION_DEGREE,				/* 0/1 (-deg) */
+	CSP_OPTION_MOST_CONNECTED,		/* 0/1 (-mostconnected) */
+	CSP_OPTION_PROPAGATION,			/* CSP_PROPAGATION_* (-fc, -arc) */
+	CSP_OPTION_TRACE,				/* trace level, needs a log (-trace) */
+	CSP_OPTION_PROFILE,				/* constraints in the profile, needs a log (-profile) */
+	CSP_OPTION_PRESOLVE,			/* 0/1 (-presolve) */
+	CSP_OPTION_ALLDIFF,				/* 0/1 (-alldiff) */
+	CSP_OPTION_MAXMIN				/* 0/1 (-maxmin) */
+} CspOption;
+
+#define CSP_PROPAGATION_NONE 0
+#define CSP_PROPAGATION_FC 1
+#define CSP_PROPAGATION_MAC 2
+
+/*
+  Called with the values of all variables for every solution found. Returns
+  0 to continue the search, anything else to stop it.
+*/
+typedef int (*CspSolutionCallback)(const int *values, int varCount, void *data);
+
+CspModel cspNewModel();
+void cspFreeModel(CspModel m);
+
+/*
+  Parametric models: a model is built once and copied for every instance,
+  the copy is then restricted with the data of the instance, either by
+  cspSetDomain or by cspApplyData (statements like "X3 = 5; X4 <- [1..3];",
+  returning 0 for invalid data). The copy has all options and the log of m.
+*/
+CspModel cspCopyModel(CspModel m);
+int cspApplyData(CspModel m, const char *data);
+
+/* variables, returning their index */
+int cspNewVariable(CspModel m, int min, int max);
+void cspSetDomain(CspModel m, int var, const int *values, int count);
+int cspVariableCount(CspModel m);
+
+/* expression builders */
+CspExpr cspConstant(int value);
+CspExpr cspVariable(CspModel m, int var);
+CspExpr cspPlus(CspExpr left, CspExpr right);
+CspExpr cspMinus(CspExpr left, CspExpr right);
+CspExpr cspTimes(CspExpr left, CspExpr right);
+CspExpr cspDivide(CspExpr left, CspExpr right);
+CspExpr cspModulo(CspExpr left, CspExpr right);
+CspExpr cspPower(CspExpr base, CspExpr exponent);
+CspExpr cspNegate(CspExpr e);
+CspExpr cspAbs(CspExpr e);
+CspExpr cspMax(CspExpr left, CspExpr right);
+CspExpr cspMin(CspExpr left, CspExpr right);
+/* entries[index], counting from 0; the index has to be kept in 0..count-1 */
+CspExpr cspElement(CspExpr index, const CspExpr *entries, int count);
+/* the number of vars that equal value */
+CspExpr cspCount(CspModel m, const int *vars, int count, int value);
+void cspFreeExpr(CspExpr e);
+
+/* constraints; right may be NULL, then left must not be 0 */
+void cspPost(CspModel m, CspExpr left, CspRelation rel, CspExpr right);
+void cspPostString(CspModel m, const char *constraint);
+void cspAllDifferent(CspModel m, const int *vars, int count);
+void cspSum(CspModel m, const int *coefficients, const int *vars, int count, CspRelation rel, int rhs);
+/* vars take the values of one of the tuples, tuple t is tuples[t*count] up to tuples[t*count+count-1] */
+void cspTable(CspModel m, const int *vars, int count, const int *tuples, int tupleCount);
+/* values[k] occurs between lows[k] and highs[k] times among vars, other values are not limited */
+void cspGcc(CspModel m, const int *vars, int count, const int *values, const int *lows, const int *highs, int valueCount);
+
+/* options, either one by one or as solver command line flags */
+void cspSetOption(CspModel m, CspOption option, int value);
+void cspSetOptions(CspModel m, int argc, char **argv);
+void cspSetLog(CspModel m, FILE *log);
+
+/*
+  Solves the model, calling callback (if not NULL) for every solution. Stops
+  after limit solutions, -1 for all. Returns the amount of solutions found, or
+  -1 if solving failed on an error (e.g. a division by zero) reported on stderr.
+*/
+int cspSolve(CspModel m, int limit, CspSolutionCallback callback, void *data);
+long cspStateCount(CspModel m);
+
+/* the solver program: solver [OPTION]... FILE */
+int cspSolverMain(int argc, char **argv);
+
+#endif
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "variable.h"
+#include "data.h"
+
+typedef struct dataReader {
+	const char *pos;
+	const char *path;
+	int line;
+} dataReader;
+
+static int dataError(dataReader *r, char *message) {
+	fprintf(stderr, "[ERROR] %s, line %d: %s\n", r->path, r->line, message);
+	return 0;
+}
+
+/* skips white space and comments, returns the next character */
+static char peek(dataReader *r) {
+	for(;;) {
+		if(*r->pos == '\n') {
+			r->line++;
+		}
+		if(isspace((unsigned char)*r->pos)) {
+			r->pos++;
+		} else if(*r->pos == '#') {
+			while(*r->pos != '\0' && *r->pos != '\n') {
+				r->pos++;
+			}
+		} else {
+			return *r->pos;
+		}
+	}
+}
+
+static int acceptToken(dataReader *r, const char *token) {
+	peek(r);
+	if(strncmp(r->pos, token, strlen(token)) == 0) {
+		r->pos += strlen(token);
+		return 1;
+	}
+	return 0;
+}
+
+static int readInteger(dataReader *r, int *value) {
+	char *end;
+	long n;
+	peek(r);
+	n = strtol(r->pos, &end, 10);
+	if(end == r->pos) {
+		return 0;
+	}
+	r->pos = end;
+	*value = (int) n;
+	return 1;
+}
+
+/* replaces the domain of var by its intersection with values */
+static void restrictDomain(Variable var, IntegerSet values) {
+	IntegerSet domain = intersect(domainOfVar(var), values);
+	freeIntegerSet(domainOfVar(var));
+	setDomainOfVar(var, domain);
+}
+
+/* reads "= value" or "<- [ranges]" into values */
+static int readValues(dataReader *r, IntegerSet values) {
+	int min, max;
+	if(acceptToken(r, "=")) {
+		if(!readInteger(r, &min)) {
+			return dataError(r, "expecting a value");
+		}
+		addIntegerToSet(values, min);
+		return 1;
+	}
+	if(!acceptToken(r, "<-") || !acceptToken(r, "[")) {
+		return dataError(r, "expecting '=' or '<- ['");
+	}
+	do {
+		if(!readInteger(r, &min)) {
+			return dataError(r, "expecting a value");
+		}
+		max = min;
+		if(acceptToken(r, "..") && !readInteger(r, &max)) {
+			return dataError(r, "expecting a value");
+		}
+		if(min <= max) {
+			addIntervalToSet(values, min, max);
+		}
+	} while(acceptToken(r, ","));
+	if(!acceptToken(r, "]")) {
+		return dataError(r, "expecting ']'");
+	}
+	return 1;
+}
+
+int applyData(Problem p, const char *data, const char *path) {
+	dataReader r = {data, path, 1};
+	IntegerSet values;
+	int var, ok;
+
+	while(peek(&r) != '\0') {
+		if(!acceptToken(&r, "X") || !readInteger(&r, &var)) {
+			return dataError(&r, "expecting a variable");
+		}
+		if(var < 0 || var >= p->varCount) {
+			return dataError(&r, "unknown variable");
+		}
+		values = emptyIntegerSet();
+		ok = readValues(&r, values);
+		if(ok) {
+			restrictDomain(varByIndex(p, var), values);
+		}
+		freeIntegerSet(values);
+		if(!ok) {
+			return 0;
+		}
+		if(!acceptToken(&r, ";")) {
+			return dataError(&r, "expecting ';'");
+		}
+	}
+	return 1;
+}
+
+int applyDataFile(Problem p, const char *path) {
+	size_t size;
+	char *data = readFileContents(path, &size);
+	int ok;
+	if(data == NULL) {
+		fprintf(stderr, "[ERROR] Could not read file %s\n", path);
+		return 0;
+	}
+	ok = applyData(p, data, path);
+	free(data);
+	return ok;
+}
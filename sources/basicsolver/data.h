@@ -0,0 +1,23 @@
+#ifndef DATA_H
+#define DATA_H
+
+#include "problem.h"
+
+/*
+ * Instance data: fixed values and domain restrictions that are applied to
+ * a loaded problem, so that a model that is grounded and compiled once can
+ * be solved for many data sets. Data consists of statements ending in ';',
+ * '#' starts a comment:
+ *
+ *   X3 = 5;               X3 is fixed to 5
+ *   X4 <- [1..3, 7];      the domain of X4 is restricted to 1, 2, 3 and 7
+ *
+ * Data only removes values: the new domain is the intersection with the
+ * domain of the model. Errors are reported on stderr, after which 0 is
+ * returned and the problem must not be solved.
+ */
+
+int applyData(Problem p, const char *data, const char *path);
+int applyDataFile(Problem p, const char *path);
+
+#endif
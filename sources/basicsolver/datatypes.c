@@ -28,6 +28,69 @@ void *safeRealloc(void *oldPointer, size_t size) {
 }
 
 
+/* the contents of the file at path, terminated by '\0', or NULL if it can not be read */
+char *readFileContents(const char *path, size_t *size) {
+	FILE *f = fopen(path, "rb");
+	char *data;
+	long length;
+
+	if(f == NULL) {
+		return NULL;
+	}
+	if(fseek(f, 0, SEEK_END) != 0 || (length = ftell(f)) < 0) {
+		fclose(f);
+		return NULL;
+	}
+	rewind(f);
+	data = safeMalloc(length+1);
+	if(fread(data, 1, length, f) != length) {
+		free(data);
+		fclose(f);
+		return NULL;
+	}
+	data[length] = '\0';
+	fclose(f);
+	*size = length;
+	return data;
+}
+
+/*
+  base to the power exponent in integer arithmetic, by repeated squaring.
+  Squares and cubes are plain multiplications. A negative exponent gives the
+  integer part of 1/base^-exponent; 0 to a negative power is a division by zero.
+*/
+int intPower(int base, int exponent) {
+	unsigned int b = base, result = 1;
+	switch(exponent) {
+		case 0:
+			return 1;
+		case 1:
+			return base;
+		case 2:
+			return (int) (b*b);
+		case 3:
+			return (int) (b*b*b);
+	}
+	if(exponent < 0) {
+		if(base == 0) {
+			fprintf(stderr, "[ERROR] Division by zero\n");
+			solveFailed(-1);
+		}
+		if(base == 1 || base == -1) {
+			return (exponent % 2 == 0 ? 1 : base);
+		}
+		return 0;
+	}
+	while(exponent > 0) {
+		if(exponent & 1) {
+			result *= b;
+		}
+		b *= b;
+		exponent >>= 1;
+	}
+	return (int) result;
+}
+
 /* BEGIN functions regarding datatype IntegerList */
 
 
@@ -403,3 +466,62 @@ void *top(Stack s) {
 }
 
 
+
+
+/* BEGIN functions regarding datatype Arena */
+
+#define ARENA_FIRST_BLOCK 16384
+#define ARENA_MAX_BLOCK 1048576
+
+/* the data of a block starts after the aligned header */
+#define ARENA_HEADER ((sizeof(arenaBlock)+sizeof(void *)-1) & ~(sizeof(void *)-1))
+
+Arena newArena() {
+	Arena a = safeMalloc(sizeof(arena));
+	a->blocks = NULL;
+	return a;
+}
+
+/*
+  size bytes from the arena a, aligned for pointers. Blocks double in size
+  up to ARENA_MAX_BLOCK, a larger request gets a block of its own.
+*/
+void *arenaAlloc(Arena a, size_t size) {
+	arenaBlock *block = a->blocks;
+	size_t blockSize;
+	size = (size+sizeof(void *)-1) & ~(sizeof(void *)-1);
+	if(block == NULL || block->size-block->used < size) {
+		blockSize = (block == NULL ? ARENA_FIRST_BLOCK : block->size*2);
+		if(blockSize > ARENA_MAX_BLOCK) {
+			blockSize = ARENA_MAX_BLOCK;
+		}
+		if(blockSize < size) {
+			blockSize = size;
+		}
+		block = safeMalloc(ARENA_HEADER+blockSize);
+		block->size = blockSize;
+		block->used = 0;
+		if(a->blocks != NULL && blockSize == size && a->blocks->size-a->blocks->used >= sizeof(void *)) {
+			/* keep allocating from the current block */
+			block->next = a->blocks->next;
+			a->blocks->next = block;
+		} else {
+			block->next = a->blocks;
+			a->blocks = block;
+		}
+	}
+	block->used += size;
+	return (char *) block+ARENA_HEADER+block->used-size;
+}
+
+void freeArena(Arena a) {
+	arenaBlock *next;
+	while(a->blocks != NULL) {
+		next = a->blocks->next;
+		free(a->blocks);
+		a->blocks = next;
+	}
+	free(a);
+}
+
+/* END functions regarding datatype Arena */
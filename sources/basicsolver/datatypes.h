@@ -10,6 +10,7 @@ typedef struct integerSet *IntegerSet;
 typedef struct listItem *List;
 typedef struct queue *Queue;
 typedef struct stack *Stack;
+typedef struct arena *Arena;
 
 typedef enum {
 	INTEGER, BOOLEAN
@@ -45,9 +46,21 @@ typedef struct stack {
   List first;
 } stack;
 
+typedef struct arenaBlock {
+	struct arenaBlock *next;
+	size_t size;
+	size_t used;
+} arenaBlock;
+
+typedef struct arena {			/* memory that is released all at once */
+	arenaBlock *blocks;			/* the block in use first */
+} arena;
+
 void *safeMalloc(size_t size);
 void *safeCalloc(int amount, size_t size);
 void *safeRealloc(void *oldPtr, size_t size);
+char *readFileContents(const char *path, size_t *size);
+int intPower(int base, int exponent);
 
 IntegerList newIntegerList(int val, IntegerList next);
 IntegerList copyIntegerList(IntegerList orig);
@@ -86,6 +99,10 @@ void push(Stack s, void *item);
 void *pop(Stack s);
 void *top(Stack s);
 
+Arena newArena();
+void *arenaAlloc(Arena a, size_t size);
+void freeArena(Arena a);
+
 #endif
 
 
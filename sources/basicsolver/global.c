@@ -0,0 +1,1819 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "variable.h"
+#include "constraint.h"
+#include "backup.h"
+#include "solve.h"
+#include "presolve.h"
+#include "global.h"
+
+/* candidates scored per step while growing a clique */
+#define CLIQUE_SCORE_LIMIT 64
+/* tuples per word of a table bitset */
+#define WORD_BITS (8*(int) sizeof(unsigned long long))
+/* combinations of values tried to find out if a disjunct can hold */
+#define DISJUNCT_SEARCH_LIMIT 256
+
+static int compareInts(const void *a, const void *b) {
+	int x = *(const int *) a, y = *(const int *) b;
+	return (x > y) - (x < y);
+}
+
+Global newGlobal(GlobalKind kind, int varCount, int *vars) {
+	Global g = safeMalloc(sizeof(global));
+	g->kind = kind;
+	g->index = -1;
+	g->varCount = varCount;
+	g->result = -1;
+	g->value = 0;
+	g->selector = -1;
+	g->offset = 0;
+	g->entryCount = 0;
+	g->entries = NULL;
+	g->constants = NULL;
+	g->tupleCount = 0;
+	g->valueStarts = NULL;
+	g->values = NULL;
+	g->residues = NULL;
+	g->supports = NULL;
+	g->literalCount = 0;
+	g->literalVars = NULL;
+	g->relations = NULL;
+	g->bounds = NULL;
+	g->disjunctCount = 0;
+	g->disjuncts = NULL;
+	g->disjunctStarts = NULL;
+	g->disjunctVars = NULL;
+	g->supported = NULL;
+	g->supportValues = NULL;
+	g->counted = 0;
+	g->relation = IS;
+	g->watched[0] = 0;
+	g->watched[1] = 1;
+	g->vars = safeMalloc(varCount*sizeof(int));
+	memcpy(g->vars, vars, varCount*sizeof(int));
+	qsort(g->vars, varCount, sizeof(int), compareInts);
+	return g;
+}
+
+void freeGlobal(Global g) {
+	free(g->vars);
+	free(g->entries);
+	free(g->constants);
+	free(g->valueStarts);
+	free(g->values);
+	free(g->residues);
+	free(g->supports);
+	free(g->literalVars);
+	free(g->relations);
+	free(g->bounds);
+	free(g->disjuncts);
+	free(g->disjunctStarts);
+	free(g->disjunctVars);
+	free(g->supported);
+	free(g->supportValues);
+	free(g);
+}
+
+void addGlobalToProblem(Problem p, Global g) {
+	int i;
+	g->index = p->globalCount;
+	p->globals = safeRealloc(p->globals, (p->globalCount+1)*sizeof(Global));
+	p->globals[p->globalCount++] = g;
+	for(i = 0; i < g->varCount; i++) {
+		addIntegerToSet(varByIndex(p, g->vars[i])->globals, g->index);
+	}
+	if(g->result >= 0) {
+		addIntegerToSet(varByIndex(p, g->result)->globals, g->index);
+	}
+}
+
+
+/* recognizes c as Xa <> Xb */
+static int disequality(Constraint c, int *a, int *b) {
+	if(secondExp(c) == NULL || operatorOfConstraint(c) != NEQ) {
+		return 0;
+	}
+	*a = varOfNumExp(firstExp(c));
+	*b = varOfNumExp(secondExp(c));
+	return (*a >= 0 && *b >= 0 && *a != *b);
+}
+
+/* amount of values in both sorted sets */
+static int commonCount(IntegerSet x, IntegerSet y) {
+	int i = 0, j = 0, count = 0;
+	while(i < x->size && j < y->size) {
+		if(x->values[i] < y->values[j]) {
+			i++;
+		} else if(x->values[i] > y->values[j]) {
+			j++;
+		} else {
+			count++;
+			i++;
+			j++;
+		}
+	}
+	return count;
+}
+
+/*
+  Grows a clique from the disequality (v, u): the next member is the
+  candidate adjacent to most other candidates. Returns its size, the
+  members are stored in clique.
+*/
+static int growClique(IntegerSet *adjacent, int v, int u, int *clique) {
+	IntegerSet candidates = intersect(adjacent[v], adjacent[u]), next;
+	int size = 0, i, best, score, bestScore;
+	clique[size++] = v;
+	clique[size++] = u;
+	while(sizeOfSet(candidates) > 0) {
+		best = candidates->values[0];
+		bestScore = -1;
+		for(i = 0; i < sizeOfSet(candidates) && i < CLIQUE_SCORE_LIMIT; i++) {
+			score = commonCount(adjacent[candidates->values[i]], candidates);
+			if(score > bestScore) {
+				best = candidates->values[i];
+				bestScore = score;
+			}
+		}
+		clique[size++] = best;
+		next = intersect(candidates, adjacent[best]);
+		freeIntegerSet(candidates);
+		candidates = next;
+	}
+	freeIntegerSet(candidates);
+	return size;
+}
+
+/* removes the constraints marked in drop and renumbers the others */
+static void dropConstraints(Problem p, int *drop) {
+	int i, count = 0;
+	for(i = 0; i < p->varCount; i++) {
+		Variable var = varByIndex(p, i);
+		freeIntegerSet(var->constraints);
+		var->constraints = emptyIntegerSet();
+	}
+	for(i = 0; i < p->constraintCount; i++) {
+		Constraint c = p->constraints[i];
+		if(drop[i]) {
+			freeConstraint(c);
+			continue;
+		}
+		freeIntegerSet(c->vars);
+		c->vars = emptyIntegerSet();
+		setIndexOfConstraint(c, count);
+		p->constraints[count++] = c;
+	}
+	p->constraintCount = count;
+	linkConstraintsAndVars(p);
+}
+
+/*
+  Finds cliques of at least three variables in the graph of constraints
+  Xa <> Xb and replaces them by alldiff constraints. Every clique is grown
+  greedily from a disequality that no earlier clique covers, cliques may
+  overlap. Returns the amount of cliques.
+*/
+int promoteCliques(Problem p) {
+	IntegerSet *adjacent = safeMalloc(p->varCount*sizeof(IntegerSet));
+	IntegerSet *uncovered = safeMalloc(p->varCount*sizeof(IntegerSet));
+	int *clique = safeMalloc((p->varCount+1)*sizeof(int));
+	int *drop = safeCalloc(p->constraintCount, sizeof(int));
+	int i, j, k, a, b, size, count = 0, dropped = 0;
+
+	for(i = 0; i < p->varCount; i++) {
+		adjacent[i] = emptyIntegerSet();
+	}
+	for(i = 0; i < p->constraintCount; i++) {
+		if(disequality(p->constraints[i], &a, &b)) {
+			addIntegerToSet(adjacent[a], b);
+			addIntegerToSet(adjacent[b], a);
+		}
+	}
+	for(i = 0; i < p->varCount; i++) {
+		uncovered[i] = copyIntegerSet(adjacent[i]);
+	}
+	for(i = 0; i < p->varCount; i++) {
+		while(sizeOfSet(uncovered[i]) > 0) {
+			size = growClique(adjacent, i, uncovered[i]->values[0], clique);
+			if(size < 3) {
+				/* stays a binary constraint */
+				removeIntegerFromSet(uncovered[clique[1]], i);
+				removeIntegerFromSet(uncovered[i], clique[1]);
+				continue;
+			}
+			for(j = 0; j < size; j++) {
+				for(k = 0; k < size; k++) {
+					removeIntegerFromSet(uncovered[clique[j]], clique[k]);
+				}
+			}
+			addGlobalToProblem(p, newGlobal(GLOBAL_ALLDIFF, size, clique));
+			count++;
+		}
+	}
+	/* the disequalities left out of every clique are kept */
+	for(i = 0; i < p->constraintCount; i++) {
+		if(disequality(p->constraints[i], &a, &b) && commonCount(varByIndex(p, a)->globals, varByIndex(p, b)->globals) > 0) {
+			drop[i] = 1;
+			dropped++;
+		}
+	}
+	if(dropped > 0) {
+		dropConstraints(p, drop);
+	}
+
+	for(i = 0; i < p->varCount; i++) {
+		freeIntegerSet(adjacent[i]);
+		freeIntegerSet(uncovered[i]);
+	}
+	free(adjacent);
+	free(uncovered);
+	free(clique);
+	free(drop);
+	return count;
+}
+
+
+/* the function call that exp consists of, NULL if it is something else */
+static FunctionCall callOfNumExp(NumExp exp) {
+	Term t;
+	Factor f;
+	Value v;
+	if(exp->next != NULL) {
+		return NULL;
+	}
+	t = exp->data;
+	if(t->next != NULL) {
+		return NULL;
+	}
+	f = t->data;
+	if(f->type != VALUE) {
+		return NULL;
+	}
+	v = f->data.value;
+	if(v->type != FUNCVAL || v->exponent != NULL) {
+		return NULL;
+	}
+	return v->data.funcCall;
+}
+
+/* whether f is an integer constant, which is stored in val */
+static int constantOfFactor(Factor f, int *val) {
+	int negative = 0;
+	for(; f->type == NUMNEG; f = f->data.factor) {
+		negative = !negative;
+	}
+	if(f->data.value->type != INTVAL || f->data.value->exponent != NULL) {
+		return 0;
+	}
+	*val = (negative ? -f->data.value->data.intval : f->data.value->data.intval);
+	return 1;
+}
+
+/* whether exp is an integer constant, which is stored in val */
+static int constantOfNumExp(NumExp exp, int *val) {
+	Term t;
+	if(exp->next != NULL) {
+		return 0;
+	}
+	t = exp->data;
+	if(t->next != NULL) {
+		return 0;
+	}
+	return constantOfFactor(t->data, val);
+}
+
+/* the max or min call that exp consists of, if all its arguments are variables */
+static FunctionCall extremumCall(NumExp exp) {
+	FunctionCall fc = callOfNumExp(exp);
+	NumExp *args;
+	int i;
+	if(fc == NULL || (nameOfFunctionCall(fc) != MAX && nameOfFunctionCall(fc) != MIN)) {
+		return NULL;
+	}
+	args = argsOfFunctionCall(fc);
+	for(i = 0; i < argCountOfFunctionCall(fc); i++) {
+		if(varOfNumExp(args[i]) < 0) {
+			return NULL;
+		}
+	}
+	return fc;
+}
+
+/* the maximum or minimum constraint that c is, NULL if it is none */
+static Global extremumOfConstraint(Constraint c) {
+	FunctionCall fc;
+	NumExp *args;
+	Global g;
+	int *vars, result, i;
+	if(secondExp(c) == NULL || operatorOfConstraint(c) != IS) {
+		return NULL;
+	}
+	result = varOfNumExp(firstExp(c));
+	fc = extremumCall(secondExp(c));
+	if(result < 0 || fc == NULL) {
+		result = varOfNumExp(secondExp(c));
+		fc = extremumCall(firstExp(c));
+	}
+	if(result < 0 || fc == NULL) {
+		return NULL;
+	}
+	args = argsOfFunctionCall(fc);
+	vars = safeMalloc(argCountOfFunctionCall(fc)*sizeof(int));
+	for(i = 0; i < argCountOfFunctionCall(fc); i++) {
+		vars[i] = varOfNumExp(args[i]);
+		if(vars[i] == result) {
+			free(vars);
+			return NULL;
+		}
+	}
+	g = newGlobal((nameOfFunctionCall(fc) == MAX ? GLOBAL_MAXIMUM : GLOBAL_MINIMUM), argCountOfFunctionCall(fc), vars);
+	g->result = result;
+	free(vars);
+	return g;
+}
+
+/* replaces the constraints that globalOf recognizes by their globals, returns their amount */
+static int promoteConstraints(Problem p, Global (*globalOf)(Constraint)) {
+	int *drop = safeCalloc(p->constraintCount+1, sizeof(int));
+	int i, count = 0;
+	Global g;
+	for(i = 0; i < p->constraintCount; i++) {
+		g = globalOf(p->constraints[i]);
+		if(g != NULL) {
+			addGlobalToProblem(p, g);
+			drop[i] = 1;
+			count++;
+		}
+	}
+	if(count > 0) {
+		dropConstraints(p, drop);
+	}
+	free(drop);
+	return count;
+}
+
+/*
+  Replaces the constraints R = max(X1, .., Xn) and R = min(X1, .., Xn)
+  over variables by maximum and minimum constraints. Returns their amount.
+*/
+int promoteExtrema(Problem p) {
+	return promoteConstraints(p, extremumOfConstraint);
+}
+
+
+/* I if exp is I, I + c, I - c or c + I for a variable I, with the amount added in offset */
+static int selectorOfNumExp(NumExp exp, int *offset) {
+	int c;
+	*offset = 0;
+	if(exp->next == NULL) {
+		return varOfNumExp(exp);
+	}
+	if(varOfNumExp(exp->data) >= 0 && constantOfNumExp(exp->next, &c)) {
+		*offset = (exp->termop == PLUS ? c : -c);
+		return varOfNumExp(exp->data);
+	}
+	if(exp->termop == PLUS && constantOfNumExp(exp->data, &c) && varOfNumExp(exp->next) >= 0) {
+		*offset = c;
+		return varOfNumExp(exp->next);
+	}
+	return -1;
+}
+
+/*
+  The element constraint that c is, NULL if it is none: R = [A0, .., An-1][I]
+  with R a variable or a constant, I as selectorOfNumExp recognizes it and
+  every Ai a variable or a constant.
+*/
+static Global elementOfConstraint(Constraint c) {
+	FunctionCall fc;
+	NumExp other, *args;
+	Global g;
+	int *vars, *entries, *constants;
+	int result, value = 0, selector, offset, count, varCount = 0, i;
+	if(secondExp(c) == NULL || operatorOfConstraint(c) != IS) {
+		return NULL;
+	}
+	fc = callOfNumExp(firstExp(c));
+	other = secondExp(c);
+	if(fc == NULL || nameOfFunctionCall(fc) != ELEMENT) {
+		fc = callOfNumExp(secondExp(c));
+		other = firstExp(c);
+	}
+	if(fc == NULL || nameOfFunctionCall(fc) != ELEMENT) {
+		return NULL;
+	}
+	result = varOfNumExp(other);
+	args = argsOfFunctionCall(fc);
+	selector = selectorOfNumExp(args[0], &offset);
+	if((result < 0 && !constantOfNumExp(other, &value)) || selector < 0) {
+		return NULL;
+	}
+	count = argCountOfFunctionCall(fc)-1;
+	vars = safeMalloc((count+1)*sizeof(int));
+	entries = safeMalloc(count*sizeof(int));
+	constants = safeCalloc(count, sizeof(int));
+	vars[varCount++] = selector;
+	for(i = 0; i < count; i++) {
+		entries[i] = varOfNumExp(args[i+1]);
+		if(entries[i] >= 0) {
+			vars[varCount++] = entries[i];
+		} else if(!constantOfNumExp(args[i+1], &constants[i])) {
+			free(vars);
+			free(entries);
+			free(constants);
+			return NULL;
+		}
+	}
+	g = newGlobal(GLOBAL_ELEMENT, varCount, vars);
+	g->result = result;
+	g->value = value;
+	g->selector = selector;
+	g->offset = offset;
+	g->entryCount = count;
+	g->entries = entries;
+	g->constants = constants;
+	free(vars);
+	return g;
+}
+
+/* replaces the constraints R = [A0, .., An-1][I] by element constraints, returns their amount */
+int promoteElements(Problem p) {
+	return promoteConstraints(p, elementOfConstraint);
+}
+
+
+/* whether c is X = v or v = X for a variable X and a constant v */
+static int assignmentOfConstraint(Constraint c, int *var, int *value) {
+	if(secondExp(c) == NULL || operatorOfConstraint(c) != IS) {
+		return 0;
+	}
+	*var = varOfNumExp(firstExp(c));
+	if(*var >= 0) {
+		return constantOfNumExp(secondExp(c), value);
+	}
+	*var = varOfNumExp(secondExp(c));
+	return (*var >= 0 && constantOfNumExp(firstExp(c), value));
+}
+
+/* the list of the all call that c consists of, NULL if it is something else */
+static ConstraintList conjunctionOfConstraint(Constraint c) {
+	FunctionCall fc;
+	if(secondExp(c) != NULL || (fc = callOfNumExp(firstExp(c))) == NULL || nameOfFunctionCall(fc) != ALL) {
+		return NULL;
+	}
+	return ((ConstraintList *) argsOfFunctionCall(fc))[0];
+}
+
+/*
+  Stores the values of the tuple cl in row, in the order of vars. Returns 0
+  if cl does not assign every variable of vars exactly once.
+*/
+static int tupleOfConjunction(ConstraintList cl, int *vars, int varCount, int *row, int *assigned) {
+	int count = 0, var, value, i;
+	memset(assigned, 0, varCount*sizeof(int));
+	for(; cl != NULL; cl = cl->next) {
+		if(!assignmentOfConstraint(cl->constraint, &var, &value)) {
+			return 0;
+		}
+		for(i = 0; i < varCount && vars[i] != var; i++);
+		if(i == varCount || assigned[i]) {
+			return 0;
+		}
+		assigned[i] = 1;
+		row[i] = value;
+		count++;
+	}
+	return (count == varCount);
+}
+
+/* the bitsets of table g over the tuples of columns, columns[i*tupleCount+t] the value of vars[i] in tuple t */
+static void buildSupports(Global g, int *columns) {
+	int words = (g->tupleCount + WORD_BITS - 1) / WORD_BITS;
+	int *sorted = safeMalloc(g->tupleCount*sizeof(int));
+	int valueCount = 0, i, t, k;
+	g->valueStarts = safeMalloc((g->varCount+1)*sizeof(int));
+	g->values = safeMalloc(g->varCount*g->tupleCount*sizeof(int));
+	for(i = 0; i < g->varCount; i++) {
+		g->valueStarts[i] = valueCount;
+		memcpy(sorted, &columns[i*g->tupleCount], g->tupleCount*sizeof(int));
+		qsort(sorted, g->tupleCount, sizeof(int), compareInts);
+		for(t = 0; t < g->tupleCount; t++) {
+			if(t == 0 || sorted[t] != sorted[t-1]) {
+				g->values[valueCount++] = sorted[t];
+			}
+		}
+	}
+	g->valueStarts[g->varCount] = valueCount;
+	g->residues = safeCalloc(valueCount, sizeof(int));
+	g->supports = safeCalloc(valueCount*words, sizeof(unsigned long long));
+	for(i = 0; i < g->varCount; i++) {
+		int *values = &g->values[g->valueStarts[i]];
+		int count = g->valueStarts[i+1] - g->valueStarts[i];
+		for(t = 0; t < g->tupleCount; t++) {
+			k = (int *) bsearch(&columns[i*g->tupleCount+t], values, count, sizeof(int), compareInts) - values;
+			g->supports[(g->valueStarts[i]+k)*words + t/WORD_BITS] |= 1ULL << (t % WORD_BITS);
+		}
+	}
+	free(sorted);
+}
+
+/*
+  The table constraint that c is, NULL if it is none: any(all(X1 = a1, ..,
+  Xn = an), ..), where every all assigns a constant to each of the same
+  variables X1, .., Xn once.
+*/
+static Global tableOfConstraint(Constraint c) {
+	FunctionCall fc;
+	ConstraintList tuples, first, cl;
+	Global g = NULL;
+	int *vars, *row, *assigned, *columns;
+	int varCount = 0, tupleCount = 0, value, ok = 1, i, t;
+	if(secondExp(c) != NULL || (fc = callOfNumExp(firstExp(c))) == NULL || nameOfFunctionCall(fc) != ANY) {
+		return NULL;
+	}
+	tuples = ((ConstraintList *) argsOfFunctionCall(fc))[0];
+	if((first = conjunctionOfConstraint(tuples->constraint)) == NULL) {
+		return NULL;
+	}
+	for(cl = first; cl != NULL; cl = cl->next) {
+		varCount++;
+	}
+	for(cl = tuples; cl != NULL; cl = cl->next) {
+		tupleCount++;
+	}
+	vars = safeMalloc(varCount*sizeof(int));
+	row = safeMalloc(varCount*sizeof(int));
+	assigned = safeMalloc(varCount*sizeof(int));
+	columns = safeMalloc(varCount*tupleCount*sizeof(int));
+	for(i = 0, cl = first; ok && cl != NULL; i++, cl = cl->next) {
+		ok = assignmentOfConstraint(cl->constraint, &vars[i], &value);
+	}
+	if(ok) {
+		qsort(vars, varCount, sizeof(int), compareInts);
+		for(i = 1; ok && i < varCount; i++) {
+			ok = (vars[i] != vars[i-1]);
+		}
+	}
+	for(t = 0, cl = tuples; ok && cl != NULL; t++, cl = cl->next) {
+		first = conjunctionOfConstraint(cl->constraint);
+		ok = (first != NULL && tupleOfConjunction(first, vars, varCount, row, assigned));
+		for(i = 0; ok && i < varCount; i++) {
+			columns[i*tupleCount+t] = row[i];
+		}
+	}
+	if(ok) {
+		g = newGlobal(GLOBAL_TABLE, varCount, vars);
+		g->tupleCount = tupleCount;
+		buildSupports(g, columns);
+	}
+	free(vars);
+	free(row);
+	free(assigned);
+	free(columns);
+	return g;
+}
+
+/* replaces the constraints any(all(X1 = a1, .., Xn = an), ..) by table constraints, returns their amount */
+int promoteTables(Problem p) {
+	return promoteConstraints(p, tableOfConstraint);
+}
+
+
+/*
+  Adds X to vars for every term any(X = v) of the sum exp, which may be in
+  parentheses, with the same constant v in every term, stored in value.
+  Returns 0 if exp is something else.
+*/
+static int indicatorsOfNumExp(NumExp exp, int **vars, int *count, int *value) {
+	FunctionCall fc;
+	ConstraintList cl;
+	int var, v;
+	exp = unwrapExp(exp);
+	if(exp->next != NULL) {
+		return (exp->termop == PLUS && indicatorsOfNumExp(exp->data, vars, count, value)
+		        && indicatorsOfNumExp(exp->next, vars, count, value));
+	}
+	if((fc = callOfNumExp(exp)) == NULL || nameOfFunctionCall(fc) != ANY) {
+		return 0;
+	}
+	cl = ((ConstraintList *) argsOfFunctionCall(fc))[0];
+	if(cl == NULL || cl->next != NULL || !assignmentOfConstraint(cl->constraint, &var, &v)
+	   || (*count > 0 && v != *value)) {
+		return 0;
+	}
+	*value = v;
+	*vars = safeRealloc(*vars, (*count+1)*sizeof(int));
+	(*vars)[(*count)++] = var;
+	return 1;
+}
+
+/*
+  The count constraint that c is, NULL if it is none: S rel R or R rel S
+  with S a sum any(X1 = v) + .. + any(Xn = v) and R a constant or a
+  variable other than the Xi.
+*/
+static Global countOfConstraint(Constraint c) {
+	Global g = NULL;
+	NumExp sum, other;
+	int *vars = NULL, count, counted = 0, result, value = 0, side, i;
+	if(secondExp(c) == NULL) {
+		return NULL;
+	}
+	for(side = 0; g == NULL && side < 2; side++) {
+		sum = (side == 0 ? firstExp(c) : secondExp(c));
+		other = unwrapExp(side == 0 ? secondExp(c) : firstExp(c));
+		count = 0;
+		if(!indicatorsOfNumExp(sum, &vars, &count, &counted)) {
+			continue;
+		}
+		result = varOfNumExp(other);
+		if(result < 0 && !constantOfNumExp(other, &value)) {
+			continue;
+		}
+		for(i = 0; i < count && vars[i] != result; i++);
+		if(i < count) {
+			continue;
+		}
+		g = newGlobal(GLOBAL_COUNT, count, vars);
+		g->result = result;
+		g->value = value;
+		g->counted = counted;
+		g->relation = (side == 0 ? operatorOfConstraint(c) : switchOperator(operatorOfConstraint(c)));
+	}
+	free(vars);
+	return g;
+}
+
+/* replaces the constraints any(X1 = v) + .. + any(Xn = v) rel R by count constraints, returns their amount */
+int promoteCounts(Problem p) {
+	return promoteConstraints(p, countOfConstraint);
+}
+
+
+/* whether c is X rel v, v rel X or X on its own (X <> 0) for a variable X and a constant v */
+static int literalOfConstraint(Constraint c, int *var, RelOperator *rel, int *bound) {
+	if(secondExp(c) == NULL) {
+		*var = varOfNumExp(firstExp(c));
+		*rel = NEQ;
+		*bound = 0;
+		return (*var >= 0);
+	}
+	*var = varOfNumExp(firstExp(c));
+	*rel = operatorOfConstraint(c);
+	if(*var >= 0) {
+		return constantOfNumExp(secondExp(c), bound);
+	}
+	*var = varOfNumExp(secondExp(c));
+	*rel = switchOperator(*rel);
+	return (*var >= 0 && constantOfNumExp(firstExp(c), bound));
+}
+
+/*
+  The clause that c is, NULL if it is none: any(L1, .., Ln) with n > 1 and
+  every Li a literal as literalOfConstraint recognizes it over a different
+  variable.
+*/
+static Global clauseOfConstraint(Constraint c) {
+	FunctionCall fc;
+	ConstraintList cl;
+	Global g = NULL;
+	int *vars, *sorted, *bounds;
+	RelOperator *relations;
+	int count = 0, ok = 1, i;
+	if(secondExp(c) != NULL || (fc = callOfNumExp(firstExp(c))) == NULL || nameOfFunctionCall(fc) != ANY) {
+		return NULL;
+	}
+	for(cl = ((ConstraintList *) argsOfFunctionCall(fc))[0]; cl != NULL; cl = cl->next) {
+		count++;
+	}
+	if(count < 2) {
+		return NULL;
+	}
+	vars = safeMalloc(count*sizeof(int));
+	sorted = safeMalloc(count*sizeof(int));
+	bounds = safeMalloc(count*sizeof(int));
+	relations = safeMalloc(count*sizeof(RelOperator));
+	cl = ((ConstraintList *) argsOfFunctionCall(fc))[0];
+	for(i = 0; ok && i < count; i++, cl = cl->next) {
+		ok = literalOfConstraint(cl->constraint, &vars[i], &relations[i], &bounds[i]);
+		sorted[i] = vars[i];
+	}
+	if(ok) {
+		qsort(sorted, count, sizeof(int), compareInts);
+		for(i = 1; ok && i < count; i++) {
+			ok = (sorted[i] != sorted[i-1]);
+		}
+	}
+	if(ok) {
+		g = newGlobal(GLOBAL_CLAUSE, count, vars);
+		g->literalCount = count;
+		g->literalVars = vars;
+		g->relations = relations;
+		g->bounds = bounds;
+	} else {
+		free(vars);
+		free(relations);
+		free(bounds);
+	}
+	free(sorted);
+	return g;
+}
+
+/* replaces the constraints any(L1, .., Ln) over literals by clauses, returns their amount */
+int promoteClauses(Problem p) {
+	return promoteConstraints(p, clauseOfConstraint);
+}
+
+
+/*
+  Adds the variables of an expression to vars. Returns 0, leaving vars
+  incomplete, if evaluating it might fail: a division or modulo by anything
+  but a constant other than zero, or a power with an exponent that is not a
+  constant of at least zero.
+*/
+static int scanNumExp(NumExp exp, IntegerSet vars);
+
+static int scanConstraint(Constraint c, IntegerSet vars) {
+	return scanNumExp(firstExp(c), vars) && (secondExp(c) == NULL || scanNumExp(secondExp(c), vars));
+}
+
+static int scanFactor(Factor f, IntegerSet vars) {
+	Value v;
+	ConstraintList cl;
+	NumExp *args;
+	int safe = 1, c, i;
+	if(f->type == NUMNEG) {
+		return scanFactor(f->data.factor, vars);
+	}
+	v = f->data.value;
+	if(v->exponent != NULL && (!constantOfFactor(v->exponent, &c) || c < 0)) {
+		return 0;
+	}
+	if(v->type == VARVAL) {
+		addIntegerToSet(vars, v->data.varIndex);
+	} else if(v->type == NUMEXP) {
+		safe = scanNumExp(v->data.numexp, vars);
+	} else if(v->type == FUNCVAL && (v->data.funcCall->name == ANY || v->data.funcCall->name == ALL)) {
+		for(cl = ((ConstraintList *) v->data.funcCall->argv)[0]; safe && cl != NULL; cl = cl->next) {
+			safe = scanConstraint(cl->constraint, vars);
+		}
+	} else if(v->type == FUNCVAL) {
+		args = v->data.funcCall->argv;
+		for(i = 0; safe && i < v->data.funcCall->argc; i++) {
+			safe = scanNumExp(args[i], vars);
+		}
+	}
+	return safe;
+}
+
+static int scanTerm(Term t, IntegerSet vars) {
+	int c;
+	if(t->next == NULL) {
+		return scanFactor(t->data, vars);
+	}
+	if(t->factorop != MUL && (t->next->next != NULL || !constantOfFactor(t->next->data, &c) || c == 0)) {
+		return 0;
+	}
+	return scanTerm(t->data, vars) && scanTerm(t->next, vars);
+}
+
+static int scanNumExp(NumExp exp, IntegerSet vars) {
+	if(exp->next == NULL) {
+		return scanTerm(exp->data, vars);
+	}
+	return scanNumExp(exp->data, vars) && scanNumExp(exp->next, vars);
+}
+
+/*
+  The disjunction that c is, NULL if it is none: any(C1, .., Cn) with n > 1
+  over at least three variables, where every Ci can be evaluated on its own.
+  The disjuncts are those of c.
+*/
+static Global disjunctionOfConstraint(Constraint c) {
+	FunctionCall fc;
+	ConstraintList cl;
+	IntegerSet vars, all;
+	Global g = NULL;
+	int count = 0, safe = 1, k;
+	if(secondExp(c) != NULL || (fc = callOfNumExp(firstExp(c))) == NULL || nameOfFunctionCall(fc) != ANY) {
+		return NULL;
+	}
+	for(cl = ((ConstraintList *) argsOfFunctionCall(fc))[0]; cl != NULL; cl = cl->next) {
+		count++;
+	}
+	if(count < 2) {
+		return NULL;
+	}
+	all = emptyIntegerSet();
+	for(cl = ((ConstraintList *) argsOfFunctionCall(fc))[0]; safe && cl != NULL; cl = cl->next) {
+		safe = scanConstraint(cl->constraint, all);
+	}
+	if(safe && sizeOfSet(all) > 2) {
+		g = newGlobal(GLOBAL_DISJUNCTION, sizeOfSet(all), valuesOfSet(all));
+		g->disjunctCount = count;
+		g->disjuncts = safeMalloc(count*sizeof(Constraint));
+		g->disjunctStarts = safeMalloc((count+1)*sizeof(int));
+		g->disjunctVars = NULL;
+		g->disjunctStarts[0] = 0;
+		cl = ((ConstraintList *) argsOfFunctionCall(fc))[0];
+		for(k = 0; k < count; k++, cl = cl->next) {
+			vars = emptyIntegerSet();
+			scanConstraint(cl->constraint, vars);
+			g->disjuncts[k] = cl->constraint;
+			g->disjunctStarts[k+1] = g->disjunctStarts[k] + sizeOfSet(vars);
+			g->disjunctVars = safeRealloc(g->disjunctVars, (g->disjunctStarts[k+1]+1)*sizeof(int));
+			memcpy(&g->disjunctVars[g->disjunctStarts[k]], valuesOfSet(vars), sizeOfSet(vars)*sizeof(int));
+			freeIntegerSet(vars);
+		}
+		g->supported = safeCalloc(count, sizeof(int));
+		g->supportValues = safeMalloc((g->disjunctStarts[count]+1)*sizeof(int));
+	}
+	freeIntegerSet(all);
+	return g;
+}
+
+/*
+  Adds a disjunction for the other constraints any(C1, .., Cn) over three
+  variables or more, returns their amount. The constraints stay: they are
+  checked and forward checked as before, the disjunctions only propagate.
+*/
+int addDisjunctions(Problem p) {
+	int i, count = 0;
+	Global g;
+	for(i = 0; i < p->constraintCount; i++) {
+		g = disjunctionOfConstraint(p->constraints[i]);
+		if(g != NULL) {
+			addGlobalToProblem(p, g);
+			count++;
+		}
+	}
+	return count;
+}
+
+
+/* checks a maximum or minimum constraint once all its variables are assigned */
+static int checkExtremum(Global g, Problem p) {
+	int value, extremum = 0, i;
+	if(!isAssigned(varByIndex(p, g->result), p)) {
+		return 1;
+	}
+	for(i = 0; i < g->varCount; i++) {
+		Variable var = varByIndex(p, g->vars[i]);
+		if(!isAssigned(var, p)) {
+			return 1;
+		}
+		value = domainMinimumOfVar(var);
+		if(i == 0 || (g->kind == GLOBAL_MAXIMUM ? value > extremum : value < extremum)) {
+			extremum = value;
+		}
+	}
+	return (domainMinimumOfVar(varByIndex(p, g->result)) == extremum);
+}
+
+/* checks an element constraint once its index, its result and the entry selected are assigned */
+static int checkElement(Global g, Problem p) {
+	Variable selector = varByIndex(p, g->selector);
+	int position, entry;
+	if(!isAssigned(selector, p) || (g->result >= 0 && !isAssigned(varByIndex(p, g->result), p))) {
+		return 1;
+	}
+	position = domainMinimumOfVar(selector) + g->offset;
+	if(position < 0 || position >= g->entryCount) {
+		return 0;
+	}
+	if(g->entries[position] < 0) {
+		entry = g->constants[position];
+	} else if(isAssigned(varByIndex(p, g->entries[position]), p)) {
+		entry = domainMinimumOfVar(varByIndex(p, g->entries[position]));
+	} else {
+		return 1;
+	}
+	return (entry == (g->result >= 0 ? domainMinimumOfVar(varByIndex(p, g->result)) : g->value));
+}
+
+/* the position in values of the value of vars[i] in table g, -1 if no tuple has it */
+static int tableValueIndex(Global g, int i, int value) {
+	int *values = &g->values[g->valueStarts[i]];
+	int *found = bsearch(&value, values, g->valueStarts[i+1] - g->valueStarts[i], sizeof(int), compareInts);
+	return (found == NULL ? -1 : g->valueStarts[i] + (found - values));
+}
+
+/* checks a table constraint: some tuple has the values of all its assigned variables */
+static int checkTable(Global g, Problem p) {
+	int words = (g->tupleCount + WORD_BITS - 1) / WORD_BITS;
+	unsigned long long *tuples = NULL;
+	int ok = 1, k, i, w;
+	for(i = 0; ok && i < g->varCount; i++) {
+		Variable var = varByIndex(p, g->vars[i]);
+		if(!isAssigned(var, p)) {
+			continue;
+		}
+		k = tableValueIndex(g, i, domainMinimumOfVar(var));
+		if(k < 0) {
+			ok = 0;
+		} else if(tuples == NULL) {
+			tuples = safeMalloc(words*sizeof(unsigned long long));
+			memcpy(tuples, &g->supports[k*words], words*sizeof(unsigned long long));
+		} else {
+			for(w = 0, ok = 0; w < words; w++) {
+				tuples[w] &= g->supports[k*words+w];
+				ok |= (tuples[w] != 0);
+			}
+		}
+	}
+	free(tuples);
+	return ok;
+}
+
+/* 1 if literal k of clause g holds for every value left, -1 if for none, 0 otherwise */
+static int literalState(Global g, int k, Problem p) {
+	Variable var = varByIndex(p, g->literalVars[k]);
+	int bound = g->bounds[k], low, high;
+	if(domainSizeOfVar(var) == 0) {
+		return -1;
+	}
+	low = domainMinimumOfVar(var);
+	high = domainMaximumOfVar(var);
+	switch(g->relations[k]) {
+		case IS:
+			return (!valueInSet(domainOfVar(var), bound) ? -1 : (low == high ? 1 : 0));
+		case NEQ:
+			return (!valueInSet(domainOfVar(var), bound) ? 1 : (low == high ? -1 : 0));
+		case SMALLER:
+			return (high < bound ? 1 : (low >= bound ? -1 : 0));
+		case GREATER:
+			return (low > bound ? 1 : (high <= bound ? -1 : 0));
+		case LEQ:
+			return (high <= bound ? 1 : (low > bound ? -1 : 0));
+		default:
+			return (low >= bound ? 1 : (high < bound ? -1 : 0));
+	}
+}
+
+/* checks a clause: one of its watched literals, or else any literal, is not false */
+static int checkClause(Global g, Problem p) {
+	int k;
+	if(literalState(g, g->watched[0], p) >= 0 || literalState(g, g->watched[1], p) >= 0) {
+		return 1;
+	}
+	for(k = 0; k < g->literalCount; k++) {
+		if(literalState(g, k, p) >= 0) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* the number of variables of count g that have only its value left in low, that still have it in high */
+static void countBounds(Global g, Problem p, int *low, int *high) {
+	int i;
+	*low = *high = 0;
+	for(i = 0; i < g->varCount; i++) {
+		Variable var = varByIndex(p, g->vars[i]);
+		if(valueInSet(domainOfVar(var), g->counted)) {
+			(*high)++;
+			*low += (domainSizeOfVar(var) == 1);
+		}
+	}
+}
+
+/* whether some count in [low, high] is in relation rel with some R in [rlow, rhigh] */
+static int countPossible(RelOperator rel, int low, int high, int rlow, int rhigh) {
+	switch(rel) {
+		case IS:
+			return (low <= rhigh && high >= rlow);
+		case NEQ:
+			return (low != high || rlow != rhigh || low != rlow);
+		case SMALLER:
+			return (low < rhigh);
+		case GREATER:
+			return (high > rlow);
+		case LEQ:
+			return (low <= rhigh);
+		default:
+			return (high >= rlow);
+	}
+}
+
+/* checks a count constraint against the values left for its variables */
+static int checkCount(Global g, Problem p) {
+	int low, high;
+	countBounds(g, p, &low, &high);
+	if(g->result < 0) {
+		return countPossible(g->relation, low, high, g->value, g->value);
+	}
+	return countPossible(g->relation, low, high, domainMinimumOfVar(varByIndex(p, g->result)),
+	                     domainMaximumOfVar(varByIndex(p, g->result)));
+}
+
+/* checks the value of the assigned variable var against the other assigned variables */
+static int checkAlldiff(Global g, Variable var, Problem p) {
+	int value = domainMinimumOfVar(var), i;
+	for(i = 0; i < g->varCount; i++) {
+		Variable other = varByIndex(p, g->vars[i]);
+		if(other != var && isAssigned(other, p) && domainMinimumOfVar(other) == value) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* checks the globals of var after it has been assigned */
+int checkGlobals(Variable var, Problem p) {
+	int *globals = valuesOfSet(var->globals);
+	int i;
+	for(i = 0; i < sizeOfSet(var->globals); i++) {
+		Global g = p->globals[globals[i]];
+		int ok;
+		switch(g->kind) {
+			case GLOBAL_ALLDIFF:
+				ok = checkAlldiff(g, var, p);
+				break;
+			case GLOBAL_ELEMENT:
+				ok = checkElement(g, p);
+				break;
+			case GLOBAL_TABLE:
+				ok = checkTable(g, p);
+				break;
+			case GLOBAL_CLAUSE:
+				ok = checkClause(g, p);
+				break;
+			case GLOBAL_DISJUNCTION:
+				/* its constraint is checked */
+				ok = 1;
+				break;
+			case GLOBAL_COUNT:
+				ok = checkCount(g, p);
+				break;
+			default:
+				ok = checkExtremum(g, p);
+		}
+		if(!ok) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+  Pigeonhole test: the unassigned variables of an alldiff need at least as
+  many different values as there are variables. If assigned is set, the
+  assigned variables are skipped, otherwise all variables are counted.
+*/
+static int enoughValues(Global g, Problem p, int assigned) {
+	int *values, count = 0, unassigned = 0, distinct = 0, i, j;
+	IntegerSet domain;
+	for(i = 0; i < g->varCount; i++) {
+		Variable var = varByIndex(p, g->vars[i]);
+		if(!assigned || !isAssigned(var, p)) {
+			unassigned++;
+			count += domainSizeOfVar(var);
+		}
+	}
+	values = safeMalloc((count+1)*sizeof(int));
+	count = 0;
+	for(i = 0; i < g->varCount; i++) {
+		Variable var = varByIndex(p, g->vars[i]);
+		if(!assigned || !isAssigned(var, p)) {
+			domain = domainOfVar(var);
+			for(j = 0; j < sizeOfSet(domain); j++) {
+				values[count++] = domain->values[j];
+			}
+		}
+	}
+	qsort(values, count, sizeof(int), compareInts);
+	for(i = 0; i < count && distinct < unassigned; i++) {
+		if(i == 0 || values[i] != values[i-1]) {
+			distinct++;
+		}
+	}
+	free(values);
+	return (distinct >= unassigned);
+}
+
+/*
+  Replaces the domain of var by restricted, a proper subset. Without a
+  backup, before the search, the domain is reduced for good. With an arc
+  queue the arcs of a reduced variable are added and it is pushed on
+  pending. Returns 0 if no value is left.
+*/
+static int replaceDomain(Solver s, Variable var, IntegerSet restricted, Problem p,
+                         Backup backup, Queue arcQueue, Stack pending) {
+	IntegerSet domain = domainOfVar(var);
+	if(backup != NULL && isAssigned(var, p)) {
+		freeIntegerSet(restricted);
+		return 0;
+	}
+	s->stats.pruned += sizeOfSet(domain) - sizeOfSet(restricted);
+	setDomainOfVar(var, restricted);
+	if(backup == NULL) {
+		freeIntegerSet(domain);
+	} else {
+		addBackup(var->index, domain, *(sequencePosition(var)), backup);
+		resortVarSeq(p->varSequence, sequencePosition(var));
+	}
+	if(sizeOfSet(restricted) == 0) {
+		return 0;
+	}
+	if(arcQueue != NULL) {
+		addVariableArcs(s, var, arcQueue, p);
+		push(pending, var);
+	}
+	return 1;
+}
+
+/* removes the values outside [low, high] from the domain of var, see replaceDomain */
+static int restrictBounds(Solver s, Variable var, int low, int high, Problem p,
+                          Backup backup, Queue arcQueue, Stack pending) {
+	IntegerSet domain = domainOfVar(var), restricted;
+	int i;
+	if(sizeOfSet(domain) == 0) {
+		return 0;
+	}
+	if(minimumOfSet(domain) >= low && maximumOfSet(domain) <= high) {
+		return 1;
+	}
+	restricted = emptyIntegerSet();
+	for(i = 0; i < sizeOfSet(domain); i++) {
+		if(domain->values[i] >= low && domain->values[i] <= high) {
+			addIntegerToSet(restricted, domain->values[i]);
+		}
+	}
+	return replaceDomain(s, var, restricted, p, backup, arcQueue, pending);
+}
+
+/* removes the values that are not in allowed from the domain of var, see replaceDomain */
+static int restrictDomain(Solver s, Variable var, IntegerSet allowed, Problem p,
+                          Backup backup, Queue arcQueue, Stack pending) {
+	IntegerSet domain = domainOfVar(var), restricted;
+	int i;
+	if(sizeOfSet(domain) == 0) {
+		return 0;
+	}
+	restricted = emptyIntegerSet();
+	for(i = 0; i < sizeOfSet(domain); i++) {
+		if(valueInSet(allowed, domain->values[i])) {
+			addIntegerToSet(restricted, domain->values[i]);
+		}
+	}
+	if(sizeOfSet(restricted) == sizeOfSet(domain)) {
+		freeIntegerSet(restricted);
+		return 1;
+	}
+	return replaceDomain(s, var, restricted, p, backup, arcQueue, pending);
+}
+
+/*
+  Bounds consistency of R = max(X1, .., Xn): R lies between the largest
+  minimum and the largest maximum of the Xi, no Xi exceeds the maximum of R,
+  and if a single Xi can reach the minimum of R it has to. Minimum is the
+  mirror image. Repeated until nothing changes, returns 0 on a wipeout.
+*/
+static int propagateExtremum(Solver s, Global g, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	Variable result = varByIndex(p, g->result), var, support;
+	int maximum = (g->kind == GLOBAL_MAXIMUM);
+	int low = 0, high = 0, supports, i;
+	long pruned = -1;
+	s->stats.revisions++;
+	while(pruned != s->stats.pruned) {
+		pruned = s->stats.pruned;
+		for(i = 0; i < g->varCount; i++) {
+			var = varByIndex(p, g->vars[i]);
+			if(i == 0 || (maximum ? domainMinimumOfVar(var) > low : domainMinimumOfVar(var) < low)) {
+				low = domainMinimumOfVar(var);
+			}
+			if(i == 0 || (maximum ? domainMaximumOfVar(var) > high : domainMaximumOfVar(var) < high)) {
+				high = domainMaximumOfVar(var);
+			}
+		}
+		if(!restrictBounds(s, result, low, high, p, backup, arcQueue, pending)) {
+			return 0;
+		}
+		low = domainMinimumOfVar(result);
+		high = domainMaximumOfVar(result);
+		supports = 0;
+		support = NULL;
+		for(i = 0; i < g->varCount; i++) {
+			var = varByIndex(p, g->vars[i]);
+			if(!restrictBounds(s, var, (maximum ? INT_MIN : low), (maximum ? high : INT_MAX), p, backup, arcQueue, pending)) {
+				return 0;
+			}
+			if(maximum ? domainMaximumOfVar(var) >= low : domainMinimumOfVar(var) <= high) {
+				supports++;
+				support = var;
+			}
+		}
+		if(supports == 1 && !restrictBounds(s, support, (maximum ? low : INT_MIN), (maximum ? INT_MAX : high),
+		                                    p, backup, arcQueue, pending)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+  Domain consistency of R = [A0, .., An-1][I + c]: I keeps the values that
+  select an entry sharing a value with R, R keeps the values of those
+  entries, and once I has a single value the entry selected is restricted to
+  the values of R. Repeated until nothing changes, returns 0 on a wipeout.
+*/
+static int propagateElement(Solver s, Global g, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	Variable selector = varByIndex(p, g->selector);
+	Variable result = (g->result >= 0 ? varByIndex(p, g->result) : NULL);
+	IntegerSet results = emptyIntegerSet(), indices, values, domain, entry;
+	int ok = 1, position, supported, i, j;
+	long pruned = -1;
+	s->stats.revisions++;
+	addIntegerToSet(results, g->value);
+	while(ok && pruned != s->stats.pruned) {
+		pruned = s->stats.pruned;
+		indices = emptyIntegerSet();
+		values = emptyIntegerSet();
+		domain = domainOfVar(selector);
+		for(i = 0; i < sizeOfSet(domain); i++) {
+			position = domain->values[i] + g->offset;
+			if(position < 0 || position >= g->entryCount) {
+				continue;
+			}
+			if(g->entries[position] < 0) {
+				supported = (result != NULL ? valueInSet(domainOfVar(result), g->constants[position]) :
+				             g->constants[position] == g->value);
+				if(supported) {
+					addIntegerToSet(values, g->constants[position]);
+				}
+			} else {
+				entry = domainOfVar(varByIndex(p, g->entries[position]));
+				supported = 0;
+				for(j = 0; j < sizeOfSet(entry); j++) {
+					if(valueInSet((result != NULL ? domainOfVar(result) : results), entry->values[j])) {
+						addIntegerToSet(values, entry->values[j]);
+						supported = 1;
+					}
+				}
+			}
+			if(supported) {
+				addIntegerToSet(indices, domain->values[i]);
+			}
+		}
+		ok = restrictDomain(s, selector, indices, p, backup, arcQueue, pending) &&
+		     (result == NULL || restrictDomain(s, result, values, p, backup, arcQueue, pending));
+		position = (ok && domainSizeOfVar(selector) == 1 ? domainMinimumOfVar(selector) + g->offset : -1);
+		if(position >= 0 && g->entries[position] >= 0) {
+			ok = restrictDomain(s, varByIndex(p, g->entries[position]), (result != NULL ? domainOfVar(result) : results),
+			                    p, backup, arcQueue, pending);
+		}
+		freeIntegerSet(indices);
+		freeIntegerSet(values);
+	}
+	freeIntegerSet(results);
+	return ok;
+}
+
+/* whether value k of table g has a tuple in the bitset valid, its residue is tried first */
+static int tableSupported(Global g, int k, unsigned long long *valid, int words) {
+	unsigned long long *support = &g->supports[k*words];
+	int w;
+	if(support[g->residues[k]] & valid[g->residues[k]]) {
+		return 1;
+	}
+	for(w = 0; w < words; w++) {
+		if(support[w] & valid[w]) {
+			g->residues[k] = w;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+  Generalized arc consistency of a table with Compact-Table. The valid
+  tuples are found word by word from the bitsets of the values left; since
+  only domains are restored on backtracking they are rebuilt on every call
+  instead of being kept between calls. Then every value without a valid
+  tuple is removed. Returns 0 on a wipeout.
+*/
+static int propagateTable(Solver s, Global g, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	int words = (g->tupleCount + WORD_BITS - 1) / WORD_BITS;
+	unsigned long long *valid = safeMalloc(words*sizeof(unsigned long long));
+	unsigned long long *mask = safeMalloc(words*sizeof(unsigned long long));
+	IntegerSet domain, restricted;
+	int ok = 0, count, i, j, k, w;
+	s->stats.revisions++;
+	memset(valid, 0xff, words*sizeof(unsigned long long));
+	if(g->tupleCount % WORD_BITS != 0) {
+		valid[words-1] = (1ULL << (g->tupleCount % WORD_BITS)) - 1;
+	}
+	for(i = 0; i < g->varCount; i++) {
+		domain = domainOfVar(varByIndex(p, g->vars[i]));
+		memset(mask, 0, words*sizeof(unsigned long long));
+		count = 0;
+		for(j = 0; j < sizeOfSet(domain); j++) {
+			k = tableValueIndex(g, i, domain->values[j]);
+			if(k >= 0) {
+				count++;
+				for(w = 0; w < words; w++) {
+					mask[w] |= g->supports[k*words+w];
+				}
+			}
+		}
+		/* with all its values left a variable does not invalidate tuples */
+		if(count < g->valueStarts[i+1] - g->valueStarts[i]) {
+			for(w = 0; w < words; w++) {
+				valid[w] &= mask[w];
+			}
+		}
+	}
+	for(w = 0; w < words; w++) {
+		ok |= (valid[w] != 0);
+	}
+	for(i = 0; ok && i < g->varCount; i++) {
+		Variable var = varByIndex(p, g->vars[i]);
+		domain = domainOfVar(var);
+		restricted = emptyIntegerSet();
+		for(j = 0; j < sizeOfSet(domain); j++) {
+			k = tableValueIndex(g, i, domain->values[j]);
+			if(k >= 0 && tableSupported(g, k, valid, words)) {
+				addIntegerToSet(restricted, domain->values[j]);
+			}
+		}
+		if(sizeOfSet(restricted) < sizeOfSet(domain)) {
+			ok = replaceDomain(s, var, restricted, p, backup, arcQueue, pending);
+		} else {
+			freeIntegerSet(restricted);
+		}
+	}
+	free(valid);
+	free(mask);
+	return ok;
+}
+
+/*
+  Makes literal k of clause g hold. Without an arc queue the variable is
+  still pushed on pending, so that its own clauses are propagated in turn.
+*/
+static int forceLiteral(Solver s, Global g, int k, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	Variable var = varByIndex(p, g->literalVars[k]);
+	IntegerSet restricted;
+	int bound = g->bounds[k], ok;
+	switch(g->relations[k]) {
+		case IS:
+			ok = restrictBounds(s, var, bound, bound, p, backup, arcQueue, pending);
+			break;
+		case NEQ:
+			restricted = copyIntegerSet(domainOfVar(var));
+			removeIntegerFromSet(restricted, bound);
+			ok = replaceDomain(s, var, restricted, p, backup, arcQueue, pending);
+			break;
+		case SMALLER:
+			ok = restrictBounds(s, var, INT_MIN, bound-1, p, backup, arcQueue, pending);
+			break;
+		case GREATER:
+			ok = restrictBounds(s, var, bound+1, INT_MAX, p, backup, arcQueue, pending);
+			break;
+		case LEQ:
+			ok = restrictBounds(s, var, INT_MIN, bound, p, backup, arcQueue, pending);
+			break;
+		default:
+			ok = restrictBounds(s, var, bound, INT_MAX, p, backup, arcQueue, pending);
+	}
+	if(ok && arcQueue == NULL && pending != NULL) {
+		push(pending, var);
+	}
+	return ok;
+}
+
+/*
+  Unit propagation of a clause with two watched literals, after the domain of
+  x has been reduced (x NULL: before the search). A watched literal that has
+  become false is replaced by a literal that is not false; if there is none
+  the other watched literal has to hold. Watches only move to literals that
+  are not false, which stay so on backtracking, so they are not restored.
+  Returns 0 if every literal is false.
+*/
+static int propagateClause(Solver s, Global g, Variable x, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	int state, w, k;
+	if(x != NULL && g->literalVars[g->watched[0]] != x->index && g->literalVars[g->watched[1]] != x->index) {
+		return 1;
+	}
+	s->stats.revisions++;
+	for(w = 0; w < 2; w++) {
+		if(literalState(g, g->watched[w], p) >= 0) {
+			continue;
+		}
+		for(k = 0; k < g->literalCount; k++) {
+			if(k != g->watched[0] && k != g->watched[1] && literalState(g, k, p) >= 0) {
+				break;
+			}
+		}
+		if(k < g->literalCount) {
+			g->watched[w] = k;
+			continue;
+		}
+		state = literalState(g, g->watched[1-w], p);
+		if(state < 0) {
+			return 0;
+		}
+		return (state > 0 || forceLiteral(s, g, g->watched[1-w], p, backup, arcQueue, pending));
+	}
+	return 1;
+}
+
+/*
+  Whether disjunct k of g holds for some values left for its variables from
+  disjunctVars[i] on, as satisfiable tries them. Once budget combinations
+  have been tried the disjunct is assumed to hold. The values it holds with
+  are kept as its support.
+*/
+static int disjunctSupported(Global g, int k, int i, Problem p, int *budget) {
+	Variable var;
+	IntegerSet domain;
+	int *values, supported = 0, j;
+	if(i == g->disjunctStarts[k+1]) {
+		(*budget)--;
+		if(!checkConstraint(g->disjuncts[k], p)) {
+			return 0;
+		}
+		for(j = g->disjunctStarts[k]; j < i; j++) {
+			g->supportValues[j] = domainMinimumOfVar(varByIndex(p, g->disjunctVars[j]));
+		}
+		g->supported[k] = 1;
+		return 1;
+	}
+	var = varByIndex(p, g->disjunctVars[i]);
+	domain = domainOfVar(var);
+	if(sizeOfSet(domain) == 1) {
+		return disjunctSupported(g, k, i+1, p, budget);
+	}
+	values = valuesOfSet(domain);
+	for(j = 0; !supported && j < sizeOfSet(domain); j++) {
+		if(*budget <= 0) {
+			supported = 1;
+			break;
+		}
+		setDomainOfVar(var, createSingletonDomain(values[j]));
+		supported = disjunctSupported(g, k, i+1, p, budget);
+		freeIntegerSet(domainOfVar(var));
+	}
+	setDomainOfVar(var, domain);
+	return supported;
+}
+
+/*
+  Whether disjunct k of g can still hold: its support is left, the bounds
+  of its expressions decide it, or else see disjunctSupported.
+*/
+static int disjunctPossible(Global g, int k, Problem p) {
+	int budget = DISJUNCT_SEARCH_LIMIT, decided, i;
+	if(g->supported[k]) {
+		for(i = g->disjunctStarts[k]; i < g->disjunctStarts[k+1]; i++) {
+			if(!valueInSet(domainOfVar(varByIndex(p, g->disjunctVars[i])), g->supportValues[i])) {
+				break;
+			}
+		}
+		if(i == g->disjunctStarts[k+1]) {
+			return 1;
+		}
+	}
+	decided = decideConstraint(g->disjuncts[k], p);
+	if(decided >= 0) {
+		return decided;
+	}
+	return disjunctSupported(g, k, g->disjunctStarts[k], p, &budget);
+}
+
+/* whether variable var occurs in disjunct k of g */
+static int disjunctHasVar(Global g, int k, int var) {
+	int i;
+	for(i = g->disjunctStarts[k]; i < g->disjunctStarts[k+1]; i++) {
+		if(g->disjunctVars[i] == var) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+  Makes disjunct k of g hold: the values of its variables that it can not
+  hold with are removed, until nothing changes. As with forceLiteral the
+  variables reduced are pushed on pending without an arc queue as well.
+*/
+static int enforceDisjunct(Solver s, Global g, int k, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	IntegerSet domain, restricted;
+	int ok = 1, *values, i, j;
+	long pruned = -1;
+	while(ok && pruned != s->stats.pruned) {
+		pruned = s->stats.pruned;
+		for(i = g->disjunctStarts[k]; ok && i < g->disjunctStarts[k+1]; i++) {
+			Variable var = varByIndex(p, g->disjunctVars[i]);
+			domain = domainOfVar(var);
+			if(sizeOfSet(domain) <= 1) {
+				continue;
+			}
+			values = valuesOfSet(domain);
+			restricted = emptyIntegerSet();
+			for(j = 0; j < sizeOfSet(domain); j++) {
+				setDomainOfVar(var, createSingletonDomain(values[j]));
+				if(disjunctPossible(g, k, p)) {
+					addIntegerToSet(restricted, values[j]);
+				}
+				freeIntegerSet(domainOfVar(var));
+			}
+			setDomainOfVar(var, domain);
+			if(sizeOfSet(restricted) == sizeOfSet(domain)) {
+				freeIntegerSet(restricted);
+				continue;
+			}
+			ok = replaceDomain(s, var, restricted, p, backup, arcQueue, pending);
+			if(ok && arcQueue == NULL && pending != NULL) {
+				push(pending, var);
+			}
+		}
+	}
+	return ok;
+}
+
+/*
+  Propagates a disjunction as propagateClause does a clause, after the
+  domain of x has been reduced (x NULL: before the search). It wakes up only
+  for the variables of its watched disjuncts. Returns 0 if no disjunct can
+  hold.
+*/
+static int propagateDisjunction(Solver s, Global g, Variable x, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	int w, k;
+	if(x != NULL && !disjunctHasVar(g, g->watched[0], x->index) && !disjunctHasVar(g, g->watched[1], x->index)) {
+		return 1;
+	}
+	s->stats.revisions++;
+	for(w = 0; w < 2; w++) {
+		if(disjunctPossible(g, g->watched[w], p)) {
+			continue;
+		}
+		for(k = 0; k < g->disjunctCount; k++) {
+			if(k != g->watched[0] && k != g->watched[1] && disjunctPossible(g, k, p)) {
+				break;
+			}
+		}
+		if(k < g->disjunctCount) {
+			g->watched[w] = k;
+			continue;
+		}
+		if(!disjunctPossible(g, g->watched[1-w], p)) {
+			return 0;
+		}
+		return enforceDisjunct(s, g, g->watched[1-w], p, backup, arcQueue, pending);
+	}
+	return 1;
+}
+
+/*
+  Propagation of a count: R keeps the values that its relation allows with
+  a count between the Xi that have only v left and the Xi that still have
+  it. If the least count R allows needs all the Xi that still have v, they
+  take it; if the Xi with only v left already make the largest, v is
+  removed from the others. Like a forced literal, without an arc queue the
+  Xi reduced are still pushed on pending. Repeated until nothing changes,
+  returns 0 on a wipeout.
+*/
+static int propagateCount(Solver s, Global g, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	Variable result = (g->result >= 0 ? varByIndex(p, g->result) : NULL), var;
+	IntegerSet restricted;
+	int low, high, rlow, rhigh, least, most, ok = 1, i;
+	long pruned = -1;
+	s->stats.revisions++;
+	while(pruned != s->stats.pruned) {
+		pruned = s->stats.pruned;
+		countBounds(g, p, &low, &high);
+		if(result != NULL) {
+			switch(g->relation) {
+				case IS:
+					ok = restrictBounds(s, result, low, high, p, backup, arcQueue, pending);
+					break;
+				case NEQ:
+					if(low == high && valueInSet(domainOfVar(result), low)) {
+						restricted = copyIntegerSet(domainOfVar(result));
+						removeIntegerFromSet(restricted, low);
+						ok = replaceDomain(s, result, restricted, p, backup, arcQueue, pending);
+					}
+					break;
+				case SMALLER:
+					ok = restrictBounds(s, result, low+1, INT_MAX, p, backup, arcQueue, pending);
+					break;
+				case GREATER:
+					ok = restrictBounds(s, result, INT_MIN, high-1, p, backup, arcQueue, pending);
+					break;
+				case LEQ:
+					ok = restrictBounds(s, result, low, INT_MAX, p, backup, arcQueue, pending);
+					break;
+				default:
+					ok = restrictBounds(s, result, INT_MIN, high, p, backup, arcQueue, pending);
+			}
+			if(!ok) {
+				return 0;
+			}
+			rlow = domainMinimumOfVar(result);
+			rhigh = domainMaximumOfVar(result);
+		} else {
+			rlow = rhigh = g->value;
+		}
+		if(!countPossible(g->relation, low, high, rlow, rhigh)) {
+			return 0;
+		}
+		/* the counts that R allows */
+		least = 0;
+		most = g->varCount;
+		switch(g->relation) {
+			case IS:
+				least = rlow;
+				most = rhigh;
+				break;
+			case NEQ:
+				if(rlow == rhigh) {
+					least = (low == rlow ? rlow+1 : least);
+					most = (high == rlow ? rlow-1 : most);
+				}
+				break;
+			case SMALLER:
+				most = rhigh-1;
+				break;
+			case GREATER:
+				least = rlow+1;
+				break;
+			case LEQ:
+				most = rhigh;
+				break;
+			default:
+				least = rlow;
+		}
+		if(least > high || most < low) {
+			return 0;
+		}
+		if(low == high || (least < high && most > low)) {
+			continue;
+		}
+		for(i = 0; i < g->varCount; i++) {
+			var = varByIndex(p, g->vars[i]);
+			if(domainSizeOfVar(var) == 1 || !valueInSet(domainOfVar(var), g->counted)) {
+				continue;
+			}
+			if(least >= high) {
+				ok = restrictBounds(s, var, g->counted, g->counted, p, backup, arcQueue, pending);
+			} else {
+				restricted = copyIntegerSet(domainOfVar(var));
+				removeIntegerFromSet(restricted, g->counted);
+				ok = replaceDomain(s, var, restricted, p, backup, arcQueue, pending);
+			}
+			if(!ok) {
+				return 0;
+			}
+			if(arcQueue == NULL && pending != NULL) {
+				push(pending, var);
+			}
+		}
+	}
+	return 1;
+}
+
+/* removes the value of the assigned variable x from the other variables of alldiff g */
+static int propagateAlldiff(Solver s, Global g, Variable x, Problem p, Backup backup, Queue arcQueue, Stack pending) {
+	int value = domainMinimumOfVar(x), j;
+	s->stats.revisions++;
+	for(j = 0; j < g->varCount; j++) {
+		Variable other = varByIndex(p, g->vars[j]);
+		if(other == x || isAssigned(other, p)) {
+			if(other != x && !isAssigned(x, p) && domainMinimumOfVar(other) == value) {
+				return 0;
+			}
+			continue;
+		}
+		if(!valueInSet(domainOfVar(other), value)) {
+			continue;
+		}
+		addBackup(other->index, copyIntegerSet(domainOfVar(other)), *(sequencePosition(other)), backup);
+		removeIntegerFromSet(domainOfVar(other), value);
+		resortVarSeq(p->varSequence, sequencePosition(other));
+		s->stats.pruned++;
+		if(domainSizeOfVar(other) == 0) {
+			return 0;
+		} else if(arcQueue != NULL) {
+			addVariableArcs(s, other, arcQueue, p);
+			if(domainSizeOfVar(other) == 1) {
+				push(pending, other);
+			}
+		}
+	}
+	return enoughValues(g, p, 1);
+}
+
+/*
+  Propagates the globals of var after its domain has been reduced. An
+  alldiff removes the value of a variable that has a single value left from
+  its other unassigned variables, a maximum or minimum restricts the bounds
+  of its variables, an element the domains of its index and result, a table
+  the values without a valid tuple, a clause or disjunction watching x its
+  last literal or disjunct that can hold, a count its R and the variables
+  the count decides. With an arc queue (MAC) the variables reduced are
+  propagated in the same way, and their arcs are added to the queue;
+  without one only the variables reduced by clauses, disjunctions and counts
+  are. Returns 0 on a wipeout.
+*/
+int propagateGlobals(Solver s, Variable var, Problem p, Backup backup, Queue arcQueue) {
+	Stack pending = emptyStack();
+	int ok = 1, i;
+	push(pending, var);
+	while(ok && !isEmptyStack(pending)) {
+		Variable x = pop(pending);
+		int *globals = valuesOfSet(x->globals);
+		for(i = 0; ok && i < sizeOfSet(x->globals); i++) {
+			Global g = p->globals[globals[i]];
+			if(g->kind == GLOBAL_ELEMENT) {
+				ok = propagateElement(s, g, p, backup, arcQueue, pending);
+			} else if(g->kind == GLOBAL_TABLE) {
+				ok = propagateTable(s, g, p, backup, arcQueue, pending);
+			} else if(g->kind == GLOBAL_CLAUSE) {
+				ok = propagateClause(s, g, x, p, backup, arcQueue, pending);
+			} else if(g->kind == GLOBAL_DISJUNCTION) {
+				ok = propagateDisjunction(s, g, x, p, backup, arcQueue, pending);
+			} else if(g->kind == GLOBAL_COUNT) {
+				ok = propagateCount(s, g, p, backup, arcQueue, pending);
+			} else if(g->kind != GLOBAL_ALLDIFF) {
+				ok = propagateExtremum(s, g, p, backup, arcQueue, pending);
+			} else if(domainSizeOfVar(x) == 1) {
+				ok = propagateAlldiff(s, g, x, p, backup, arcQueue, pending);
+			}
+		}
+	}
+	freeStack(pending);
+	return ok;
+}
+
+/*
+  Initial consistency of the globals: the values of variables with a single
+  value are removed from the other variables of their alldiff constraints,
+  the bounds of maximum and minimum constraints are restricted, element
+  and table constraints are made consistent, clauses and disjunctions
+  propagate their units and counts their bounds, until nothing changes. Returns 0 if the problem
+  has no solution.
+*/
+int initGlobals(Solver s, Problem p) {
+	int changed = 1, i, j, k;
+	while(changed) {
+		changed = 0;
+		for(i = 0; i < p->globalCount; i++) {
+			Global g = p->globals[i];
+			if(g->kind != GLOBAL_ALLDIFF) {
+				long pruned = s->stats.pruned;
+				int ok;
+				switch(g->kind) {
+					case GLOBAL_ELEMENT:
+						ok = propagateElement(s, g, p, NULL, NULL, NULL);
+						break;
+					case GLOBAL_TABLE:
+						ok = propagateTable(s, g, p, NULL, NULL, NULL);
+						break;
+					case GLOBAL_CLAUSE:
+						ok = propagateClause(s, g, NULL, p, NULL, NULL, NULL);
+						break;
+					case GLOBAL_DISJUNCTION:
+						ok = propagateDisjunction(s, g, NULL, p, NULL, NULL, NULL);
+						break;
+					case GLOBAL_COUNT:
+						ok = propagateCount(s, g, p, NULL, NULL, NULL);
+						break;
+					default:
+						ok = propagateExtremum(s, g, p, NULL, NULL, NULL);
+				}
+				if(!ok) {
+					return 0;
+				}
+				changed |= (s->stats.pruned != pruned);
+				continue;
+			}
+			for(j = 0; j < g->varCount; j++) {
+				Variable var = varByIndex(p, g->vars[j]);
+				if(domainSizeOfVar(var) != 1) {
+					continue;
+				}
+				for(k = 0; k < g->varCount; k++) {
+					Variable other = varByIndex(p, g->vars[k]);
+					if(k != j && valueInSet(domainOfVar(other), domainMinimumOfVar(var))) {
+						removeIntegerFromSet(domainOfVar(other), domainMinimumOfVar(var));
+						s->stats.pruned++;
+						if(domainSizeOfVar(other) == 0) {
+							return 0;
+						}
+						changed = 1;
+					}
+				}
+			}
+			if(!enoughValues(g, p, 0)) {
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
@@ -0,0 +1,119 @@
+#ifndef GLOBAL_H
+#define GLOBAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "backup.h"
+
+/*
+ * Global constraints: constraints over many variables that are checked and
+ * propagated as a whole instead of through a decomposition into binary
+ * constraints. A problem keeps them apart from its expression constraints
+ * (p->globals), every variable lists the globals it occurs in.
+ *
+ * GLOBAL_ALLDIFF   all variables take different values
+ * GLOBAL_MAXIMUM   the result variable is the largest of the variables
+ * GLOBAL_MINIMUM   the result variable is the smallest of the variables
+ * GLOBAL_ELEMENT   the result is the entry of an array that a variable selects
+ * GLOBAL_TABLE     the variables take the values of one of a list of tuples
+ * GLOBAL_CLAUSE    at least one of a list of literals X rel c holds
+ * GLOBAL_DISJUNCTION  at least one of a list of constraints holds
+ * GLOBAL_COUNT     the number of variables equal to a value compares with R
+ *
+ * With -alldiff, cliques of pairwise disequalities Xa <> Xb in the input are
+ * found when the search starts and replaced by alldiff constraints. With
+ * -maxmin, constraints R = max(X1, .., Xn) and R = min(X1, .., Xn) over
+ * variables are replaced by maximum and minimum constraints, which keep the
+ * bounds of R and the Xi consistent. Constraints R = [A0, .., An-1][I + c],
+ * the rewritten form of an array indexed by a variable, are always replaced
+ * by element constraints: I keeps the indices of the entries that R can
+ * equal, R the values of those entries.
+ * Constraints any(all(X1 = a1, .., Xn = an), all(X1 = b1, .., Xn = bn), ..),
+ * the rewritten form of a table, are always replaced by table constraints.
+ * They keep a bitset of the tuples for every value of every variable and are
+ * propagated with Compact-Table: the tuples that are still valid are the
+ * intersection over the variables of the union of the bitsets of their
+ * values, a value stays if its bitset shares a tuple with them.
+ * Constraints any(L1, .., Ln) where every Li compares a different variable
+ * with a constant, or is a variable on its own (X <> 0), are always replaced
+ * by clauses. A clause watches two literals that are not false; only when a
+ * watched literal becomes false another one is looked for, and if there is
+ * none the other watched literal is forced to hold (unit propagation).
+ * The literals are read from the IntegerSet domains of their variables:
+ * boolean variables are not stored as packed assigned and value masks,
+ * that part of the boolean request is still open.
+ * The other constraints any(C1, .., Cn) over three variables or more, which
+ * forward checking and arc consistency can not prune before all but one or
+ * two of their variables are assigned, get a disjunction next to them. It
+ * watches two disjuncts in the same way. A disjunct is false when no values
+ * left for its variables satisfy it; when a single one can hold, the values
+ * of its variables without support are removed. Both tests start from the
+ * values a disjunct held with last, then try a bounded number of
+ * combinations and assume the disjunct can hold beyond that.
+ * Disjuncts that might divide by zero are not taken apart, as evaluating
+ * them on their own could fail where any() would not.
+ * Constraints S rel R, where S is any(X1 = v) + .. + any(Xn = v), the
+ * rewritten form of count(X1, .., Xn : v), and R a constant or a variable,
+ * are always replaced by count constraints. The count lies between the
+ * number of Xi that have only v left and the number that still have v. R
+ * keeps the values the relation allows with those. When the least count R
+ * allows needs every Xi that still has v, they all take it; when the Xi
+ * with only v left already reach the largest, v is removed from the others.
+ * A gcc is rewritten to one count per value.
+ */
+
+typedef enum {
+	GLOBAL_ALLDIFF, GLOBAL_MAXIMUM, GLOBAL_MINIMUM, GLOBAL_ELEMENT, GLOBAL_TABLE, GLOBAL_CLAUSE,
+	GLOBAL_DISJUNCTION, GLOBAL_COUNT
+} GlobalKind;
+
+typedef struct global {
+	GlobalKind kind;
+	int index;
+	int varCount;
+	int *vars;					/* variable indices, ascending */
+	int result;					/* maximum, minimum, element and count: index of R, otherwise -1 */
+	int value;					/* element and count: the value of R if it is a constant */
+	int selector;				/* element: index of I, otherwise -1 */
+	int offset;					/* element: I selects the entry I + offset */
+	int entryCount;
+	int *entries;				/* element: the variable of every entry, -1 for a constant */
+	int *constants;				/* element: the value of every constant entry */
+	int tupleCount;
+	int *valueStarts;			/* table: the values of vars[i] are values[valueStarts[i]] up to valueStarts[i+1] */
+	int *values;				/* table: the values of every variable in the tuples, ascending */
+	int *residues;				/* table: per value, the word of supports where a valid tuple was found last */
+	unsigned long long *supports;	/* table: per value, the bitset of the tuples it occurs in */
+	int literalCount;
+	int *literalVars;			/* clause: the variable of every literal */
+	RelOperator *relations;		/* clause: the comparison of every literal */
+	int *bounds;				/* clause: the constant every literal compares with */
+	int disjunctCount;
+	Constraint *disjuncts;		/* disjunction: the constraints of which one has to hold */
+	int *disjunctStarts;		/* disjunction: the variables of disjuncts[k] are disjunctVars[disjunctStarts[k]] */
+	int *disjunctVars;			/* up to disjunctStarts[k+1] */
+	int *supported;				/* disjunction: whether disjuncts[k] has held with the values in supportValues */
+	int *supportValues;			/* disjunction: per variable in disjunctVars, its value when the disjunct held last */
+	int counted;				/* count: the value whose occurrences are counted */
+	RelOperator relation;		/* count: how the count compares with R */
+	int watched[2];				/* clause and disjunction: the literals or disjuncts watched */
+} global;
+
+Global newGlobal(GlobalKind kind, int varCount, int *vars);
+void freeGlobal(Global g);
+void addGlobalToProblem(Problem p, Global g);
+int promoteCliques(Problem p);
+int promoteExtrema(Problem p);
+int promoteElements(Problem p);
+int promoteTables(Problem p);
+int promoteCounts(Problem p);
+int promoteClauses(Problem p);
+int addDisjunctions(Problem p);
+
+int checkGlobals(Variable var, Problem p);
+int propagateGlobals(Solver s, Variable var, Problem p, Backup backup, Queue arcQueue);
+int initGlobals(Solver s, Problem p);
+
+#endif
@@ -1,5 +1,5 @@
 /* THIS FILE HAS BEEN AUTOMATICALLY GENERATED BY LLnextgen. DO NOT EDIT */
-#line 10 "grammar.g"
+#line 11 "grammar.g"
 
 #include "problem.h"
 
@@ -16,29 +16,29 @@
 #include <string.h>
 static const char LLsets[] = {
 	'\x04', 	'\x00', 	'\x02', 	'\x10', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x28', 	'\x08', 	'\x02', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x28', 	'\x0A', 	'\x02', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
 	'\x30', 	'\x00', 	'\x02', 	'\x20', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\xC0', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x02', 	'\x00', 	'\x04', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x08', 	'\x00', 	'\x60', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x04', 	'\x00', 	'\x08', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x08', 	'\x00', 	'\x20', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x08', 	'\x00', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x78', 	'\xFC', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\x0A', 	'\x00', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\x7A', 	'\xFC', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
 	'\x20', 	'\x00', 	'\x00', 	'\x20', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x78', 	'\x00', 	'\xBF', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\x7A', 	'\x00', 	'\xBF', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x00', 	'\x00', 	'\x80', 	'\x01', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x78', 	'\x00', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\x7A', 	'\x00', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
 	'\x20', 	'\x00', 	'\x00', 	'\x00', 	'\x04', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\xF8', 	'\xFC', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\xFA', 	'\xFC', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x00', 	'\x00', 	'\x30', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x8E', 	'\x00', 	'\x6C', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x00', 	'\xFC', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x18', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x68', 	'\x00', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\x6A', 	'\x00', 	'\xB7', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x20', 	'\x00', 	'\x03', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x48', 	'\x00', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x00', 	'\x00', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\x4A', 	'\x00', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
+	'\x20', 	'\x02', 	'\x00', 	'\xB4', 	'\x07', 	'\x00', 	'\x00', 	'\x00', 
 	0
 };
 static const int LLindex[] = { 0,
@@ -205,7 +205,7 @@ static void LLerror(LLthisType *LLthis, int LLtoken) {
 #define LLread() LLread(LLthis)
 #define LLskip() LLskip(LLthis)
 #define LLerror(LLx) LLerror(LLthis, LLx)
-#line 13 "grammar.g"
+#line 14 "grammar.g"
 
 	#include <stdio.h>
 	#include <stdlib.h>
@@ -220,20 +220,20 @@ static void LLerror(LLthisType *LLthis, int LLtoken) {
 	extern int lineNr;
 	void LLmessage(struct LLthis *llthis, int token) {
 		printf("Parse error: line %d, unexpected token %s\n", lineNr, yytext);
-		exit(EXIT_FAILURE);
+		loadFailed(EXIT_FAILURE);
 	}
 
 #line 227 "grammar.c"
 static Problem LL0_problem(LLthisType *LLthis) ;
 static void LL1_body(LLthisType *LLthis,
-#line 34 "grammar.g"
+#line 36 "grammar.g"
 Problem *p
 #line 232 "grammar.c"
 ) ;
 static VarList LL2_vars(LLthisType *LLthis) ;
 static DataType LL3_datatype(LLthisType *LLthis) ;
 static void LL4_domains(LLthisType *LLthis,
-#line 71 "grammar.g"
+#line 73 "grammar.g"
 Problem p
 #line 239 "grammar.c"
 ) ;
@@ -248,7 +248,7 @@ static int LL12_var(LLthisType *LLthis) ;
 static FunctionCall LL13_functioncall(LLthisType *LLthis) ;
 static VarList LL14_varlist(LLthisType *LLthis) ;
 static void LL15_domainspec(LLthisType *LLthis,
-#line 212 "grammar.g"
+#line 246 "grammar.g"
 Problem p
 #line 254 "grammar.c"
 ) ;
@@ -261,14 +261,14 @@ static RelOperator LL21_relop(LLthisType *LLthis) ;
 static TermOperator LL22_termop(LLthisType *LLthis) ;
 static FactorOperator LL23_factorop(LLthisType *LLthis) ;
 static Problem LL0_problem(LLthisType *LLthis) {
-#line 30 "grammar.g"
+#line 32 "grammar.g"
 Problem
 #line 267 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
 LL1_body(LLthis,
-#line 31 "grammar.g"
+#line 33 "grammar.g"
 &LLretval
 #line 274 "grammar.c"
 );
@@ -276,19 +276,19 @@ LL1_body(LLthis,
 return LLretval;
 }
 static void LL1_body(LLthisType *LLthis,
-#line 34 "grammar.g"
+#line 36 "grammar.g"
 Problem *p
 #line 282 "grammar.c"
 ) {
-#line 129 "grammar.g"
+#line 131 "grammar.g"
 ConstraintList
 #line 286 "grammar.c"
 c;
-#line 154 "grammar.g"
+#line 156 "grammar.g"
 SolveSpec
 #line 290 "grammar.c"
 s;
-#line 49 "grammar.g"
+#line 51 "grammar.g"
 VarList
 #line 294 "grammar.c"
 v;
@@ -300,7 +300,7 @@ LLscnt[0]++;
 LLscnt[1]++;
 LLscnt[2]++;
 v = LL2_vars(LLthis);
-#line 35 "grammar.g"
+#line 37 "grammar.g"
 { 
 		*p = emptyProblem(); 
 		setVarsOfProblem(*p, v);
@@ -309,20 +309,20 @@ v = LL2_vars(LLthis);
 #line 310 "grammar.c"
 LLscnt[0]--;
 LL4_domains(LLthis,
-#line 40 "grammar.g"
+#line 42 "grammar.g"
 *p
 #line 315 "grammar.c"
 );
 LLscnt[1]--;
 c = LL9_constraints(LLthis);
-#line 41 "grammar.g"
+#line 43 "grammar.g"
 {
 		setConstraintsOfProblem(*p, c); 
 	}
 #line 323 "grammar.c"
 LLscnt[2]--;
 s = LL11_solvespec(LLthis);
-#line 44 "grammar.g"
+#line 46 "grammar.g"
 { 
 		(*p)->solvespec = s;
 	}
@@ -330,15 +330,15 @@ s = LL11_solvespec(LLthis);
 }
 }
 static VarList LL2_vars(LLthisType *LLthis) {
-#line 49 "grammar.g"
+#line 51 "grammar.g"
 VarList
 #line 336 "grammar.c"
 LLretval;
-#line 207 "grammar.g"
+#line 241 "grammar.g"
 VarList
 #line 340 "grammar.c"
 l;
-#line 60 "grammar.g"
+#line 62 "grammar.g"
 DataType
 #line 344 "grammar.c"
 t;
@@ -346,8 +346,8 @@ memset(&LLretval, 0, sizeof(LLretval));
 memset(&l, 0, sizeof(l));
 memset(&t, 0, sizeof(t));
 {
-#line 49 "grammar.g"
- LLretval = NULL; 
+#line 51 "grammar.g"
+ VarList last = NULL; LLretval = NULL; 
 #line 352 "grammar.c"
 LLtcnt[17]++;
 LLtcnt[28]++;
@@ -373,8 +373,8 @@ LLtcnt[17]--;
 LL_SCANDONE(273);/* COLONTOK */
 LLread();
 t = LL3_datatype(LLthis);
-#line 54 "grammar.g"
-{ LLretval = addVars(LLretval, t, l);}
+#line 56 "grammar.g"
+{ LLretval = addVars(LLretval, &last, t, l);}
 #line 379 "grammar.c"
 LLread();
 LLtcnt[16]--;
@@ -389,7 +389,7 @@ break;
 return LLretval;
 }
 static DataType LL3_datatype(LLthisType *LLthis) {
-#line 60 "grammar.g"
+#line 62 "grammar.g"
 DataType
 #line 395 "grammar.c"
 LLretval;
@@ -404,7 +404,7 @@ goto LL_0;
 case 6:/* INTTYPE */
 LLscnt[3]--;
 LL_SCANDONE(262);/* INTTYPE */
-#line 61 "grammar.g"
+#line 63 "grammar.g"
 { 
 		LLretval = INTEGER;
 	}
@@ -413,7 +413,7 @@ break;
 case 7:/* BOOLTYPE */
 LLscnt[3]--;
 LL_SCANDONE(263);/* BOOLTYPE */
-#line 65 "grammar.g"
+#line 67 "grammar.g"
 { 
 		LLretval = BOOLEAN;
 	}
@@ -424,7 +424,7 @@ break;
 return LLretval;
 }
 static void LL4_domains(LLthisType *LLthis,
-#line 71 "grammar.g"
+#line 73 "grammar.g"
 Problem p
 #line 430 "grammar.c"
 ) {
@@ -446,7 +446,7 @@ break;
 case 28:/* VARTOK */
 LLtcnt[16]++;
 LL15_domainspec(LLthis,
-#line 72 "grammar.g"
+#line 74 "grammar.g"
 p
 #line 452 "grammar.c"
 );
@@ -461,18 +461,18 @@ break;
 }
 }
 static IntegerSet LL5_domain(LLthisType *LLthis) {
-#line 76 "grammar.g"
+#line 78 "grammar.g"
 IntegerSet
 #line 467 "grammar.c"
 LLretval;
-#line 106 "grammar.g"
+#line 108 "grammar.g"
 Tuple
 #line 471 "grammar.c"
 sd;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&sd, 0, sizeof(sd));
 {
-#line 76 "grammar.g"
+#line 78 "grammar.g"
 int min = 0;
 #line 478 "grammar.c"
 LLscnt[4]++;
@@ -492,7 +492,7 @@ break;
 case 26:/* PARENTOPEN */
 LLscnt[4]--;
 LL_SCANDONE(282);/* PARENTOPEN */
-#line 80 "grammar.g"
+#line 82 "grammar.g"
 {
 			min = 1;
 		}
@@ -502,7 +502,7 @@ break;
 LLread();
 LLscnt[5]--;
 sd = LL6_subdomain(LLthis);
-#line 84 "grammar.g"
+#line 86 "grammar.g"
 { 
 		LLretval = emptyIntegerSet();
 		sd.min += min; 
@@ -524,7 +524,7 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[5]--;
 sd = LL6_subdomain(LLthis);
-#line 91 "grammar.g"
+#line 93 "grammar.g"
 {
 			addIntervalToSet(LLretval, sd.min, sd.max); 
 		}
@@ -547,7 +547,7 @@ break;
 case 27:/* PARENTCLOSE */
 LLscnt[6]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
-#line 98 "grammar.g"
+#line 100 "grammar.g"
 {
 			removeIntegerFromSet(LLretval, sd.max); 
 		}
@@ -558,15 +558,15 @@ break;
 return LLretval;
 }
 static Tuple LL6_subdomain(LLthisType *LLthis) {
-#line 106 "grammar.g"
+#line 108 "grammar.g"
 Tuple
 #line 564 "grammar.c"
 LLretval;
-#line 122 "grammar.g"
+#line 124 "grammar.g"
 int
 #line 568 "grammar.c"
 min;
-#line 122 "grammar.g"
+#line 124 "grammar.g"
 int
 #line 572 "grammar.c"
 max;
@@ -574,12 +574,12 @@ memset(&LLretval, 0, sizeof(LLretval));
 memset(&min, 0, sizeof(min));
 memset(&max, 0, sizeof(max));
 {
-#line 106 "grammar.g"
+#line 108 "grammar.g"
 int max;
 #line 580 "grammar.c"
 LLtcnt[30]++;
 min = LL8_negposint(LLthis);
-#line 107 "grammar.g"
+#line 109 "grammar.g"
 {
 		max = min; 
 	}
@@ -605,21 +605,21 @@ LLscnt[7]--;
 max = LL8_negposint(LLthis);
 LLread();
 }
-#line 113 "grammar.g"
+#line 115 "grammar.g"
 {LLretval = (Tuple){min, max};}
 #line 611 "grammar.c"
 }
 return LLretval;
 }
 static int LL7_integer(LLthisType *LLthis) {
-#line 116 "grammar.g"
+#line 118 "grammar.g"
 int
 #line 618 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
 LL_SCANDONE(285);/* DECTOK */
-#line 117 "grammar.g"
+#line 119 "grammar.g"
 { 
 		LLretval = atoi(yytext); 
 	}
@@ -628,13 +628,13 @@ LL_SCANDONE(285);/* DECTOK */
 return LLretval;
 }
 static int LL8_negposint(LLthisType *LLthis) {
-#line 122 "grammar.g"
+#line 124 "grammar.g"
 int
 #line 634 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
-#line 122 "grammar.g"
+#line 124 "grammar.g"
 int mult = 1;
 #line 640 "grammar.c"
 LLtcnt[11]++;
@@ -651,14 +651,14 @@ break;
 case 11:/* MINUSTOK */
 LLtcnt[11]--;
 LL_SCANDONE(267);/* MINUSTOK */
-#line 123 "grammar.g"
+#line 125 "grammar.g"
 {mult=-1;}
 #line 657 "grammar.c"
 LLread();
 }
 LLtcnt[29]--;
 LL_SCANDONE(285);/* DECTOK */
-#line 124 "grammar.g"
+#line 126 "grammar.g"
 { 
 		LLretval = mult*atoi(yytext); 
 	}
@@ -667,28 +667,31 @@ LL_SCANDONE(285);/* DECTOK */
 return LLretval;
 }
 static ConstraintList LL9_constraints(LLthisType *LLthis) {
-#line 129 "grammar.g"
+#line 131 "grammar.g"
 ConstraintList
 #line 673 "grammar.c"
 LLretval;
-#line 220 "grammar.g"
+#line 254 "grammar.g"
 Constraint
 #line 677 "grammar.c"
 c;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&c, 0, sizeof(c));
 {
+#line 131 "grammar.g"
+ ConstraintList last = NULL; 
+#line 684 "grammar.c"
 LLtcnt[17]++;
 LLscnt[8]++;
 LL_SCANDONE(259);/* CONSTRAINTSTOK */
 LLread();
 LLtcnt[17]--;
 LL_SCANDONE(273);/* COLONTOK */
-#line 131 "grammar.g"
+#line 133 "grammar.g"
 {
 		LLretval = NULL; 
 	}
-#line 692 "grammar.c"
+#line 695 "grammar.c"
 LLread();
 for (;;) {
 LL_0:
@@ -699,6 +702,7 @@ break;
 case 4:/* SOLVETOK */
 break;
 case 5:/* ALLTOK */
+case 9:/* BRACKOPEN */
 case 11:/* MINUSTOK */
 case 26:/* PARENTOPEN */
 case 28:/* VARTOK */
@@ -709,11 +713,11 @@ case 33:/* ABSTOK */
 case 34:/* ANYTOK */
 LLtcnt[16]++;
 c = LL16_constraint(LLthis);
-#line 135 "grammar.g"
+#line 137 "grammar.g"
 {
-			LLretval = addConstraint(LLretval, c); 
+			LLretval = addConstraint(LLretval, &last, c); 
 		}
-#line 717 "grammar.c"
+#line 721 "grammar.c"
 LLtcnt[16]--;
 LL_SCANDONE(272);/* SEMITOK */
 LLread();
@@ -726,24 +730,27 @@ break;
 return LLretval;
 }
 static ConstraintList LL10_constraintlist(LLthisType *LLthis) {
-#line 142 "grammar.g"
+#line 144 "grammar.g"
 ConstraintList
-#line 732 "grammar.c"
+#line 736 "grammar.c"
 LLretval;
-#line 220 "grammar.g"
+#line 254 "grammar.g"
 Constraint
-#line 736 "grammar.c"
+#line 740 "grammar.c"
 c;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&c, 0, sizeof(c));
 {
+#line 144 "grammar.g"
+ ConstraintList last = NULL; 
+#line 747 "grammar.c"
 LLtcnt[15]++;
 c = LL16_constraint(LLthis);
-#line 143 "grammar.g"
+#line 145 "grammar.g"
 { 
-		LLretval = addConstraint(NULL, c); 
+		LLretval = addConstraint(NULL, &last, c); 
 	}
-#line 747 "grammar.c"
+#line 754 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
@@ -758,11 +765,11 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[9]--;
 c = LL16_constraint(LLthis);
-#line 148 "grammar.g"
+#line 150 "grammar.g"
 { 
-			LLretval = addConstraint(LLretval, c); 
+			LLretval = addConstraint(LLretval, &last, c); 
 		}
-#line 766 "grammar.c"
+#line 773 "grammar.c"
 continue;
 }
 LLtcnt[15]--;
@@ -772,13 +779,13 @@ break;
 return LLretval;
 }
 static SolveSpec LL11_solvespec(LLthisType *LLthis) {
-#line 154 "grammar.g"
+#line 156 "grammar.g"
 SolveSpec
-#line 778 "grammar.c"
+#line 785 "grammar.c"
 LLretval;
-#line 116 "grammar.g"
+#line 118 "grammar.g"
 int
-#line 782 "grammar.c"
+#line 789 "grammar.c"
 max;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&max, 0, sizeof(max));
@@ -799,30 +806,30 @@ goto LL_0;
 case 5:/* ALLTOK */
 LLscnt[10]--;
 LL_SCANDONE(261);/* ALLTOK */
-#line 157 "grammar.g"
+#line 159 "grammar.g"
 { 
 			LLretval.type = SOLVEALL;
 		}
-#line 807 "grammar.c"
+#line 814 "grammar.c"
 break;
 case 29:/* DECTOK */
 LLscnt[10]--;
 max = LL7_integer(LLthis);
-#line 161 "grammar.g"
+#line 163 "grammar.g"
 { 
 			LLretval.type = SOLVENR; 
 			LLretval.max = max; 
 		}
-#line 817 "grammar.c"
+#line 824 "grammar.c"
 break;
 }
 }
 return LLretval;
 }
 static int LL12_var(LLthisType *LLthis) {
-#line 168 "grammar.g"
+#line 170 "grammar.g"
 int
-#line 826 "grammar.c"
+#line 833 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
@@ -835,30 +842,30 @@ LLretval = LL7_integer(LLthis);
 return LLretval;
 }
 static FunctionCall LL13_functioncall(LLthisType *LLthis) {
-#line 172 "grammar.g"
+#line 174 "grammar.g"
 FunctionCall
-#line 841 "grammar.c"
+#line 848 "grammar.c"
 LLretval;
-#line 231 "grammar.g"
+#line 265 "grammar.g"
 NumExp
-#line 845 "grammar.c"
+#line 852 "grammar.c"
 arg1;
-#line 231 "grammar.g"
+#line 265 "grammar.g"
 NumExp
-#line 849 "grammar.c"
+#line 856 "grammar.c"
 arg2;
-#line 142 "grammar.g"
+#line 144 "grammar.g"
 ConstraintList
-#line 853 "grammar.c"
+#line 860 "grammar.c"
 l;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&arg1, 0, sizeof(arg1));
 memset(&arg2, 0, sizeof(arg2));
 memset(&l, 0, sizeof(l));
 {
-#line 172 "grammar.g"
- int argc; FunctionName name; void *argv; 
-#line 862 "grammar.c"
+#line 174 "grammar.g"
+ int argc, space; FunctionName name; void *argv; NumExp *args; 
+#line 869 "grammar.c"
 LLscnt[11]++;
 LL_0:
 switch (LLcsymb) {
@@ -880,16 +887,16 @@ goto LL_1;
 case 31:/* MAXTOK */
 LLscnt[12]--;
 LL_SCANDONE(287);/* MAXTOK */
-#line 174 "grammar.g"
+#line 176 "grammar.g"
 {name = MAX;}
-#line 886 "grammar.c"
+#line 893 "grammar.c"
 break;
 case 32:/* MINTOK */
 LLscnt[12]--;
 LL_SCANDONE(288);/* MINTOK */
-#line 174 "grammar.g"
+#line 176 "grammar.g"
 {name = MIN;}
-#line 893 "grammar.c"
+#line 900 "grammar.c"
 break;
 }
 LLread();
@@ -903,17 +910,53 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[13]--;
 arg2 = LL17_numExp(LLthis);
+#line 177 "grammar.g"
+{
+			argc = 2;
+			space = 4;
+			args = safeMalloc(space*sizeof(NumExp));
+			args[0] = arg1;
+			args[1] = arg2;
+		}
+#line 922 "grammar.c"
+LLtcnt[15]++;
+for (;;) {
+LL_3:
+switch (LLcsymb) {
+default:
+if (LLskip()) goto LL_3;
+break;
+case 27:/* PARENTCLOSE */
+break;
+case 15:/* COMMATOK */
+LLscnt[13]++;
+LL_SCANDONE(271);/* COMMATOK */
+LLread();
+LLscnt[13]--;
+arg2 = LL17_numExp(LLthis);
+#line 184 "grammar.g"
+{
+			if(argc == space) {
+				space *= 2;
+				args = safeRealloc(args, space*sizeof(NumExp));
+			}
+			args[argc++] = arg2;
+		}
+#line 946 "grammar.c"
+continue;
+}
+LLtcnt[15]--;
+break;
+}
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
-#line 176 "grammar.g"
-{	
-			argc = 2; 
-			NumExp *ar = safeMalloc(argc*sizeof(NumExp));
-			ar[0] = arg1;
-			ar[1] = arg2;
-			argv = ar;
+#line 191 "grammar.g"
+{
+			argv = allocExpression(argc*sizeof(NumExp));
+			memcpy(argv, args, argc*sizeof(NumExp));
+			free(args);
 		}
-#line 917 "grammar.c"
+#line 960 "grammar.c"
 break;
 default:
 if (LLskip())
@@ -933,15 +976,15 @@ LLscnt[13]--;
 arg1 = LL17_numExp(LLthis);
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
-#line 187 "grammar.g"
+#line 200 "grammar.g"
 {
 			name = ABS; 
 			argc = 1;
-			NumExp *ar = safeMalloc(argc*sizeof(NumExp));
+			NumExp *ar = allocExpression(argc*sizeof(NumExp));
 			ar[0] = arg1;
 			argv = ar;
 		}
-#line 945 "grammar.c"
+#line 988 "grammar.c"
 break;
 case 5:/* ALLTOK */
 case 34:/* ANYTOK */
@@ -959,16 +1002,16 @@ goto LL_2;
 case 5:/* ALLTOK */
 LLscnt[14]--;
 LL_SCANDONE(261);/* ALLTOK */
-#line 195 "grammar.g"
+#line 208 "grammar.g"
 {name = ALL;}
-#line 965 "grammar.c"
+#line 1008 "grammar.c"
 break;
 case 34:/* ANYTOK */
 LLscnt[14]--;
 LL_SCANDONE(290);/* ANYTOK */
-#line 195 "grammar.g"
+#line 208 "grammar.g"
 {name = ANY;}
-#line 972 "grammar.c"
+#line 1015 "grammar.c"
 break;
 }
 LLread();
@@ -979,45 +1022,116 @@ LLscnt[15]--;
 l = LL10_constraintlist(LLthis);
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
-#line 197 "grammar.g"
+#line 210 "grammar.g"
 {
 			argc = 1;
 			ConstraintList *p;
-			p = safeMalloc(argc*sizeof(ConstraintList));
+			p = allocExpression(argc*sizeof(ConstraintList));
 			p[0] = l;
 			argv = p;
 		}
-#line 991 "grammar.c"
+#line 1034 "grammar.c"
+break;
+case 9:/* BRACKOPEN */
+LLscnt[11]--;
+LLscnt[13]++;
+LLtcnt[10]++;
+LLtcnt[9]++;
+LLscnt[13]++;
+LLtcnt[10]++;
+LL_SCANDONE(265);/* BRACKOPEN */
+LLread();
+LLscnt[13]--;
+arg1 = LL17_numExp(LLthis);
+#line 218 "grammar.g"
+{
+			argc = 2;
+			space = 4;
+			args = safeMalloc(space*sizeof(NumExp));
+			args[1] = arg1;
+		}
+#line 1054 "grammar.c"
+LLtcnt[15]++;
+for (;;) {
+LL_4:
+switch (LLcsymb) {
+default:
+if (LLskip()) goto LL_4;
+break;
+case 10:/* BRACKCLOSE */
+break;
+case 15:/* COMMATOK */
+LLscnt[13]++;
+LL_SCANDONE(271);/* COMMATOK */
+LLread();
+LLscnt[13]--;
+arg2 = LL17_numExp(LLthis);
+#line 224 "grammar.g"
+{
+			if(argc == space) {
+				space *= 2;
+				args = safeRealloc(args, space*sizeof(NumExp));
+			}
+			args[argc++] = arg2;
+		}
+#line 1078 "grammar.c"
+continue;
+}
+LLtcnt[15]--;
+break;
+}
+LLtcnt[10]--;
+LL_SCANDONE(266);/* BRACKCLOSE */
+LLread();
+LLtcnt[9]--;
+LL_SCANDONE(265);/* BRACKOPEN */
+LLread();
+LLscnt[13]--;
+arg1 = LL17_numExp(LLthis);
+LLtcnt[10]--;
+LL_SCANDONE(266);/* BRACKCLOSE */
+#line 231 "grammar.g"
+{
+			name = ELEMENT;
+			args[0] = arg1;
+			argv = allocExpression(argc*sizeof(NumExp));
+			memcpy(argv, args, argc*sizeof(NumExp));
+			free(args);
+		}
+#line 1102 "grammar.c"
 break;
 }
-#line 204 "grammar.g"
+#line 238 "grammar.g"
 { LLretval = newFunctionCall(name,argc,argv); }
-#line 996 "grammar.c"
+#line 1107 "grammar.c"
 }
 return LLretval;
 }
 static VarList LL14_varlist(LLthisType *LLthis) {
-#line 207 "grammar.g"
+#line 241 "grammar.g"
 VarList
-#line 1003 "grammar.c"
+#line 1114 "grammar.c"
 LLretval;
-#line 168 "grammar.g"
+#line 170 "grammar.g"
 int
-#line 1007 "grammar.c"
+#line 1118 "grammar.c"
 v;
-#line 168 "grammar.g"
+#line 170 "grammar.g"
 int
-#line 1011 "grammar.c"
+#line 1122 "grammar.c"
 v2;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&v, 0, sizeof(v));
 memset(&v2, 0, sizeof(v2));
 {
+#line 241 "grammar.g"
+ VarList last; 
+#line 1130 "grammar.c"
 LLtcnt[15]++;
 v = LL12_var(LLthis);
-#line 208 "grammar.g"
-{LLretval = newVarList(v, NULL);}
-#line 1021 "grammar.c"
+#line 242 "grammar.g"
+{LLretval = newVarList(v, NULL); last = LLretval;}
+#line 1135 "grammar.c"
 LLread();
 for (;;) {
 LL_0:
@@ -1034,9 +1148,9 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[16]--;
 v2 = LL12_var(LLthis);
-#line 209 "grammar.g"
-{addVar(LLretval, v2);}
-#line 1040 "grammar.c"
+#line 243 "grammar.g"
+{addVar(&last, v2);}
+#line 1154 "grammar.c"
 LLread();
 continue;
 }
@@ -1047,17 +1161,17 @@ break;
 return LLretval;
 }
 static void LL15_domainspec(LLthisType *LLthis,
-#line 212 "grammar.g"
+#line 246 "grammar.g"
 Problem p
-#line 1053 "grammar.c"
+#line 1167 "grammar.c"
 ) {
-#line 76 "grammar.g"
+#line 78 "grammar.g"
 IntegerSet
-#line 1057 "grammar.c"
+#line 1171 "grammar.c"
 d;
-#line 207 "grammar.g"
+#line 241 "grammar.g"
 VarList
-#line 1061 "grammar.c"
+#line 1175 "grammar.c"
 vl;
 memset(&d, 0, sizeof(d));
 memset(&vl, 0, sizeof(vl));
@@ -1070,31 +1184,31 @@ LL_SCANDONE(264);/* ARROWTOK */
 LLread();
 LLscnt[17]--;
 d = LL5_domain(LLthis);
-#line 213 "grammar.g"
+#line 247 "grammar.g"
 {
 		setDomainsOfVars(p, vl, d); 
 		freeVarList(vl); 
 		freeIntegerSet(d);
 	}
-#line 1080 "grammar.c"
+#line 1194 "grammar.c"
 }
 }
 static Constraint LL16_constraint(LLthisType *LLthis) {
-#line 220 "grammar.g"
+#line 254 "grammar.g"
 Constraint
-#line 1086 "grammar.c"
+#line 1200 "grammar.c"
 LLretval;
-#line 231 "grammar.g"
+#line 265 "grammar.g"
 NumExp
-#line 1090 "grammar.c"
+#line 1204 "grammar.c"
 e1;
-#line 231 "grammar.g"
+#line 265 "grammar.g"
 NumExp
-#line 1094 "grammar.c"
+#line 1208 "grammar.c"
 e2;
-#line 260 "grammar.g"
+#line 294 "grammar.g"
 RelOperator
-#line 1098 "grammar.c"
+#line 1212 "grammar.c"
 op;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&e1, 0, sizeof(e1));
@@ -1103,9 +1217,9 @@ memset(&op, 0, sizeof(op));
 {
 LLscnt[18]++;
 e1 = LL17_numExp(LLthis);
-#line 221 "grammar.g"
+#line 255 "grammar.g"
 {LLretval = newValConstraint(e1);}
-#line 1109 "grammar.c"
+#line 1223 "grammar.c"
 LL_0:
 switch (LLcsymb) {
 default:
@@ -1130,32 +1244,32 @@ op = LL21_relop(LLthis);
 LLread();
 LLscnt[13]--;
 e2 = LL17_numExp(LLthis);
-#line 224 "grammar.g"
+#line 258 "grammar.g"
 { 
 			setOperatorOfConstraint(LLretval, op); 
 			setSecondExp(LLretval, e2);
 		}
-#line 1139 "grammar.c"
+#line 1253 "grammar.c"
 }
 }
 return LLretval;
 }
 static NumExp LL17_numExp(LLthisType *LLthis) {
-#line 231 "grammar.g"
+#line 265 "grammar.g"
 NumExp
-#line 1147 "grammar.c"
+#line 1261 "grammar.c"
 LLretval;
-#line 236 "grammar.g"
+#line 270 "grammar.g"
 Term
-#line 1151 "grammar.c"
+#line 1265 "grammar.c"
 t1;
-#line 236 "grammar.g"
+#line 270 "grammar.g"
 Term
-#line 1155 "grammar.c"
+#line 1269 "grammar.c"
 t2;
-#line 274 "grammar.g"
+#line 308 "grammar.g"
 TermOperator
-#line 1159 "grammar.c"
+#line 1273 "grammar.c"
 op;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&t1, 0, sizeof(t1));
@@ -1164,15 +1278,16 @@ memset(&op, 0, sizeof(op));
 {
 LLscnt[19]++;
 t1 = LL18_term(LLthis);
-#line 232 "grammar.g"
+#line 266 "grammar.g"
 {LLretval = newNumExp(t1);}
-#line 1170 "grammar.c"
+#line 1284 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
 default:
 if (LLskip()) goto LL_0;
 break;
+case 10:/* BRACKCLOSE */
 case 15:/* COMMATOK */
 case 16:/* SEMITOK */
 case 18:/* ISTOK */
@@ -1191,9 +1306,9 @@ op = LL22_termop(LLthis);
 LLread();
 LLscnt[20]--;
 t2 = LL18_term(LLthis);
-#line 233 "grammar.g"
+#line 267 "grammar.g"
 {LLretval = addTerm(LLretval, op, t2);}
-#line 1197 "grammar.c"
+#line 1312 "grammar.c"
 continue;
 }
 LLscnt[19]--;
@@ -1203,21 +1318,21 @@ break;
 return LLretval;
 }
 static Term LL18_term(LLthisType *LLthis) {
-#line 236 "grammar.g"
+#line 270 "grammar.g"
 Term
-#line 1209 "grammar.c"
+#line 1324 "grammar.c"
 LLretval;
-#line 241 "grammar.g"
+#line 275 "grammar.g"
 Factor
-#line 1213 "grammar.c"
+#line 1328 "grammar.c"
 f;
-#line 280 "grammar.g"
+#line 314 "grammar.g"
 FactorOperator
-#line 1217 "grammar.c"
+#line 1332 "grammar.c"
 o;
-#line 241 "grammar.g"
+#line 275 "grammar.g"
 Factor
-#line 1221 "grammar.c"
+#line 1336 "grammar.c"
 f2;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&f, 0, sizeof(f));
@@ -1227,15 +1342,16 @@ memset(&f2, 0, sizeof(f2));
 LLscnt[22]++;
 LLscnt[21]++;
 f = LL19_factor(LLthis);
-#line 237 "grammar.g"
+#line 271 "grammar.g"
 {LLretval = newTerm(f);}
-#line 1233 "grammar.c"
+#line 1348 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
 default:
 if (LLskip()) goto LL_0;
 break;
+case 10:/* BRACKCLOSE */
 case 11:/* MINUSTOK */
 case 12:/* PLUSTOK */
 case 15:/* COMMATOK */
@@ -1256,9 +1372,9 @@ LLscnt[22]++;
 o = LL23_factorop(LLthis);
 LLread();
 f2 = LL19_factor(LLthis);
-#line 238 "grammar.g"
+#line 272 "grammar.g"
 { LLretval = addFactor(LLretval, o, f2); }
-#line 1262 "grammar.c"
+#line 1378 "grammar.c"
 continue;
 }
 LLscnt[21]--;
@@ -1268,17 +1384,17 @@ break;
 return LLretval;
 }
 static Factor LL19_factor(LLthisType *LLthis) {
-#line 241 "grammar.g"
+#line 275 "grammar.g"
 Factor
-#line 1274 "grammar.c"
+#line 1390 "grammar.c"
 LLretval;
-#line 241 "grammar.g"
+#line 275 "grammar.g"
 Factor
-#line 1278 "grammar.c"
+#line 1394 "grammar.c"
 f;
-#line 247 "grammar.g"
+#line 281 "grammar.g"
 Value
-#line 1282 "grammar.c"
+#line 1398 "grammar.c"
 v;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&f, 0, sizeof(f));
@@ -1291,6 +1407,7 @@ if (LLskip())
 goto LL_0;
 /*FALLTHROUGH*/
 case 5:/* ALLTOK */
+case 9:/* BRACKOPEN */
 case 26:/* PARENTOPEN */
 case 28:/* VARTOK */
 case 29:/* DECTOK */
@@ -1300,9 +1417,9 @@ case 33:/* ABSTOK */
 case 34:/* ANYTOK */
 LLscnt[22]--;
 v = LL20_value(LLthis);
-#line 242 "grammar.g"
+#line 276 "grammar.g"
 { LLretval = newValueFactor(v); }
-#line 1306 "grammar.c"
+#line 1423 "grammar.c"
 break;
 case 11:/* MINUSTOK */
 LLscnt[22]--;
@@ -1310,38 +1427,38 @@ LLscnt[22]++;
 LL_SCANDONE(267);/* MINUSTOK */
 LLread();
 f = LL19_factor(LLthis);
-#line 244 "grammar.g"
+#line 278 "grammar.g"
 { LLretval = newMinusFactor(f); }
-#line 1316 "grammar.c"
+#line 1433 "grammar.c"
 break;
 }
 }
 return LLretval;
 }
 static Value LL20_value(LLthisType *LLthis) {
-#line 247 "grammar.g"
+#line 281 "grammar.g"
 Value
-#line 1325 "grammar.c"
+#line 1442 "grammar.c"
 LLretval;
-#line 231 "grammar.g"
+#line 265 "grammar.g"
 NumExp
-#line 1329 "grammar.c"
+#line 1446 "grammar.c"
 exp;
-#line 241 "grammar.g"
+#line 275 "grammar.g"
 Factor
-#line 1333 "grammar.c"
+#line 1450 "grammar.c"
 f;
-#line 116 "grammar.g"
+#line 118 "grammar.g"
 int
-#line 1337 "grammar.c"
+#line 1454 "grammar.c"
 i;
-#line 172 "grammar.g"
+#line 174 "grammar.g"
 FunctionCall
-#line 1341 "grammar.c"
+#line 1458 "grammar.c"
 fc;
-#line 168 "grammar.g"
+#line 170 "grammar.g"
 int
-#line 1345 "grammar.c"
+#line 1462 "grammar.c"
 id;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&exp, 0, sizeof(exp));
@@ -1361,27 +1478,28 @@ goto LL_0;
 case 29:/* DECTOK */
 LLscnt[23]--;
 i = LL7_integer(LLthis);
-#line 249 "grammar.g"
+#line 283 "grammar.g"
 { LLretval = newIntVal(i); }
-#line 1367 "grammar.c"
+#line 1484 "grammar.c"
 break;
 case 28:/* VARTOK */
 LLscnt[23]--;
 id = LL12_var(LLthis);
-#line 251 "grammar.g"
+#line 285 "grammar.g"
 { LLretval = newVarVal(id); }
-#line 1374 "grammar.c"
+#line 1491 "grammar.c"
 break;
 case 5:/* ALLTOK */
+case 9:/* BRACKOPEN */
 case 31:/* MAXTOK */
 case 32:/* MINTOK */
 case 33:/* ABSTOK */
 case 34:/* ANYTOK */
 LLscnt[23]--;
 fc = LL13_functioncall(LLthis);
-#line 253 "grammar.g"
+#line 287 "grammar.g"
 { LLretval = newFuncVal(fc); }
-#line 1385 "grammar.c"
+#line 1503 "grammar.c"
 break;
 case 26:/* PARENTOPEN */
 LLscnt[23]--;
@@ -1393,9 +1511,9 @@ LLscnt[13]--;
 exp = LL17_numExp(LLthis);
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
-#line 255 "grammar.g"
+#line 289 "grammar.g"
 { LLretval = newNumExpVal(exp); }
-#line 1399 "grammar.c"
+#line 1517 "grammar.c"
 break;
 }
 LLread();
@@ -1405,6 +1523,7 @@ default:
 if (LLskip()) goto LL_1;
 LLtcnt[14]--;
 break;
+case 10:/* BRACKCLOSE */
 case 11:/* MINUSTOK */
 case 12:/* PLUSTOK */
 case 13:/* STARTOK */
@@ -1427,17 +1546,17 @@ LLscnt[22]++;
 LL_SCANDONE(270);/* POWTOK */
 LLread();
 f = LL19_factor(LLthis);
-#line 257 "grammar.g"
+#line 291 "grammar.g"
 {LLretval->exponent = f;}
-#line 1433 "grammar.c"
+#line 1552 "grammar.c"
 }
 }
 return LLretval;
 }
 static RelOperator LL21_relop(LLthisType *LLthis) {
-#line 260 "grammar.g"
+#line 294 "grammar.g"
 RelOperator
-#line 1441 "grammar.c"
+#line 1560 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
@@ -1450,53 +1569,53 @@ goto LL_0;
 case 18:/* ISTOK */
 LLscnt[18]--;
 LL_SCANDONE(274);/* ISTOK */
-#line 261 "grammar.g"
+#line 295 "grammar.g"
 { LLretval = IS; }
-#line 1456 "grammar.c"
+#line 1575 "grammar.c"
 break;
 case 19:/* SMALLERTOK */
 LLscnt[18]--;
 LL_SCANDONE(275);/* SMALLERTOK */
-#line 263 "grammar.g"
+#line 297 "grammar.g"
 { LLretval = SMALLER; }
-#line 1463 "grammar.c"
+#line 1582 "grammar.c"
 break;
 case 20:/* GREATERTOK */
 LLscnt[18]--;
 LL_SCANDONE(276);/* GREATERTOK */
-#line 265 "grammar.g"
+#line 299 "grammar.g"
 { LLretval = GREATER; }
-#line 1470 "grammar.c"
+#line 1589 "grammar.c"
 break;
 case 21:/* NEQTOK */
 LLscnt[18]--;
 LL_SCANDONE(277);/* NEQTOK */
-#line 267 "grammar.g"
+#line 301 "grammar.g"
 { LLretval = NEQ; }
-#line 1477 "grammar.c"
+#line 1596 "grammar.c"
 break;
 case 22:/* LEQTOK */
 LLscnt[18]--;
 LL_SCANDONE(278);/* LEQTOK */
-#line 269 "grammar.g"
+#line 303 "grammar.g"
 { LLretval = LEQ; }
-#line 1484 "grammar.c"
+#line 1603 "grammar.c"
 break;
 case 23:/* GEQTOK */
 LLscnt[18]--;
 LL_SCANDONE(279);/* GEQTOK */
-#line 271 "grammar.g"
+#line 305 "grammar.g"
 { LLretval = GEQ; }
-#line 1491 "grammar.c"
+#line 1610 "grammar.c"
 break;
 }
 }
 return LLretval;
 }
 static TermOperator LL22_termop(LLthisType *LLthis) {
-#line 274 "grammar.g"
+#line 308 "grammar.g"
 TermOperator
-#line 1500 "grammar.c"
+#line 1619 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
@@ -1509,25 +1628,25 @@ goto LL_0;
 case 11:/* MINUSTOK */
 LLscnt[19]--;
 LL_SCANDONE(267);/* MINUSTOK */
-#line 275 "grammar.g"
+#line 309 "grammar.g"
 {LLretval = MINUS;}
-#line 1515 "grammar.c"
+#line 1634 "grammar.c"
 break;
 case 12:/* PLUSTOK */
 LLscnt[19]--;
 LL_SCANDONE(268);/* PLUSTOK */
-#line 277 "grammar.g"
+#line 311 "grammar.g"
 {LLretval = PLUS;}
-#line 1522 "grammar.c"
+#line 1641 "grammar.c"
 break;
 }
 }
 return LLretval;
 }
 static FactorOperator LL23_factorop(LLthisType *LLthis) {
-#line 280 "grammar.g"
+#line 314 "grammar.g"
 FactorOperator
-#line 1531 "grammar.c"
+#line 1650 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
@@ -1540,23 +1659,23 @@ goto LL_0;
 case 13:/* STARTOK */
 LLscnt[21]--;
 LL_SCANDONE(269);/* STARTOK */
-#line 281 "grammar.g"
+#line 315 "grammar.g"
 { LLretval = MUL; }
-#line 1546 "grammar.c"
+#line 1665 "grammar.c"
 break;
 case 24:/* MODTOK */
 LLscnt[21]--;
 LL_SCANDONE(280);/* MODTOK */
-#line 283 "grammar.g"
+#line 317 "grammar.g"
 { LLretval = MOD; }
-#line 1553 "grammar.c"
+#line 1672 "grammar.c"
 break;
 case 25:/* DIVTOK */
 LLscnt[21]--;
 LL_SCANDONE(281);/* DIVTOK */
-#line 285 "grammar.g"
+#line 319 "grammar.g"
 { LLretval = DIV; }
-#line 1560 "grammar.c"
+#line 1679 "grammar.c"
 break;
 }
 }
@@ -1577,4 +1696,16 @@ void parser(Problem LLuserData, Problem *LLretval) {
 	LLread(&LLthis);
 	if (LLthis.LLcsymb_ != 0) LLerror(&LLthis, 256 /* EOFILE*/);
 }
-
+void constraintParser(Problem LLuserData, Constraint *LLretval) {
+	LLthisType LLthis;
+	memset(LLthis.LLscnt_, 0, LL_NSETS * sizeof(int));
+	memset(LLthis.LLtcnt_, 0, LL_NTERMINALS * sizeof(int));
+	LLthis.LLtcnt_[0]++;
+	LLthis.LLdata_ = LLuserData;
+	LLthis.LLsymb_ = 0;
+	LLthis.LLreissue_ = -2 /* LL_NEW_TOKEN */;
+	LLread(&LLthis);
+	*LLretval = LL16_constraint(&LLthis);
+	LLread(&LLthis);
+	if (LLthis.LLcsymb_ != 0) LLerror(&LLthis, 256 /* EOFILE*/);
+}
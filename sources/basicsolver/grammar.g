@@ -1,4 +1,5 @@
 %start parser, problem;
+%start constraintParser, constraint;
 %token	VARSTOK, DOMAINSTOK, CONSTRAINTSTOK, SOLVETOK, ALLTOK, 
 	INTTYPE, BOOLTYPE, ARROWTOK,
 	BRACKOPEN, BRACKCLOSE, MINUSTOK, PLUSTOK, STARTOK, POWTOK, COMMATOK,
@@ -14,6 +15,7 @@
 	#include <stdio.h>
 	#include <stdlib.h>
 	#include <assert.h>
+	#include <string.h>
 	#include "datatypes.h"
 	#include "problem.h"
 	#include "variable.h"
@@ -24,7 +26,7 @@
 	extern int lineNr;
 	void LLmessage(struct LLthis *llthis, int token) {
 		printf("Parse error: line %d, unexpected token %s\n", lineNr, yytext);
-		exit(EXIT_FAILURE);
+		loadFailed(EXIT_FAILURE);
 	}
 }
 problem<Problem>	:	
@@ -46,12 +48,12 @@ body(Problem *p) :
 	}
 ;
 
-vars<VarList>{ LLretval = NULL; } : 
+vars<VarList>{ VarList last = NULL; LLretval = NULL; } : 
 	VARSTOK COLONTOK 
 	[	
 		varlist<l> 
 		COLONTOK 
-		datatype<t>	{ LLretval = addVars(LLretval, t, l);} 
+		datatype<t>	{ LLretval = addVars(LLretval, &last, t, l);} 
 		SEMITOK
 	]*
 ;	
@@ -126,27 +128,27 @@ negposint<int> {int mult = 1;}:
 	}
 ;
 	
-constraints<ConstraintList>	: 
+constraints<ConstraintList> { ConstraintList last = NULL; } : 
 	CONSTRAINTSTOK 
 	COLONTOK {
 		LLretval = NULL; 
 	}
 	[	
 		constraint<c> {
-			LLretval = addConstraint(LLretval, c); 
+			LLretval = addConstraint(LLretval, &last, c); 
 		}
 		SEMITOK
 	]*
 ;
 		
-constraintlist<ConstraintList> : 
+constraintlist<ConstraintList> { ConstraintList last = NULL; } : 
 	constraint<c> { 
-		LLretval = addConstraint(NULL, c); 
+		LLretval = addConstraint(NULL, &last, c); 
 	}
 	[	
 		COMMATOK
 		constraint<c> { 
-			LLretval = addConstraint(LLretval, c); 
+			LLretval = addConstraint(LLretval, &last, c); 
 		}
 	]*
 ;	
@@ -169,16 +171,27 @@ var<int> :
 	VARTOK integer<LLretval>
 ;
 	
-functioncall<FunctionCall>	{ int argc; FunctionName name; void *argv; } :	
+functioncall<FunctionCall>	{ int argc, space; FunctionName name; void *argv; NumExp *args; } :	
 	[	
 		[MAXTOK {name = MAX;} | MINTOK {name = MIN;}]
-		PARENTOPEN numExp<arg1> COMMATOK numExp<arg2> 
-		PARENTCLOSE {	
-			argc = 2; 
-			NumExp *ar = safeMalloc(argc*sizeof(NumExp));
-			ar[0] = arg1;
-			ar[1] = arg2;
-			argv = ar;
+		PARENTOPEN numExp<arg1> COMMATOK numExp<arg2> {
+			argc = 2;
+			space = 4;
+			args = safeMalloc(space*sizeof(NumExp));
+			args[0] = arg1;
+			args[1] = arg2;
+		}
+		[ COMMATOK numExp<arg2> {
+			if(argc == space) {
+				space *= 2;
+				args = safeRealloc(args, space*sizeof(NumExp));
+			}
+			args[argc++] = arg2;
+		} ]*
+		PARENTCLOSE {
+			argv = allocExpression(argc*sizeof(NumExp));
+			memcpy(argv, args, argc*sizeof(NumExp));
+			free(args);
 		}
 	|	
 		ABSTOK 
@@ -187,7 +200,7 @@ functioncall<FunctionCall>	{ int argc; FunctionName name; void *argv; } :
 		PARENTCLOSE {
 			name = ABS; 
 			argc = 1;
-			NumExp *ar = safeMalloc(argc*sizeof(NumExp));
+			NumExp *ar = allocExpression(argc*sizeof(NumExp));
 			ar[0] = arg1;
 			argv = ar;
 		}
@@ -197,16 +210,37 @@ functioncall<FunctionCall>	{ int argc; FunctionName name; void *argv; } :
 		PARENTCLOSE {
 			argc = 1;
 			ConstraintList *p;
-			p = safeMalloc(argc*sizeof(ConstraintList));
+			p = allocExpression(argc*sizeof(ConstraintList));
 			p[0] = l;
 			argv = p;
 		}
+	|
+		BRACKOPEN numExp<arg1> {
+			argc = 2;
+			space = 4;
+			args = safeMalloc(space*sizeof(NumExp));
+			args[1] = arg1;
+		}
+		[ COMMATOK numExp<arg2> {
+			if(argc == space) {
+				space *= 2;
+				args = safeRealloc(args, space*sizeof(NumExp));
+			}
+			args[argc++] = arg2;
+		} ]*
+		BRACKCLOSE BRACKOPEN numExp<arg1> BRACKCLOSE {
+			name = ELEMENT;
+			args[0] = arg1;
+			argv = allocExpression(argc*sizeof(NumExp));
+			memcpy(argv, args, argc*sizeof(NumExp));
+			free(args);
+		}
 	] { LLretval = newFunctionCall(name,argc,argv); }
 ;
 	
-varlist<VarList> : 
-	var<v>	{LLretval = newVarList(v, NULL);}
-	[ COMMATOK var<v2> {addVar(LLretval, v2);} ]* 
+varlist<VarList> { VarList last; } : 
+	var<v>	{LLretval = newVarList(v, NULL); last = LLretval;}
+	[ COMMATOK var<v2> {addVar(&last, v2);} ]* 
 ;	
 	
 domainspec(Problem p)	: 
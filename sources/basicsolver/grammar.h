@@ -57,5 +57,6 @@ struct LLthis {
 #define LLdata (LLthis->LLdata_)
 #define LLreissue (LLthis->LLreissue_)
 void parser(Problem LLuserData, Problem *LLretval);
+void constraintParser(Problem LLuserData, Constraint *LLretval);
 const char *LLgetSymbol(int);
 #endif
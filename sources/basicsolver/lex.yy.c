@@ -517,12 +517,15 @@ char *yytext;
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "grammar.h"
 
 int lineNr = 1;
 static int lastNewLine = 0;
 static int chars = 0;
 static int col = 0;
+/* the input if a string is scanned instead of a file */
+static const char *scannedString = NULL;
 
 static void showtoken() {
   	printf ("|%s| ", yytext);
@@ -539,7 +542,7 @@ static int getLength (int number){
 
 static void newLine() {
   	lineNr++;
-  	lastNewLine = chars+1;
+  	lastNewLine = chars;
   	col = 0;
 }
 
@@ -555,19 +558,25 @@ static int acceptToken(int token) {
 
 static void printError(){
 	fprintf(stderr, "\nError in line %d: ", lineNr);
-	fseek(yyin, lastNewLine, SEEK_SET);
 	int i = 1;
 	char line[200];
-	fprintf(stderr, "%s", fgets(line, 200, yyin));
-	for(i=0; i<col+(15)+getLength(lineNr); i++){
+	if(scannedString != NULL) {
+		/* only the line with the error, the string can be a whole request */
+		const char *start = scannedString + lastNewLine;
+		fprintf(stderr, "%.*s\n", (int) strcspn(start, "\n"), start);
+	} else {
+		fseek(yyin, lastNewLine, SEEK_SET);
+		fprintf(stderr, "%s", fgets(line, 200, yyin));
+	}
+	for(i=0; i<col+(16)+getLength(lineNr); i++){
 		fprintf(stderr,  " ");
 	}
 	fprintf(stderr, "^\n");
 	fprintf(stderr, "Illegal character (%s) detected at column %d.\n", yytext, col+1);
-	exit(-1);
+	loadFailed(-1);
 }
 
-#line 571 "lex.yy.c"
+#line 580 "lex.yy.c"
 
 #define INITIAL 0
 
@@ -776,10 +785,10 @@ YY_DECL
 		}
 
 	{
-#line 67 "flex.fl"
+#line 76 "flex.fl"
 
 
-#line 783 "lex.yy.c"
+#line 792 "lex.yy.c"
 
 	while ( 1 )		/* loops until end-of-file is reached */
 		{
@@ -838,201 +847,201 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 69 "flex.fl"
+#line 78 "flex.fl"
 { column(yyleng); }
 	YY_BREAK
 case 2:
 /* rule 2 can match eol */
 YY_RULE_SETUP
-#line 71 "flex.fl"
+#line 80 "flex.fl"
 { column(yyleng); newLine(); }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 73 "flex.fl"
+#line 82 "flex.fl"
 { return acceptToken(VARSTOK); }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 74 "flex.fl"
+#line 83 "flex.fl"
 { return acceptToken(INTTYPE); }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 75 "flex.fl"
+#line 84 "flex.fl"
 { return acceptToken(BOOLTYPE); }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 76 "flex.fl"
+#line 85 "flex.fl"
 { return acceptToken(DOMAINSTOK); }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 77 "flex.fl"
+#line 86 "flex.fl"
 { return acceptToken(CONSTRAINTSTOK); }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 78 "flex.fl"
+#line 87 "flex.fl"
 { return acceptToken(SOLVETOK); }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 79 "flex.fl"
+#line 88 "flex.fl"
 { return acceptToken(RANGETOK); }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 81 "flex.fl"
+#line 90 "flex.fl"
 { return acceptToken(BRACKOPEN); }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 82 "flex.fl"
+#line 91 "flex.fl"
 { return acceptToken(BRACKCLOSE); }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 83 "flex.fl"
+#line 92 "flex.fl"
 { return acceptToken(MINUSTOK); }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 84 "flex.fl"
+#line 93 "flex.fl"
 { return acceptToken(PLUSTOK); }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 85 "flex.fl"
+#line 94 "flex.fl"
 { return acceptToken(STARTOK); }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 86 "flex.fl"
+#line 95 "flex.fl"
 { return acceptToken(POWTOK); }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 87 "flex.fl"
+#line 96 "flex.fl"
 { return acceptToken(COMMATOK); }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 88 "flex.fl"
+#line 97 "flex.fl"
 { return acceptToken(SEMITOK); }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 89 "flex.fl"
+#line 98 "flex.fl"
 { return acceptToken(COLONTOK); }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 90 "flex.fl"
+#line 99 "flex.fl"
 { return acceptToken(ISTOK); }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 91 "flex.fl"
+#line 100 "flex.fl"
 { return acceptToken(SMALLERTOK); }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 92 "flex.fl"
+#line 101 "flex.fl"
 { return acceptToken(GREATERTOK); }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 93 "flex.fl"
+#line 102 "flex.fl"
 { return acceptToken(NEQTOK); }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 94 "flex.fl"
+#line 103 "flex.fl"
 { return acceptToken(LEQTOK); }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 95 "flex.fl"
+#line 104 "flex.fl"
 { return acceptToken(GEQTOK); }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 96 "flex.fl"
+#line 105 "flex.fl"
 { return acceptToken(MODTOK); }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 97 "flex.fl"
+#line 106 "flex.fl"
 { return acceptToken(DIVTOK); }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 98 "flex.fl"
+#line 107 "flex.fl"
 { return acceptToken(ABSTOK); }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 99 "flex.fl"
+#line 108 "flex.fl"
 { return acceptToken(MAXTOK); }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 100 "flex.fl"
+#line 109 "flex.fl"
 { return acceptToken(MINTOK); }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 101 "flex.fl"
+#line 110 "flex.fl"
 { return acceptToken(ANYTOK); }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 102 "flex.fl"
+#line 111 "flex.fl"
 { return acceptToken(ALLTOK); }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 103 "flex.fl"
+#line 112 "flex.fl"
 { return acceptToken(PARENTOPEN); }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 104 "flex.fl"
+#line 113 "flex.fl"
 { return acceptToken(PARENTCLOSE); }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 105 "flex.fl"
+#line 114 "flex.fl"
 { return acceptToken(ARROWTOK); }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 107 "flex.fl"
+#line 116 "flex.fl"
 { return acceptToken(VARTOK); }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 108 "flex.fl"
+#line 117 "flex.fl"
 { return acceptToken(DECTOK); }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 109 "flex.fl"
+#line 118 "flex.fl"
 { column(yyleng); }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 111 "flex.fl"
+#line 120 "flex.fl"
 { printError(); }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 112 "flex.fl"
+#line 121 "flex.fl"
 ECHO;
 	YY_BREAK
-#line 1036 "lex.yy.c"
+#line 1045 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2027,9 +2036,34 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 112 "flex.fl"
+#line 121 "flex.fl"
 
 
+/* prepares the scanner for a new input file */
+void resetLexer(FILE *input) {
+	lineNr = 1;
+	lastNewLine = 0;
+	chars = 0;
+	col = 0;
+	scannedString = NULL;
+	yyrestart(input);
+}
 
+/* prepares the scanner for scanning str, until endScanString is called */
+void scanString(const char *str) {
+	lineNr = 1;
+	lastNewLine = 0;
+	chars = 0;
+	col = 0;
+	scannedString = str;
+	if(YY_CURRENT_BUFFER != NULL) {
+		yy_delete_buffer(YY_CURRENT_BUFFER);
+	}
+	yy_scan_string(str);
+}
 
+void endScanString() {
+	yy_delete_buffer(YY_CURRENT_BUFFER);
+	scannedString = NULL;
+}
 
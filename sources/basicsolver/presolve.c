@@ -0,0 +1,737 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "variable.h"
+#include "constraint.h"
+#include "binary.h"
+#include "presolve.h"
+
+/* called for every value that is not an expression or function call */
+typedef int (*ValueRewrite)(Value v, void *arg);
+
+static int rewriteNumExp(NumExp exp, ValueRewrite rewrite, void *arg);
+
+/* new parts of the expressions of c come from the arena of c */
+static int rewriteConstraint(Constraint c, ValueRewrite rewrite, void *arg) {
+	Arena previous = setExpressionArena(c->arena);
+	int changed = rewriteNumExp(firstExp(c), rewrite, arg);
+	if(secondExp(c) != NULL) {
+		changed |= rewriteNumExp(secondExp(c), rewrite, arg);
+	}
+	setExpressionArena(previous);
+	return changed;
+}
+
+static int rewriteFactor(Factor f, ValueRewrite rewrite, void *arg);
+
+static int rewriteValue(Value v, ValueRewrite rewrite, void *arg) {
+	int changed = 0, i;
+	if(v->type == NUMEXP) {
+		changed = rewriteNumExp(v->data.numexp, rewrite, arg);
+	} else if(v->type == FUNCVAL) {
+		if(v->data.funcCall->name == ANY || v->data.funcCall->name == ALL) {
+			ConstraintList *lists = v->data.funcCall->argv;
+			ConstraintList l;
+			for(l = lists[0]; l != NULL; l = l->next) {
+				changed |= rewriteConstraint(l->constraint, rewrite, arg);
+			}
+		} else {
+			NumExp *numExps = v->data.funcCall->argv;
+			for(i = 0; i < v->data.funcCall->argc; i++) {
+				changed |= rewriteNumExp(numExps[i], rewrite, arg);
+			}
+		}
+	} else {
+		changed = rewrite(v, arg);
+	}
+	if(v->exponent != NULL) {
+		changed |= rewriteFactor(v->exponent, rewrite, arg);
+	}
+	return changed;
+}
+
+static int rewriteFactor(Factor f, ValueRewrite rewrite, void *arg) {
+	if(f->type == NUMNEG) {
+		return rewriteFactor(f->data.factor, rewrite, arg);
+	}
+	return rewriteValue(f->data.value, rewrite, arg);
+}
+
+static int rewriteTerm(Term t, ValueRewrite rewrite, void *arg) {
+	if(t->next == NULL) {
+		return rewriteFactor(t->data, rewrite, arg);
+	}
+	return rewriteTerm(t->data, rewrite, arg) | rewriteTerm(t->next, rewrite, arg);
+}
+
+static int rewriteNumExp(NumExp exp, ValueRewrite rewrite, void *arg) {
+	if(exp->next == NULL) {
+		return rewriteTerm(exp->data, rewrite, arg);
+	}
+	return rewriteNumExp(exp->data, rewrite, arg) | rewriteNumExp(exp->next, rewrite, arg);
+}
+
+static int isVariable(Value v, void *arg) {
+	return (v->type == VARVAL);
+}
+
+/* replaces variables with a single value by that value */
+static int substituteFixed(Value v, void *arg) {
+	Problem q = arg;
+	Variable var;
+	if(v->type != VARVAL) {
+		return 0;
+	}
+	var = varByIndex(q, v->data.varIndex);
+	if(!singletonDomain(domainOfVar(var))) {
+		return 0;
+	}
+	v->type = INTVAL;
+	v->data.intval = domainMinimumOfVar(var);
+	return 1;
+}
+
+/* X = Y + offset */
+typedef struct alias {
+	int var;
+	int base;
+	int offset;
+} alias;
+
+static NumExp offsetExp(int var, int offset) {
+	NumExp exp = newNumExp(newTerm(newValueFactor(newVarVal(var))));
+	return addTerm(exp, (offset < 0 ? MINUS : PLUS), newTerm(newValueFactor(newIntVal(abs(offset)))));
+}
+
+static int substituteAlias(Value v, void *arg) {
+	alias *a = arg;
+	if(v->type != VARVAL || v->data.varIndex != a->var) {
+		return 0;
+	}
+	if(a->offset == 0) {
+		v->data.varIndex = a->base;
+	} else {
+		v->type = NUMEXP;
+		v->data.numexp = offsetExp(a->base, a->offset);
+	}
+	return 1;
+}
+
+static int renumberVar(Value v, void *arg) {
+	int *newIndex = arg;
+	if(v->type == VARVAL) {
+		v->data.varIndex = newIndex[v->data.varIndex];
+	}
+	return 0;
+}
+
+/* rebuilds the variable set of c after its expressions have been rewritten */
+static void relinkConstraint(Problem q, Constraint c) {
+	freeIntegerSet(c->vars);
+	c->vars = emptyIntegerSet();
+	linkConstraint(q, c);
+}
+
+
+/*
+  Interval of the values an expression can take, given the domains. Unknown
+  if it can not be bounded cheaply, or if the evaluation might overflow.
+*/
+typedef struct bounds {
+	long long min, max;
+	int known;
+} bounds;
+
+static bounds unknownBounds() {
+	bounds b = {0, 0, 0};
+	return b;
+}
+
+static bounds knownBounds(long long min, long long max) {
+	bounds b = {min, max, 1};
+	if(min < INT_MIN || max > INT_MAX) {
+		return unknownBounds();
+	}
+	return b;
+}
+
+static int exact(bounds b) {
+	return (b.known && b.min == b.max);
+}
+
+static bounds boundsOfExp(NumExp exp, Problem q);
+
+static bounds boundsOfFactor(Factor f, Problem q);
+
+/* the entries that the (clamped) index of an element can select */
+static bounds boundsOfElement(FunctionCall fc, Problem q) {
+	NumExp *numExps = fc->argv;
+	bounds index = boundsOfExp(numExps[0], q), a, b;
+	int first = 0, last = fc->argc-2, i;
+	if(index.known) {
+		first = (index.min < 0 ? 0 : (index.min > last ? last : index.min));
+		last = (index.max < first ? first : (index.max > last ? last : index.max));
+	}
+	a = boundsOfExp(numExps[first+1], q);
+	for(i = first+1; a.known && i <= last; i++) {
+		b = boundsOfExp(numExps[i+1], q);
+		if(!b.known) {
+			return b;
+		}
+		a = knownBounds((a.min < b.min ? a.min : b.min), (a.max > b.max ? a.max : b.max));
+	}
+	return a;
+}
+
+static bounds boundsOfFuncCall(FunctionCall fc, Problem q) {
+	NumExp *numExps = fc->argv;
+	bounds a, b;
+	int i;
+	if(fc->name == ANY || fc->name == ALL) {
+		return knownBounds(0, 1);
+	}
+	if(fc->name == ELEMENT) {
+		return boundsOfElement(fc, q);
+	}
+	a = boundsOfExp(numExps[0], q);
+	if(!a.known) {
+		return a;
+	}
+	if(fc->name == ABS) {
+		if(a.min >= 0) {
+			return a;
+		}
+		if(a.max <= 0) {
+			return knownBounds(-a.max, -a.min);
+		}
+		return knownBounds(0, (-a.min > a.max ? -a.min : a.max));
+	}
+	for(i = 1; i < fc->argc; i++) {
+		b = boundsOfExp(numExps[i], q);
+		if(!b.known) {
+			return b;
+		}
+		if(fc->name == MAX) {
+			a = knownBounds((a.min > b.min ? a.min : b.min), (a.max > b.max ? a.max : b.max));
+		} else {
+			a = knownBounds((a.min < b.min ? a.min : b.min), (a.max < b.max ? a.max : b.max));
+		}
+	}
+	return a;
+}
+
+static bounds boundsOfValue(Value v, Problem q) {
+	bounds b, e;
+	if(v->type == VARVAL) {
+		IntegerSet domain = domainOfVar(varByIndex(q, v->data.varIndex));
+		b = knownBounds(minimumOfSet(domain), maximumOfSet(domain));
+	} else if(v->type == NUMEXP) {
+		b = boundsOfExp(v->data.numexp, q);
+	} else if(v->type == FUNCVAL) {
+		b = boundsOfFuncCall(v->data.funcCall, q);
+	} else {
+		b = knownBounds(v->data.intval, v->data.intval);
+	}
+	if(v->exponent != NULL) {
+		/* only constant powers, computed as calcValue does */
+		e = boundsOfFactor(v->exponent, q);
+		if(!exact(b) || !exact(e) || (b.min == 0 && e.min < 0)) {
+			return unknownBounds();
+		}
+		return knownBounds(intPower(b.min, e.min), intPower(b.min, e.min));
+	}
+	return b;
+}
+
+static bounds boundsOfFactor(Factor f, Problem q) {
+	bounds b;
+	if(f->type == NUMNEG) {
+		b = boundsOfFactor(f->data.factor, q);
+		return (b.known ? knownBounds(-b.max, -b.min) : b);
+	}
+	return boundsOfValue(f->data.value, q);
+}
+
+static bounds boundsOfTerm(Term t, Problem q) {
+	bounds a, b;
+	long long corners[4], min, max;
+	int i;
+	if(t->next == NULL) {
+		return boundsOfFactor(t->data, q);
+	}
+	a = boundsOfTerm(t->data, q);
+	b = boundsOfTerm(t->next, q);
+	if(!a.known || !b.known) {
+		return unknownBounds();
+	}
+	if(t->factorop == MUL) {
+		corners[0] = a.min * b.min;
+		corners[1] = a.min * b.max;
+		corners[2] = a.max * b.min;
+		corners[3] = a.max * b.max;
+		min = max = corners[0];
+		for(i = 1; i < 4; i++) {
+			min = (corners[i] < min ? corners[i] : min);
+			max = (corners[i] > max ? corners[i] : max);
+		}
+		return knownBounds(min, max);
+	}
+	/* division and modulo only of constants, not by zero */
+	if(!exact(a) || !exact(b) || b.min == 0) {
+		return unknownBounds();
+	}
+	if(t->factorop == DIV) {
+		return knownBounds(a.min / b.min, a.min / b.min);
+	}
+	return knownBounds(a.min % b.min, a.min % b.min);
+}
+
+static bounds boundsOfExp(NumExp exp, Problem q) {
+	bounds a, b;
+	if(exp->next == NULL) {
+		return boundsOfTerm(exp->data, q);
+	}
+	a = boundsOfExp(exp->data, q);
+	b = boundsOfExp(exp->next, q);
+	if(!a.known || !b.known) {
+		return unknownBounds();
+	}
+	if(exp->termop == PLUS) {
+		return knownBounds(a.min + b.min, a.max + b.max);
+	}
+	return knownBounds(a.min - b.max, a.max - b.min);
+}
+
+/* 1 if c holds for all values within the bounds, 0 if for none, -1 if unknown */
+int decideConstraint(Constraint c, Problem q) {
+	bounds l = boundsOfExp(firstExp(c), q), r;
+	if(!l.known) {
+		return -1;
+	}
+	if(secondExp(c) == NULL) {
+		if(l.min > 0 || l.max < 0) {
+			return 1;
+		}
+		return (l.min == 0 && l.max == 0 ? 0 : -1);
+	}
+	r = boundsOfExp(secondExp(c), q);
+	if(!r.known) {
+		return -1;
+	}
+	switch(operatorOfConstraint(c)) {
+		case IS:
+			if(l.max < r.min || r.max < l.min) {
+				return 0;
+			}
+			return (exact(l) && exact(r) ? 1 : -1);
+		case NEQ:
+			if(l.max < r.min || r.max < l.min) {
+				return 1;
+			}
+			return (exact(l) && exact(r) ? 0 : -1);
+		case SMALLER:
+			return (l.max < r.min ? 1 : (l.min >= r.max ? 0 : -1));
+		case GREATER:
+			return (l.min > r.max ? 1 : (l.max <= r.min ? 0 : -1));
+		case LEQ:
+			return (l.max <= r.min ? 1 : (l.min > r.max ? 0 : -1));
+		default: /* GEQ */
+			return (l.min >= r.max ? 1 : (l.max < r.min ? 0 : -1));
+	}
+}
+
+
+/* strips parentheses: (E) is a value of a single factor of a single term */
+NumExp unwrapExp(NumExp exp) {
+	Term t;
+	Factor f;
+	while(exp->next == NULL) {
+		t = exp->data;
+		if(t->next != NULL) {
+			break;
+		}
+		f = t->data;
+		if(f->type != VALUE || f->data.value->type != NUMEXP || f->data.value->exponent != NULL) {
+			break;
+		}
+		exp = f->data.value->data.numexp;
+	}
+	return exp;
+}
+
+/* the variable of exp if it is just a variable, possibly in parentheses, -1 otherwise */
+static int plainVar(NumExp exp) {
+	return varOfNumExp(unwrapExp(exp));
+}
+
+static int constantExp(NumExp exp, Problem q, int *value) {
+	bounds b;
+	if(rewriteNumExp(exp, isVariable, NULL)) {
+		return 0;
+	}
+	b = boundsOfExp(exp, q);
+	if(!exact(b) || b.min == INT_MIN) {
+		return 0;
+	}
+	*value = b.min;
+	return 1;
+}
+
+/* matches exp against Y, Y + k, Y - k and k + Y for constant k */
+static int offsetVar(NumExp exp, Problem q, int *offset) {
+	int var = plainVar(exp);
+	if(var >= 0) {
+		*offset = 0;
+		return var;
+	}
+	exp = unwrapExp(exp);
+	if(exp->next == NULL) {
+		return -1;
+	}
+	var = plainVar(exp->data);
+	if(var >= 0 && constantExp(exp->next, q, offset)) {
+		if(exp->termop == MINUS) {
+			*offset = -*offset;
+		}
+		return var;
+	}
+	var = plainVar(exp->next);
+	if(var >= 0 && exp->termop == PLUS && constantExp(exp->data, q, offset)) {
+		return var;
+	}
+	return -1;
+}
+
+/* recognizes c as X = Y + k, with X and Y different variables */
+static int findAlias(Constraint c, Problem q, alias *a) {
+	if(secondExp(c) == NULL || operatorOfConstraint(c) != IS) {
+		return 0;
+	}
+	a->var = plainVar(firstExp(c));
+	if(a->var >= 0) {
+		a->base = offsetVar(secondExp(c), q, &a->offset);
+		if(a->base >= 0 && a->base != a->var) {
+			return 1;
+		}
+	}
+	a->var = plainVar(secondExp(c));
+	if(a->var >= 0) {
+		a->base = offsetVar(firstExp(c), q, &a->offset);
+		if(a->base >= 0 && a->base != a->var) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* restricts the domain of Y to the values v with v + k in the domain of X */
+static int restrictBase(alias *a, Problem q) {
+	Variable var = varByIndex(q, a->var), base = varByIndex(q, a->base);
+	IntegerSet domain = domainOfVar(base), restricted = emptyIntegerSet();
+	int i;
+	for(i = 0; i < sizeOfSet(domain); i++) {
+		long long value = (long long) domain->values[i] + a->offset;
+		if(value >= INT_MIN && value <= INT_MAX && valueInSet(domainOfVar(var), value)) {
+			addIntegerToSet(restricted, domain->values[i]);
+		}
+	}
+	freeIntegerSet(domain);
+	setDomainOfVar(base, restricted);
+	return sizeOfSet(restricted);
+}
+
+/*
+  applies unary constraint c to the domain of its variable; both domains are
+  kept in pre meanwhile, for freePresolved when checking c fails
+*/
+static int restrictDomain(Presolved pre, Constraint c, Problem q) {
+	Variable var = varByIndex(q, c->vars->values[0]);
+	int *values, i, size;
+	pre->domain = domainOfVar(var);
+	pre->restricted = emptyIntegerSet();
+	values = valuesOfSet(pre->domain);
+	for(i = 0; i < sizeOfSet(pre->domain); i++) {
+		setDomainOfVar(var, createSingletonDomain(values[i]));
+		if(checkConstraint(c, q)) {
+			addIntegerToSet(pre->restricted, values[i]);
+		}
+		freeIntegerSet(domainOfVar(var));
+	}
+	freeIntegerSet(pre->domain);
+	setDomainOfVar(var, pre->restricted);
+	size = sizeOfSet(pre->restricted);
+	pre->domain = pre->restricted = NULL;
+	return size;
+}
+
+
+typedef struct constraintCode {
+	int index;
+	int length;
+	int *words;
+} constraintCode;
+
+static int compareCodes(const void *a, const void *b) {
+	const constraintCode *x = a, *y = b;
+	int order;
+	if(x->length != y->length) {
+		return (x->length < y->length ? -1 : 1);
+	}
+	order = memcmp(x->words, y->words, x->length*sizeof(int));
+	if(order != 0) {
+		return order;
+	}
+	return x->index - y->index;
+}
+
+/* drops all but the first of constraints that are written the same */
+static void mergeDuplicates(Presolved pre, Constraint *constraints, int count) {
+	constraintCode *codes = safeMalloc(count*sizeof(constraintCode));
+	int i, n = 0;
+	for(i = 0; i < count; i++) {
+		if(constraints[i] != NULL) {
+			codes[n].index = i;
+			codes[n].words = encodeConstraintCode(constraints[i], &codes[n].length);
+			n++;
+		}
+	}
+	qsort(codes, n, sizeof(constraintCode), compareCodes);
+	for(i = 1; i < n; i++) {
+		if(codes[i].length == codes[i-1].length &&
+		   !memcmp(codes[i].words, codes[i-1].words, codes[i].length*sizeof(int))) {
+			freeConstraint(constraints[codes[i].index]);
+			constraints[codes[i].index] = NULL;
+			pre->duplicateConstraints++;
+		}
+	}
+	for(i = 0; i < n; i++) {
+		free(codes[i].words);
+	}
+	free(codes);
+}
+
+static Problem copyProblem(Problem p) {
+	size_t size;
+	char *image = encodeBinaryProblem(p, &size);
+	Problem q = decodeBinaryProblem(image, size, "presolve");
+	free(image);
+	return q;
+}
+
+/*
+  Simplifies the constraints of q until nothing changes, records aliases
+  in aliasOf. Returns 0 if q has no solution.
+*/
+static int simplify(Presolved pre, Problem q, int *aliasOf, int *aliasOffset) {
+	Constraint c;
+	alias a;
+	int i, j, changed = 1;
+	for(i = 0; i < q->varCount; i++) {
+		if(sizeOfSet(domainOfVar(varByIndex(q, i))) == 0) {
+			return 0;
+		}
+	}
+	while(changed) {
+		changed = 0;
+		for(i = 0; i < q->constraintCount; i++) {
+			c = q->constraints[i];
+			if(c == NULL) {
+				continue;
+			}
+			if(rewriteConstraint(c, substituteFixed, q)) {
+				relinkConstraint(q, c);
+			}
+			if(arityOfConstraint(c) == 0) {
+				if(!checkConstraint(c, q)) {
+					return 0;
+				}
+				pre->entailedConstraints++;
+			} else if(arityOfConstraint(c) == 1) {
+				int size = restrictDomain(pre, c, q);
+				if(size == 0) {
+					return 0;
+				}
+				changed |= (size == 1);
+				pre->unaryConstraints++;
+			} else {
+				int decision = decideConstraint(c, q);
+				if(decision == 0) {
+					return 0;
+				}
+				if(decision == 1) {
+					pre->entailedConstraints++;
+				} else if(findAlias(c, q, &a)) {
+					int size = restrictBase(&a, q);
+					if(size == 0) {
+						return 0;
+					}
+					aliasOf[a.var] = a.base;
+					aliasOffset[a.var] = a.offset;
+					pre->aliasedVars++;
+					/* the defining constraint is dropped below, X disappears from the others */
+					for(j = 0; j < q->constraintCount; j++) {
+						if(j != i && q->constraints[j] != NULL &&
+						   rewriteConstraint(q->constraints[j], substituteAlias, &a)) {
+							relinkConstraint(q, q->constraints[j]);
+						}
+					}
+					changed = 1;
+				} else {
+					continue;
+				}
+			}
+			freeConstraint(c);
+			q->constraints[i] = NULL;
+		}
+	}
+	return 1;
+}
+
+/* builds the reduced problem from the variables and constraints left in q */
+static Problem reduceProblem(Presolved pre, Problem q, int *aliasOf, int *aliasOffset) {
+	Problem r = emptyProblem();
+	int *newIndex = safeMalloc(q->varCount*sizeof(int));
+	int i, j, k;
+
+	r->solvespec = q->solvespec;
+	for(i = 0; i < q->varCount; i++) {
+		Variable var = varByIndex(q, i);
+		newIndex[i] = -1;
+		pre->base[i] = -1;
+		pre->offset[i] = 0;
+		if(aliasOf[i] >= 0) {
+			continue;
+		}
+		if(singletonDomain(domainOfVar(var))) {
+			pre->offset[i] = domainMinimumOfVar(var);
+			pre->fixedVars++;
+		} else {
+			newIndex[i] = pre->base[i] = r->varCount++;
+		}
+	}
+	/* an alias takes the value of the end of its chain plus all offsets */
+	for(i = 0; i < q->varCount; i++) {
+		if(aliasOf[i] >= 0) {
+			k = 0;
+			for(j = i; aliasOf[j] >= 0; j = aliasOf[j]) {
+				k += aliasOffset[j];
+			}
+			pre->base[i] = pre->base[j];
+			pre->offset[i] = pre->offset[j] + k;
+		}
+	}
+
+	r->vars = safeMalloc(r->varCount*sizeof(Variable));
+	for(i = 0; i < q->varCount; i++) {
+		if(newIndex[i] >= 0) {
+			Variable var = newVariable(newIndex[i], dataTypeOfVar(varByIndex(q, i)));
+			setDomainOfVar(var, copyIntegerSet(domainOfVar(varByIndex(q, i))));
+			r->vars[newIndex[i]] = var;
+		}
+	}
+	r->constraints = safeMalloc(q->constraintCount*sizeof(Constraint));
+	for(i = 0; i < q->constraintCount; i++) {
+		Constraint c = q->constraints[i];
+		if(c != NULL) {
+			rewriteConstraint(c, renumberVar, newIndex);
+			freeIntegerSet(c->vars);
+			c->vars = emptyIntegerSet();
+			setIndexOfConstraint(c, r->constraintCount);
+			r->constraints[r->constraintCount++] = c;
+			q->constraints[i] = NULL;
+		}
+	}
+	/* the constraints moved to r, and their expressions with them */
+	r->arena = q->arena;
+	q->arena = NULL;
+	linkConstraintsAndVars(r);
+	free(newIndex);
+	return r;
+}
+
+/* frees what is left of the working copy q */
+static void freeCopy(Problem q) {
+	int i;
+	for(i = 0; i < q->constraintCount; i++) {
+		if(q->constraints[i] != NULL) {
+			freeConstraint(q->constraints[i]);
+		}
+	}
+	q->constraintCount = 0;
+	freeProblem(q);
+}
+
+Presolved newPresolved(Problem p) {
+	Presolved pre = safeCalloc(1, sizeof(presolved));
+	int i;
+
+	pre->copy = copyProblem(p);
+	pre->varCount = pre->copy->varCount;
+	pre->base = safeMalloc(pre->varCount*sizeof(int));
+	pre->offset = safeMalloc(pre->varCount*sizeof(int));
+	pre->aliasOf = safeMalloc(pre->varCount*sizeof(int));
+	pre->aliasOffset = safeMalloc(pre->varCount*sizeof(int));
+	for(i = 0; i < pre->varCount; i++) {
+		pre->aliasOf[i] = -1;
+	}
+	return pre;
+}
+
+/* the working copy is gone afterwards */
+static void freeWork(Presolved pre) {
+	if(pre->copy != NULL) {
+		freeCopy(pre->copy);
+		pre->copy = NULL;
+	}
+	free(pre->aliasOf);
+	free(pre->aliasOffset);
+	pre->aliasOf = pre->aliasOffset = NULL;
+	if(pre->domain != NULL) {
+		freeIntegerSet(pre->domain);
+		freeIntegerSet(pre->restricted);
+		pre->domain = pre->restricted = NULL;
+	}
+}
+
+void presolveProblem(Presolved pre) {
+	Problem q = pre->copy;
+	if(simplify(pre, q, pre->aliasOf, pre->aliasOffset)) {
+		mergeDuplicates(pre, q->constraints, q->constraintCount);
+		pre->problem = reduceProblem(pre, q, pre->aliasOf, pre->aliasOffset);
+	}
+	freeWork(pre);
+}
+
+/* computes the values of all original variables from a solution of the reduced problem */
+void expandSolution(Presolved pre, const int *reduced, int *values) {
+	int i;
+	for(i = 0; i < pre->varCount; i++) {
+		values[i] = pre->offset[i] + (pre->base[i] >= 0 ? reduced[pre->base[i]] : 0);
+	}
+}
+
+void printPresolveReport(FILE *out, Presolved pre) {
+	fprintf(out, "presolve: %d fixed and %d aliased variables removed, "
+	        "%d unary, %d entailed and %d duplicate constraints removed\n",
+	        pre->fixedVars, pre->aliasedVars, pre->unaryConstraints,
+	        pre->entailedConstraints, pre->duplicateConstraints);
+	if(pre->problem == NULL) {
+		fprintf(out, "presolve: the problem has no solution\n");
+	} else {
+		fprintf(out, "presolve: %d variables and %d constraints left\n",
+		        pre->problem->varCount, pre->problem->constraintCount);
+	}
+}
+
+void freePresolved(Presolved pre) {
+	freeWork(pre);
+	if(pre->problem != NULL) {
+		freeProblem(pre->problem);
+	}
+	free(pre->base);
+	free(pre->offset);
+	free(pre);
+}
@@ -0,0 +1,58 @@
+#ifndef PRESOLVE_H
+#define PRESOLVE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "problem.h"
+
+/*
+ * Presolve, enabled with -presolve: before the search the problem is
+ * replaced by a smaller problem with the same solutions.
+ *
+ *  - unary constraints are applied to the domain of their variable and
+ *    dropped; variables with a single value become constants
+ *  - a variable defined by an equality X = Y, X = Y + k or X = Y - k is
+ *    replaced by Y + k everywhere (a view of Y), the domain of Y is
+ *    restricted to the values that X allows
+ *  - constraints that hold for every value within the bounds of their
+ *    expressions are dropped
+ *  - duplicate constraints are merged
+ *  - the remaining variables are numbered densely
+ *
+ * This is repeated until nothing changes. The original problem is not
+ * changed; a solution of the reduced problem is mapped back to the values
+ * of all original variables with expandSolution.
+ *
+ * newPresolved makes the working copy that presolveProblem reduces. When
+ * presolving fails on an error, see solveFailed, freePresolved also frees
+ * what is left of the copy.
+ */
+
+typedef struct presolved *Presolved;
+
+typedef struct presolved {
+	Problem problem;			/* reduced problem, NULL if there is no solution */
+	int varCount;				/* variables of the original problem */
+	int *base;					/* per original variable: its reduced variable, -1 if fixed */
+	int *offset;				/* value is the value of base plus offset */
+	int fixedVars;				/* what was removed */
+	int aliasedVars;
+	int unaryConstraints;
+	int entailedConstraints;
+	int duplicateConstraints;
+	Problem copy;				/* working copy while presolving */
+	int *aliasOf;
+	int *aliasOffset;
+	IntegerSet domain;			/* while restricting a domain */
+	IntegerSet restricted;
+} presolved;
+
+Presolved newPresolved(Problem p);
+void presolveProblem(Presolved pre);
+int decideConstraint(Constraint c, Problem q);
+NumExp unwrapExp(NumExp exp);
+void expandSolution(Presolved pre, const int *reduced, int *values);
+void printPresolveReport(FILE *out, Presolved pre);
+void freePresolved(Presolved pre);
+
+#endif
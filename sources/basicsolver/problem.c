@@ -8,8 +8,24 @@
 #include "variable.h"
 #include "constraint.h"
 #include "solve.h"
+#include "binary.h"
+#include "global.h"
+#include <string.h>
+#include <pthread.h>
+#include <setjmp.h>
+
+extern void parser(Problem LLuserData, Problem *LLretval);
+extern void constraintParser(Problem LLuserData, Constraint *LLretval);
+extern void resetLexer(FILE *input);
+extern void scanString(const char *str);
+extern void endScanString();
+
+/* the generated scanner and parser are not reentrant */
+static pthread_mutex_t parserLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* set while this thread loads a problem with loadProblemFromMemory */
+static __thread jmp_buf *loadRecovery = NULL;
 
-extern FILE *logFile;
 
 static void setConstraintOfNumExp(NumExp exp, Constraint c, Problem p);
 static void setConstraintOfFactor(Factor exp, Constraint c, Problem p);
@@ -17,6 +33,10 @@ static void setConstraintOfFactor(Factor exp, Constraint c, Problem p);
 
 static void setConstraintOfValue(Value v, Constraint c, Problem p) {
 	if(v->type == VARVAL) {
+		if(v->data.varIndex < 0 || v->data.varIndex >= p->varCount) {
+			fprintf(stderr, "[ERROR] Constraint refers to undeclared variable X%d\n", v->data.varIndex);
+			loadFailed(-1);
+		}
 	  Variable var = varByIndex(p, v->data.varIndex);
 		addConstraintToVar(var, c);
 		addVarToConstraint(c, var);
@@ -86,16 +106,81 @@ static void freeProblemConstraints(Problem p) {
 		freeConstraint(p->constraints[i]);
 	}
 	free(p->constraints);
+	for(i = 0; i < p->globalCount; i++) {
+		freeGlobal(p->globals[i]);
+	}
+	free(p->globals);
 }
 
-void linkConstraintsAndVars(Problem p) {
+void linkConstraint(Problem p, Constraint c) {
+	foldConstraint(c);
+	setConstraintOfNumExp(firstExp(c), c, p);
+	if(secondExp(c) != NULL) {
+		setConstraintOfNumExp(secondExp(c), c, p);
+	}
+}
+
+/* FNV-1a hash of the code words */
+static unsigned int hashCode(const int *words, int length) {
+	unsigned int hash = 2166136261u;
 	int i;
+	for(i = 0; i < length; i++) {
+		hash = (hash ^ (unsigned int) words[i])*16777619u;
+	}
+	return hash;
+}
+
+/*
+  Drops all but the first of the constraints that are the same up to the
+  order of the sides of their relation, see encodeCanonicalCode. Constant
+  parts are folded first, so X0 <> 1 + 2 and 3 <> X0 are the same. The
+  constraints must not be linked yet. Returns the amount dropped.
+*/
+int dropDuplicateConstraints(Problem p) {
+	int **codes = safeMalloc((p->constraintCount+1)*sizeof(int *));
+	int *lengths = safeMalloc((p->constraintCount+1)*sizeof(int));
+	int *table, mask = 1, i, slot, count = 0;
+	while(mask < 2*p->constraintCount) {
+		mask <<= 1;
+	}
+	table = safeMalloc(mask*sizeof(int));
+	mask--;
+	for(i = 0; i <= mask; i++) {
+		table[i] = -1;
+	}
 	for(i = 0; i < p->constraintCount; i++) {
-	  Constraint c = constraintByIndex(p, i);
-		setConstraintOfNumExp(firstExp(c), c, p);
-		if(secondExp(p->constraints[i]) != NULL) {
-			setConstraintOfNumExp(secondExp(c), c, p);
+		Constraint c = p->constraints[i];
+		foldConstraint(c);
+		codes[count] = encodeCanonicalCode(c, &lengths[count]);
+		slot = hashCode(codes[count], lengths[count]) & mask;
+		while(table[slot] >= 0 && (lengths[table[slot]] != lengths[count] ||
+		      memcmp(codes[table[slot]], codes[count], lengths[count]*sizeof(int)))) {
+			slot = (slot+1) & mask;
 		}
+		if(table[slot] >= 0) {
+			free(codes[count]);
+			freeConstraint(c);
+			continue;
+		}
+		table[slot] = count;
+		setIndexOfConstraint(c, count);
+		p->constraints[count++] = c;
+	}
+	for(i = 0; i < count; i++) {
+		free(codes[i]);
+	}
+	free(codes);
+	free(lengths);
+	free(table);
+	i = p->constraintCount-count;
+	p->constraintCount = count;
+	return i;
+}
+
+void linkConstraintsAndVars(Problem p) {
+	int i;
+	for(i = 0; i < p->constraintCount; i++) {
+		linkConstraint(p, constraintByIndex(p, i));
 	}
 }
 
@@ -109,6 +194,9 @@ Problem emptyProblem() {
 	p->vars = NULL;
 	p->varSequence = NULL;
 	p->constraints = NULL;
+	p->globalCount = 0;
+	p->globals = NULL;
+	p->arena = NULL;
 	p->solvespec.type = SOLVENR;
 	p->solvespec.max = 1;
 	return p;
@@ -118,10 +206,106 @@ Problem emptyProblem() {
 void freeProblem(Problem p) {
 	freeProblemVars(p);
 	freeProblemConstraints(p);
+	if(p->arena != NULL) {
+		freeArena(p->arena);
+	}
 	freeVarSeq(p->varSequence);
 	free(p);
 }
 
+/* 
+  Loads the problem in file inputName, either binary or textual normal form.
+  Binary files are loaded without locking, textual ones are parsed by one
+  thread at a time.
+*/
+Problem loadProblem(char *inputName) {
+	Problem p = NULL;
+	Arena arena;
+	FILE *input;
+
+	if(isBinaryProblemFile(inputName)) {
+		return loadBinaryProblem(inputName);
+	}
+
+	input = fopen(inputName, "r");
+	if(input == NULL) {
+		fprintf(stderr, "[ERROR] Could not open file %s\n", inputName);
+		exit(-1);
+	}
+	arena = newArena();
+	pthread_mutex_lock(&parserLock);
+	resetLexer(input);
+	setExpressionArena(arena);
+	parser(p, &p);
+	setExpressionArena(NULL);
+	pthread_mutex_unlock(&parserLock);
+	fclose(input);
+	p->arena = arena;
+	return p;
+}
+
+/*
+  Called on an error in the problem that is being loaded, after it has been
+  reported. Ends the process with status, unless the problem is loaded by
+  loadProblemFromMemory, which then returns NULL. 
+*/
+void loadFailed(int status) {
+	if(loadRecovery != NULL) {
+		longjmp(*loadRecovery, 1);
+	}
+	exit(status);
+}
+
+/* 
+  Loads a problem of size bytes in binary normal form, or in textual normal
+  form terminated by '\0'. An invalid problem is not fatal: NULL is
+  returned, the partially built problem is not freed but its expressions are.
+*/
+Problem loadProblemFromMemory(const char *data, size_t size, int binary) {
+	jmp_buf recovery;
+	Problem p = NULL;
+	Arena arena;
+	if(setjmp(recovery)) {
+		loadRecovery = NULL;
+		arena = setExpressionArena(NULL);
+		if(arena != NULL) {
+			freeArena(arena);
+		}
+		if(!binary) {
+			endScanString();
+			pthread_mutex_unlock(&parserLock);
+		}
+		return NULL;
+	}
+	loadRecovery = &recovery;
+	if(binary) {
+		p = decodeBinaryProblem(data, size, "request");
+	} else {
+		arena = newArena();
+		pthread_mutex_lock(&parserLock);
+		scanString(data);
+		setExpressionArena(arena);
+		parser(NULL, &p);
+		setExpressionArena(NULL);
+		endScanString();
+		pthread_mutex_unlock(&parserLock);
+		p->arena = arena;
+	}
+	loadRecovery = NULL;
+	return p;
+}
+
+/* parses a single constraint in normal form, e.g. "X0 + X1 <> 3" */
+Constraint parseConstraint(const char *str) {
+	Constraint c = NULL;
+	pthread_mutex_lock(&parserLock);
+	scanString(str);
+	constraintParser(NULL, &c);
+	endScanString();
+	pthread_mutex_unlock(&parserLock);
+	return c;
+}
+
 
 VarSeq varSeqOfProblem(Problem p) {
 	return p->varSequence;
@@ -166,6 +350,10 @@ void setVarsOfProblem(Problem p, VarList vl) {
 	tmp = vl;
 	for(i = 0; i < varCount; i++) {
 		vars[i] = newVariable(tmp->varIndex, tmp->varType);
+		/* a boolean is 0 or 1 unless the domains say otherwise */
+		if(tmp->varType == BOOLEAN) {
+			addIntervalToSet(domainOfVar(vars[i]), 0, 1);
+		}
 		tmp = tmp->next;
 	}
 	freeVarList(vl);
@@ -199,6 +387,7 @@ void setConstraintsOfProblem(Problem p, ConstraintList cl) {
 	}
 	
 	freeConstraintList(cl);
+	dropDuplicateConstraints(p);
 	linkConstraintsAndVars(p);	
 }
 
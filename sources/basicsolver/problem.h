@@ -6,7 +6,9 @@
 #include <assert.h>
 
 typedef struct problem *Problem;
+typedef struct solver *Solver;
 typedef struct directedArc *DirectedArc;
+typedef struct global *Global;
 
 #include "variable.h"
 #include "constraint.h"
@@ -33,12 +35,18 @@ typedef struct problem {
 	Variable *vars;				/* array of variables for this Problem */
 	VarSeq varSequence;
 	Constraint *constraints;	/* array of constraints for this Problem */
+	int globalCount;			/* nr of global constraints, see global.h */
+	Global *globals;
+	Arena arena;				/* expressions of the constraints, NULL if on the heap */
 	SolveSpec solvespec;		/* how many solutions should be determined */
 } problem;
 
 void setVarsOfProblem(Problem p, VarList vl);
 void setConstraintsOfProblem(Problem p, ConstraintList constraints);
 void setDomainsOfVars(Problem p, VarList varIndices, IntegerSet d);
+void linkConstraint(Problem p, Constraint c);
+void linkConstraintsAndVars(Problem p);
+int dropDuplicateConstraints(Problem p);
 
 Variable varByIndex(Problem p, int index);
 void setVarAtIndex(Problem p, int index, Variable v);
@@ -50,6 +58,10 @@ void printProblem(Problem p);
 /*void freeProblemVars(Problem p);*/
 Problem emptyProblem();
 void freeProblem(Problem p);
+Problem loadProblem(char *inputName);
+Problem loadProblemFromMemory(const char *data, size_t size, int binary);
+Constraint parseConstraint(const char *str);
+void loadFailed(int status);
 
 
 
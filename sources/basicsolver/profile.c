@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "datatypes.h"
+#include "solve.h"
+#include "profile.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+unsigned long long profileTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000ULL + now.tv_nsec;
+#endif
+}
+
+void startProfiling(Solver s, Problem p) {
+	int i;
+	if(s->profiling) {
+		s->profiles = safeCalloc(p->constraintCount, sizeof(constraintProfile));
+		for(i = 0; i < p->constraintCount; i++) {
+			s->profiles[i].index = i;
+		}
+	}
+}
+
+/* checkConstraint, with its cost accounted to constraint c */
+int profiledCheck(Solver s, Constraint c, Problem p) {
+	unsigned long long start = profileTicks();
+	int result = checkConstraint(c, p);
+	constraintProfile *prof = &s->profiles[indexOfConstraint(c)];
+	prof->checks++;
+	prof->ticks += profileTicks() - start;
+	return result;
+}
+
+/* accounts a revision by constraint c that started at tick start */
+void profileRevision(Solver s, Constraint c, int pruned, int wipeout, unsigned long long start) {
+	constraintProfile *prof = &s->profiles[indexOfConstraint(c)];
+	prof->revisions++;
+	prof->pruned += pruned;
+	prof->wipeouts += wipeout;
+	prof->ticks += profileTicks() - start;
+}
+
+int compareProfiles(const void *a, const void *b) {
+	unsigned long long ta = ((constraintProfile *)a)->ticks;
+	unsigned long long tb = ((constraintProfile *)b)->ticks;
+	return (ta < tb) - (ta > tb);
+}
+
+/* writes the profiling report for the most expensive constraints to the log */
+void stopProfiling(Solver s, Problem p) {
+	int i, count = p->constraintCount;
+	unsigned long long total = 0;
+	FILE *out = s->log;
+
+	if(!s->profiling) {
+		return;
+	}
+	for(i = 0; i < count; i++) {
+		total += s->profiles[i].ticks;
+	}
+	qsort(s->profiles, count, sizeof(constraintProfile), compareProfiles);
+
+	if(count > s->profiling) {
+		count = s->profiling;
+	}
+	if(out != NULL) {
+		fprintf(out, "\n# Constraint profile: %d most expensive of %d constraints\n", count, p->constraintCount);
+		fprintf(out, "# %4s %6s %10s %10s %10s %8s %14s %6s\n",
+		  "rank", "index", "checks", "revisions", "pruned", "wipeouts", "ticks", "%");
+		for(i = 0; i < count; i++) {
+			constraintProfile *prof = &s->profiles[i];
+			fprintf(out, "  %4d %6d %10ld %10ld %10ld %8ld %14llu %6.2f   ", i+1, prof->index,
+			  prof->checks, prof->revisions, prof->pruned, prof->wipeouts, prof->ticks,
+			  (total > 0 ? 100.0 * prof->ticks / total : 0.0));
+			printConstraint(out, constraintByIndex(p, prof->index));
+		}
+	}
+	free(s->profiles);
+	s->profiles = NULL;
+}
@@ -0,0 +1,34 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "problem.h"
+#include "constraint.h"
+
+/*
+ * Per-constraint profiling, enabled with -profile K. For every constraint
+ * it counts the checks of the constraint on a partial assignment, the
+ * revisions of a domain by the constraint (arc/node reduction), the values
+ * pruned and the domain wipeouts caused, and accumulates the time spent in
+ * both, in ticks of the time stamp counter (nanoseconds if there is none).
+ * After the search the K most expensive constraints are written to the log.
+ */
+
+typedef struct constraintProfile {
+	int index;
+	long checks;
+	long revisions;
+	long pruned;
+	long wipeouts;
+	unsigned long long ticks;
+} constraintProfile;
+
+void startProfiling(Solver s, Problem p);
+void stopProfiling(Solver s, Problem p);
+
+unsigned long long profileTicks();
+int profiledCheck(Solver s, Constraint c, Problem p);
+void profileRevision(Solver s, Constraint c, int pruned, int wipeout, unsigned long long start);
+
+#endif
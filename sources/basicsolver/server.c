@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <signal.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "datatypes.h"
+#include "problem.h"
+#include "solve.h"
+#include "server.h"
+
+/* largest model accepted in a request */
+#define MAX_REQUEST_SIZE (256*1024*1024)
+
+/*
+  A connection is either idle, then the main thread polls it, or one of its
+  requests is being answered by a worker, which gives the connection back
+  to the main thread through a pipe. Requests are read without buffering
+  ahead, so that a pending request is always visible to poll.
+*/
+typedef struct connection {
+	int fd;
+	FILE *out;
+	SolutionSink sink;
+} connection;
+
+typedef struct server {
+	Queue requests;				/* connections with a pending request */
+	pthread_mutex_t lock;
+	pthread_cond_t waiting;
+	int idlePipe[2];			/* connections given back by the workers */
+	int optionCount;			/* solver options of every worker */
+	char **options;
+} server;
+
+/* reads exactly size bytes, returns 0 if the connection is closed first */
+static int readFully(int fd, char *buffer, long size) {
+	long done = 0, n;
+	while(done < size) {
+		n = read(fd, buffer+done, size-done);
+		if(n < 0 && errno == EINTR) {
+			continue;
+		}
+		if(n <= 0) {
+			return 0;
+		}
+		done += n;
+	}
+	return 1;
+}
+
+static int readLine(int fd, char *line, int size) {
+	int i;
+	for(i = 0; i < size-1; i++) {
+		if(!readFully(fd, &line[i], 1)) {
+			return 0;
+		}
+		if(line[i] == '\n') {
+			break;
+		}
+	}
+	line[i] = '\0';
+	return 1;
+}
+
+/* answers one request of c, returns 0 if the connection should be closed */
+static int answerRequest(Solver s, connection *c) {
+	char line[128], format[8];
+	long size;
+	char *data;
+	Problem p;
+
+	if(!readLine(c->fd, line, sizeof(line))) {
+		return 0;
+	}
+	if(sscanf(line, "solve %7s %ld", format, &size) != 2 ||
+	   (strcmp(format, "nf") && strcmp(format, "nfb")) ||
+	   size < 0 || size > MAX_REQUEST_SIZE) {
+		fprintf(c->out, "error malformed request\n");
+		fflush(c->out);
+		return 0;
+	}
+	data = safeMalloc(size+1);
+	if(!readFully(c->fd, data, size)) {
+		free(data);
+		return 0;
+	}
+	data[size] = '\0';
+	p = loadProblemFromMemory(data, size, !strcmp(format, "nfb"));
+	free(data);
+	if(p == NULL) {
+		fprintf(c->out, "error invalid model\n");
+	} else {
+		resetSolver(s);
+		c->sink->count = 0;
+		c->sink->limit = solutionLimit(p);
+		if(solveToSink(s, p, c->sink) < 0) {
+			fprintf(c->out, "error solving failed\n");
+		} else {
+			fprintf(c->out, "end %d %ld\n", c->sink->count, s->stateCount);
+		}
+		freeProblem(p);
+	}
+	fflush(c->out);
+	return 1;
+}
+
+static connection *newConnection(int fd) {
+	connection *c = safeMalloc(sizeof(connection));
+	c->fd = fd;
+	c->out = fdopen(dup(fd), "w");
+	c->sink = newTextSink(c->out, -1);
+	return c;
+}
+
+static void closeConnection(connection *c) {
+	freeSolutionSink(c->sink);
+	fclose(c->out);
+	close(c->fd);
+	free(c);
+}
+
+/* the connections polled by the main thread, polled[0] is the socket, polled[1] the pipe */
+typedef struct idleSet {
+	connection **connections;
+	struct pollfd *polled;
+	int count;
+	int space;
+} idleSet;
+
+static void addIdle(idleSet *pool, connection *c) {
+	if(pool->count == pool->space) {
+		pool->space = (pool->space == 0 ? 16 : 2*pool->space);
+		pool->connections = safeRealloc(pool->connections, pool->space*sizeof(connection *));
+		pool->polled = safeRealloc(pool->polled, (2+pool->space)*sizeof(struct pollfd));
+	}
+	pool->connections[pool->count++] = c;
+}
+
+static void *worker(void *arg) {
+	server *srv = arg;
+	Solver s = newSolver();
+	connection *c;
+
+	enableHeuristics(s, srv->optionCount, srv->options);
+	/* workers have no log */
+	s->traceLevel = TRACE_OFF;
+	s->profiling = 0;
+	for(;;) {
+		pthread_mutex_lock(&srv->lock);
+		while(isEmptyQueue(srv->requests)) {
+			pthread_cond_wait(&srv->waiting, &srv->lock);
+		}
+		c = dequeue(srv->requests);
+		pthread_mutex_unlock(&srv->lock);
+		if(answerRequest(s, c)) {
+			if(write(srv->idlePipe[1], &c, sizeof(c)) != sizeof(c)) {
+				closeConnection(c);
+			}
+		} else {
+			closeConnection(c);
+		}
+	}
+	return NULL;
+}
+
+static int listenOn(char *socketPath) {
+	struct sockaddr_un addr;
+	struct stat st;
+	int fd;
+
+	if(strlen(socketPath) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "[ERROR] Socket path %s is too long\n", socketPath);
+		exit(-1);
+	}
+	/* a socket left by an earlier daemon is replaced, any other file is not */
+	if(stat(socketPath, &st) == 0) {
+		if(!S_ISSOCK(st.st_mode)) {
+			fprintf(stderr, "[ERROR] %s exists and is not a socket\n", socketPath);
+			exit(-1);
+		}
+		unlink(socketPath);
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, socketPath);
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0 || bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(fd, 128) != 0) {
+		fprintf(stderr, "[ERROR] Could not listen on %s: %s\n", socketPath, strerror(errno));
+		exit(-1);
+	}
+	return fd;
+}
+
+static void startWorkers(server *srv, int threads) {
+	pthread_t thread;
+	int i;
+	for(i = 0; i < threads; i++) {
+		if(pthread_create(&thread, NULL, worker, srv) != 0) {
+			fprintf(stderr, "[ERROR] Could not start worker thread\n");
+			exit(-1);
+		}
+		pthread_detach(thread);
+	}
+}
+
+/*
+  Serves requests on socketPath until the process is killed. argv holds
+  the solver options, including -threads N.
+*/
+int serveMain(int argc, char **argv, char *socketPath) {
+	server srv;
+	idleSet pool = {NULL, NULL, 0, 0};
+	connection *c;
+	int i, fd, kept = 0;
+	int threads = sysconf(_SC_NPROCESSORS_ONLN);
+	Solver check;
+
+	for(i = 0; i < argc; i++) {
+		if(!strcmp(argv[i], "-threads")) {
+			if(i+1 >= argc || atoi(argv[i+1]) < 1) {
+				fprintf(stderr, "[ERROR] Expecting a positive number following flag '-threads'.\n");
+				exit(1);
+			}
+			threads = atoi(argv[++i]);
+			continue;
+		}
+		argv[kept++] = argv[i];
+	}
+	if(threads < 1) {
+		threads = 1;
+	}
+	/* unknown options are reported now, not by the first worker */
+	check = newSolver();
+	enableHeuristics(check, kept, argv);
+	freeSolver(check);
+
+	srv.requests = emptyQueue();
+	pthread_mutex_init(&srv.lock, NULL);
+	pthread_cond_init(&srv.waiting, NULL);
+	srv.optionCount = kept;
+	srv.options = argv;
+	if(pipe(srv.idlePipe) != 0) {
+		fprintf(stderr, "[ERROR] Could not create pipe\n");
+		exit(-1);
+	}
+
+	pool.polled = safeMalloc(2*sizeof(struct pollfd));
+	pool.polled[0].fd = listenOn(socketPath);
+	pool.polled[1].fd = srv.idlePipe[0];
+	/* a client that disconnects must not end the daemon */
+	signal(SIGPIPE, SIG_IGN);
+	startWorkers(&srv, threads);
+	fprintf(stderr, "Serving on %s with %d threads.\n", socketPath, threads);
+
+	for(;;) {
+		for(i = 0; i < 2+pool.count; i++) {
+			if(i >= 2) {
+				pool.polled[i].fd = pool.connections[i-2]->fd;
+			}
+			pool.polled[i].events = POLLIN;
+			pool.polled[i].revents = 0;
+		}
+		if(poll(pool.polled, 2+pool.count, -1) < 0) {
+			if(errno == EINTR) {
+				continue;
+			}
+			fprintf(stderr, "[ERROR] Could not poll connections: %s\n", strerror(errno));
+			exit(-1);
+		}
+
+		/* connections with a request (or a hangup) go to the workers */
+		pthread_mutex_lock(&srv.lock);
+		for(i = pool.count-1; i >= 0; i--) {
+			if(pool.polled[2+i].revents != 0) {
+				enqueue(srv.requests, pool.connections[i]);
+				pthread_cond_signal(&srv.waiting);
+				pool.connections[i] = pool.connections[--pool.count];
+			}
+		}
+		pthread_mutex_unlock(&srv.lock);
+
+		/* new and returned connections become idle */
+		if(pool.polled[0].revents & POLLIN) {
+			fd = accept(pool.polled[0].fd, NULL, NULL);
+			if(fd >= 0) {
+				addIdle(&pool, newConnection(fd));
+			}
+		}
+		if(pool.polled[1].revents & POLLIN) {
+			if(read(srv.idlePipe[0], &c, sizeof(c)) == sizeof(c)) {
+				addIdle(&pool, c);
+			}
+		}
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+/*
+ * Solver daemon, started with
+ *
+ *   solver [OPTION]... [-threads N] -serve SOCKET
+ *
+ * It listens on the Unix domain socket SOCKET and solves the models it
+ * receives on a pool of N worker threads (default: one per processor),
+ * every worker keeping its own solver. The options are those of the
+ * solver program and apply to all requests.
+ *
+ * A connection carries any number of requests, one after the other:
+ *
+ *   request:   "solve nf SIZE\n" or "solve nfb SIZE\n", followed by SIZE
+ *              bytes of textual or binary normal form
+ *   response:  one line per solution, the values of all variables
+ *              separated by spaces (as written by -stream text), then
+ *              "end COUNT STATES\n", or "error MESSAGE\n" if the request
+ *              could not be solved
+ *
+ * The amount of solutions is given by the model itself. The connection is
+ * closed after a malformed request.
+ *
+ * Known limit: the generated scanner and parser are not reentrant, so
+ * textual normal form is parsed under one process-wide lock (parserLock
+ * in problem.c) and nf requests are parsed one at a time. Only solving
+ * runs in parallel. nfb requests are decoded without the lock.
+ */
+
+int serveMain(int argc, char **argv, char *socketPath);
+
+#endif
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <setjmp.h>
 #include <math.h> 
 #include <sys/resource.h>
 #include "datatypes.h"
@@ -10,6 +11,10 @@
 #include "constraint.h"
 #include "backup.h"
 #include "solve.h"
+#include "stats.h"
+#include "profile.h"
+#include "presolve.h"
+#include "global.h"
 
 #define ON 1
 #define OFF 0
@@ -18,20 +23,75 @@
 #define FC 1
 #define MAC 2
 
-#define LOG ON
+/* set while this thread solves a problem with solveToSink */
+static __thread jmp_buf *solveRecovery = NULL;
 
-/* which techniques should be applied while solving CSP */
-int MAKECONSISTENT = OFF;   	/* OFF/NODE/ARC */
-int MRV = OFF;   				/* ON/OFF */
-int DEGREE_HEURISTIC = OFF;   	/* ON/OFF */
-int MOSTCONNECTED = OFF;   		/* ON/OFF */
-int CP = OFF;   				/* OFF/FC/MAC */
+/*
+  Called on an error in the problem that is being solved, after it has been
+  reported. Ends presolving or the search, solveToSink then returns -1, or
+  the process with status when no problem is solved.
+*/
+void solveFailed(int status) {
+	if(solveRecovery != NULL) {
+		longjmp(*solveRecovery, 1);
+	}
+	exit(status);
+}
+
+Solver newSolver() {
+	Solver s = safeCalloc(1, sizeof(solver));
+	s->makeConsistent = OFF;
+	s->mrv = OFF;
+	s->degreeHeuristic = OFF;
+	s->mostConnected = OFF;
+	s->cp = OFF;
+	s->presolve = OFF;
+	s->alldiff = OFF;
+	s->maxmin = OFF;
+	s->log = NULL;
+	s->traceLevel = TRACE_OFF;
+	s->ring = NULL;
+	s->profiling = 0;
+	s->profiles = NULL;
+	resetStatistics(&s->stats);
+	return s;
+}
+
+/* sets the options of to, including its log, to those of from */
+void copySolverOptions(Solver to, Solver from) {
+	to->makeConsistent = from->makeConsistent;
+	to->mrv = from->mrv;
+	to->degreeHeuristic = from->degreeHeuristic;
+	to->mostConnected = from->mostConnected;
+	to->cp = from->cp;
+	to->presolve = from->presolve;
+	to->alldiff = from->alldiff;
+	to->maxmin = from->maxmin;
+	to->log = from->log;
+	to->traceLevel = from->traceLevel;
+	to->profiling = from->profiling;
+}
+
+/* prepares s for solving another problem, the options are kept */
+void resetSolver(Solver s) {
+	s->stateCount = 0;
+	if(s->ring != NULL) {
+		s->ring->count = 0;
+	}
+	resetStatistics(&s->stats);
+}
+
+/* frees the solver, the log file is owned by the caller */
+void freeSolver(Solver s) {
+	free(s->ring);
+	free(s);
+}
 
 int match(char *str1, char *str2) {
 	return !strcmp(str1, str2);
 }
 
-void enableHeuristics(int argc, char **argv) {
+void enableHeuristics(Solver s, int argc, char **argv) {
 	int fcset = 0;
 	int arcset = 0;
 	for(int i = 0; i < argc; i++) {
@@ -43,7 +103,7 @@ void enableHeuristics(int argc, char **argv) {
 			// match number following
 			int k = atoi(argv[i+1]);
 			if(k >= 0 && k < 3) {
-				MAKECONSISTENT = k;
+				s->makeConsistent = k;
 			} else {
 				fprintf(stderr, "[ERROR] Expecting number in [0..2] following flag '-iconst'.\n" );
 				exit(1) ;
@@ -51,16 +111,46 @@ void enableHeuristics(int argc, char **argv) {
 			i++;
 			continue;
 		}
+		if(match(argv[i], "-trace")) {
+			if(argc-1 < i+1) {
+				fprintf(stderr, "[ERROR] Expecting a number following flag '-trace'.\n" );
+				exit(1);
+			}
+			setTraceLevel(s, atoi(argv[i+1]));
+			i++;
+			continue;
+		}
+		if(match(argv[i], "-profile")) {
+			if(argc-1 < i+1 || atoi(argv[i+1]) < 1) {
+				fprintf(stderr, "[ERROR] Expecting a positive number following flag '-profile'.\n" );
+				exit(1);
+			}
+			s->profiling = atoi(argv[i+1]);
+			i++;
+			continue;
+		}
 		if(match(argv[i], "-mrv")) {
-			MRV = ON;
+			s->mrv = ON;
 			continue;
 		} 
 		if(match(argv[i], "-deg")) {
-			DEGREE_HEURISTIC = ON;
+			s->degreeHeuristic = ON;
 			continue;
 		} 
 		if(match(argv[i], "-mostconnected")) {
-			MOSTCONNECTED = ON;
+			s->mostConnected = ON;
+			continue;
+		}
+		if(match(argv[i], "-presolve")) {
+			s->presolve = ON;
+			continue;
+		}
+		if(match(argv[i], "-alldiff")) {
+			s->alldiff = ON;
+			continue;
+		}
+		if(match(argv[i], "-maxmin")) {
+			s->maxmin = ON;
 			continue;
 		}
 		if(match(argv[i], "-fc")) {
@@ -68,7 +158,7 @@ void enableHeuristics(int argc, char **argv) {
 				fprintf(stderr, "[ERROR] -fc and -arc not allowed together.\n" );
 				exit(1) ;
 			}
-			CP = FC;
+			s->cp = FC;
 			fcset = 1;
 			continue;
 		}
@@ -77,7 +167,7 @@ void enableHeuristics(int argc, char **argv) {
 				fprintf(stderr, "[ERROR] -fc and -arc not allowed together.\n" );
 				exit(1) ;
 			}
-			CP = MAC;
+			s->cp = MAC;
 			arcset = 1;
 			continue;
 		}
@@ -91,36 +181,13 @@ void enableHeuristics(int argc, char **argv) {
 	
 }
 
-/* function pointers that are set based on the applied techniques/heuristics */
-int (*varOrdered)(Variable, Variable);
-int (*propagationSuccess)(Variable, Problem, Backup);
-static int **inArcsQueue;
-
-/* contains file descriptor of logFile: also referred to in other files */
-extern FILE *logFile;
-
-int initdone = 0;
-
-/* counts the amount of backtracking calls */
-long stateCount = 0;
-
-/* adds content to the logFile, if logging is enabled */
-/* src: http://www.cplusplus.com/reference/cstdio/vprintf/ */
-void addLog(const char * format, ...) {
-	if(LOG) {
-		va_list args;
-  	va_start (args, format);
-  	vfprintf (logFile, format, args);
-  	va_end (args);
-  }
-}
 
 /* 
 	This function adds all directed arcs (X --> var) to a given queue
 	an arc is unique by X, var and the constraint that connects these two
 	(can be more than 1 constraint, so more than one arc representing (X --> var)
 */
-void addVariableArcs(Variable var, Queue arcQueue, Problem p) {
+void addVariableArcs(Solver s, Variable var, Queue arcQueue, Problem p) {
 	int i;
 	int *varIndices;
 	
@@ -134,7 +201,7 @@ void addVariableArcs(Variable var, Queue arcQueue, Problem p) {
 		c = constraintByIndex(p, constraintIndices[i]);
 		
 		/* if constraint is binary */
-		if(arityOfConstraint(c) == 1 + (!varAssigned || !initdone)) {           
+		if(arityOfConstraint(c) == 1 + (!varAssigned || !s->initdone)) {           
 			varIndices = varIndicesOfConstraint(c);	
 			
 			/* var2 becomes other variable in binary constraint */
@@ -144,14 +211,14 @@ void addVariableArcs(Variable var, Queue arcQueue, Problem p) {
 			}
 			
 			/* if (constraint, var2) representing directed arc not already in queue */
-			if(!inArcsQueue[c->index][var2->index]) {				
+			if(!s->inArcsQueue[c->index][var2->index]) {				
 			  /* enqueue directed arc (var2 --> var) */			
 			  DirectedArc arc = makeArc(var2, c, var);
 			  enqueue(arcQueue, arc);                     
 			  
 			          
 			  /* mark this arc as available in the queue */
-				inArcsQueue[indexOfConstraint(c)][indexOfVar(var2)] = 1;						  
+				s->inArcsQueue[indexOfConstraint(c)][indexOfVar(var2)] = 1;						  
 			}
 		}
 	}
@@ -161,7 +228,7 @@ void addVariableArcs(Variable var, Queue arcQueue, Problem p) {
 	This function adds all constraints for var with arity 3 that became binary 
 	after assigning var to a given queue.
 */
-void addNewArcs(Variable var, Queue arcQueue, Problem p) {
+void addNewArcs(Solver s, Variable var, Queue arcQueue, Problem p) {
 	int i;
 	int *varIndices;
 	
@@ -182,21 +249,21 @@ void addNewArcs(Variable var, Queue arcQueue, Problem p) {
 		  Variable var3 = varByIndex(p, varIndices[1]);
 			
 			/* if (constraint, var2) representing directed arc not already in queue */
-			if(!inArcsQueue[c->index][var2->index]) {				
+			if(!s->inArcsQueue[c->index][var2->index]) {				
 			  /* enqueue directed arc (var2 --> var) */			
 			  DirectedArc arc = makeArc(var2, c, var);
 			  enqueue(arcQueue, arc);                     
 			          
 			  /* mark this arc as available in the queue */
-				inArcsQueue[indexOfConstraint(c)][indexOfVar(var2)] = 1;						  
+				s->inArcsQueue[indexOfConstraint(c)][indexOfVar(var2)] = 1;						  
 			}
-			if(!inArcsQueue[c->index][var3->index]) {				
+			if(!s->inArcsQueue[c->index][var3->index]) {				
 			  /* enqueue directed arc (var3 --> var) */			
 			  DirectedArc arc = makeArc(var3, c, var);
 			  enqueue(arcQueue, arc);                     
 			          
 			  /* mark this arc as available in the queue */
-				inArcsQueue[indexOfConstraint(c)][indexOfVar(var3)] = 1;						  
+				s->inArcsQueue[indexOfConstraint(c)][indexOfVar(var3)] = 1;						  
 			}
 		}
 	}
@@ -209,8 +276,9 @@ void addNewArcs(Variable var, Queue arcQueue, Problem p) {
 	with one of the unary constraints it is deleted. 
 	When all inconsistent values are removed, the constraint is also removed, 
 	such that it is not checked redundantly later on in the process.
+	Returns 0 if a domain became empty, so that no solution exists.
 */
-void makeNodeConsistent(Problem p) {
+int makeNodeConsistent(Solver s, Problem p) {
 	int i;
 	int *varIndices;
 	Constraint constraint;
@@ -226,33 +294,29 @@ void makeNodeConsistent(Problem p) {
 		  /* get variable which is involved in this constraint */
 			var = varByIndex(p, varIndices[0]);		
 			/* if domain of variable var is reduced */				
-			if(nodeReduce(var, constraint, p)) {						
-			  /* if domain of var became empty -> error, no solution exists */
+			if(nodeReduce(s, var, constraint, p)) {						
+			  /* if domain of var became empty -> no solution exists */
 				if(domainSizeOfVar(var) == 0) {						
-					addLog(
+					traceText(s, TRACE_INFO,
 					  "No solutions found for the problem, \
 					  because variable X%d has an empty domain\n", 
 					  var->index
 					);
-					printf(
-					  "\nNo solutions found for the problem, \
-					  because variable with empty domain\n"
-					);
-					exit(-1);
+					return 0;
 				}
 			}
 			/* remove unary constraint so that it is no longer checked */
 			removeConstraintFromVar(var, constraint);				
 		}
-	}
+	}	return 1;
 }
 
-void printVarDomains(Problem p) {
+void printVarDomains(FILE *out, Problem p) {
 	int i;
 	for(i = 0; i < p->varCount; i++) {
-		addLog("X%d: ", i);
-		printDomainOfVar(varByIndex(p, i));
-		addLog("\n");
+		fprintf(out, "X%d: ", i);
+		printDomainOfVar(out, varByIndex(p, i));
+		fprintf(out, "\n");
 	}
 }
 
@@ -260,14 +324,18 @@ void printVarDomains(Problem p) {
 	This function ensures that all domains of the variables of CSP are consistent 
 	regarding their binary constraints. After execution
 	the CSP p is fully arc-consistent or strongly 2-consistent.
+	Returns 0 if a domain became empty, so that no solution exists.
 */
-void makeArcConsistent(Problem p) {
+int makeArcConsistent(Solver s, Problem p) {
 	int i;
 	int *varIndices;
-	Queue arcQueue = emptyQueue();
+	Queue arcQueue;
 	
 	/* first the CSP is made node-consistent */
-	makeNodeConsistent(p);	
+	if(!makeNodeConsistent(s, p)) {
+		return 0;
+	}
+	arcQueue = emptyQueue();
 	
 	/* for each constraint of p */	
 	for(i = 0; i < p->constraintCount; i++) {					
@@ -285,9 +353,9 @@ void makeArcConsistent(Problem p) {
 			enqueue(arcQueue, makeArc(var2, constraint, var1));	 	
 			
 			/* directional arc (var1 --> var2) is in queue */
-			inArcsQueue[constraint->index][varIndices[0]] = 1;		
+			s->inArcsQueue[constraint->index][varIndices[0]] = 1;		
 			/* directional arc (var2 --> var1) is in queue */
-			inArcsQueue[constraint->index][varIndices[1]] = 1;
+			s->inArcsQueue[constraint->index][varIndices[1]] = 1;
 		}
 	}
 	
@@ -297,37 +365,39 @@ void makeArcConsistent(Problem p) {
 		Variable var1 = firstVarOfArc(arc);
 		Constraint c = constraintOfArc(arc);
 		/* arc is not in queue anymore */	
-		inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;				
+		s->inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;				
 		
-		if(arcReduce(arc, p)) {		/* if domain reduction */
-		  /* if domain of var became empty -> error, no solution exists */
+		if(arcReduce(s, arc, p)) {		/* if domain reduction */
+		  /* if domain of var became empty -> no solution exists */
 			if(domainSizeOfVar(var1) == 0) {					
-				addLog(
+				traceText(s, TRACE_INFO,
 				  "No solutions found for the problem, \
 				  because variable X%d has an empty domain\n", 
 				  indexOfVar(var1)
 				);
-				printf(
-				  "\nNo solutions found for the problem, \
-				  because variable with empty domain\n"
-				);
-				exit(-1);
+				freeArc(arc);
+				while(!isEmptyQueue(arcQueue)) {
+					freeArc(dequeue(arcQueue));
+				}
+				freeQueue(arcQueue);
+				return 0;
 			}
 			/* because domain is reduced, domains of neighbours might be reduced */
-			addVariableArcs(var1, arcQueue, p);	
+			addVariableArcs(s, var1, arcQueue, p);	
 			
 		}
 		freeArc(arc);
 	}
 	
 	freeQueue(arcQueue);
+	return 1;
 }
 
 /* 
   Checks if the assignment to variable var is consistent 
   with current partial assignment.
 */
-int checkLocalConsistency(Variable var, Problem p) {
+int checkLocalConsistency(Solver s, Variable var, Problem p) {
 	int i;
 	int *constraintIndices = constraintIndicesOfVar(var);
 	Constraint c;
@@ -336,11 +406,12 @@ int checkLocalConsistency(Variable var, Problem p) {
 	for(i = 0; i < constraintAmountOfVar(var); i++) {		
 		c = constraintByIndex(p, constraintIndices[i]);				
 		/* check if inconsistent with partial solution */
-		if(determinable(c, p) && !checkConstraint(c, p)) {		
+		if(determinable(c, p) && 
+		   !(s->profiling ? profiledCheck(s, c, p) : checkConstraint(c, p))) {		
 			return 0;
 		}
 	}
-	return 1;
+	return checkGlobals(var, p);
 }
 
 /* 
@@ -348,9 +419,9 @@ int checkLocalConsistency(Variable var, Problem p) {
   is consistent and (if techniques applied) removes invalid values from domains
   of unassigned variables by constraint propagation
 */
-int isConsistent(Variable var, Problem p, Backup b) {
-  if(checkLocalConsistency(var, p)) {
-    return propagationSuccess(var, p, b);
+int isConsistent(Solver s, Variable var, Problem p, Backup b) {
+  if(checkLocalConsistency(s, var, p)) {
+    return s->propagationSuccess(s, var, p, b);
   }
   return 0;
 }
@@ -359,14 +430,14 @@ int isConsistent(Variable var, Problem p, Backup b) {
   Function that makes the queue empty and sets all arcs as 'not available'
   for queue containing directed arcs.
 */
-void makeArcQueueEmpty(Queue arcQueue) {
+void makeArcQueueEmpty(Solver s, Queue arcQueue) {
   /* for all arcs in queue */
   while(!isEmptyQueue(arcQueue)) {
     DirectedArc arc = dequeue(arcQueue);
     Constraint c = constraintOfArc(arc);
     Variable var1 = firstVarOfArc(arc);
     /* set arc (var1 --> otherVar) by constraint c 'not available' */
-    inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;	
+    s->inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;	
     freeArc(arc);
   }
 }
@@ -375,17 +446,24 @@ void makeArcQueueEmpty(Queue arcQueue) {
   Function that can be used as placeholder if no constraint propagation
   is applied.
 */  
-int skipPropagationTest(Variable var, Problem p, Backup backup) {
+int skipPropagationTest(Solver s, Variable var, Problem p, Backup backup) {
   return 1;
 }
 
-int forwardChecking(Variable var, Problem p, Backup backup) {
-  Queue arcQueue = emptyQueue();
+int forwardChecking(Solver s, Variable var, Problem p, Backup backup) {
+  Queue arcQueue;
+  s->stats.propagations++;
 	
-	addLog("forward checking based on assignment of variable X%d\n", var->index);
+	traceEvent(s, TRACE_SEARCH, EVENT_FC, var->index, 0, 0);
+	
+	/* remove the value of var from the other variables of its globals */
+	if(!propagateGlobals(s, var, p, backup, NULL)) {
+	  return 0;
+	}
+	arcQueue = emptyQueue();
 	
 	/* enqueue all arcs directed at var, so all (X --> var) */
-  addVariableArcs(var, arcQueue, p);
+  addVariableArcs(s, var, arcQueue, p);
   
   /* for all arcs in queue */
   while(!isEmptyQueue(arcQueue)) {		
@@ -395,14 +473,14 @@ int forwardChecking(Variable var, Problem p, Backup backup) {
     Variable var1 = firstVarOfArc(arc);
     
     /* set arc 'not available' */
-    inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;		
+    s->inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;		
 		
 		/* make backup before reduction */
 		IntegerSet domBackup = copyIntegerSet(domainOfVar(var1));
 	  varPos seqBackup = *(sequencePosition(var1));	
 	  
 	  /* check if domain of variable can be reduced by arc */
-	  int reduced = arcReduce(arc, p);
+	  int reduced = arcReduce(s, arc, p);
 	  freeArc(arc);
 	  
 	  /* if domain of variable is reduced by arc */
@@ -411,14 +489,13 @@ int forwardChecking(Variable var, Problem p, Backup backup) {
 		  addBackup(var1->index, domBackup, seqBackup, backup);
 		  /* resort variable in sequence */
 			resortVarSeq(p->varSequence, sequencePosition(var1));
-			addLog(
-			  "X%d = %d -> Domain limited of variable X%d.\n", 
+			traceEvent(s, TRACE_SEARCH, EVENT_LIMIT, 
 		    indexOfVar(var), domainMinimumOfVar(var), indexOfVar(var1)
 		  );				
 			int domSize = domainSizeOfVar(var1);
 			/* if domain of variable became empty after reduction */
 		  if(domSize == 0) {
-		    makeArcQueueEmpty(arcQueue);
+		    makeArcQueueEmpty(s, arcQueue);
 		    freeQueue(arcQueue);
 		    /* return error */
 			  return 0;
@@ -436,19 +513,27 @@ int forwardChecking(Variable var, Problem p, Backup backup) {
 
 /* 
   Function that performs constraint propagation after assignment
-  If CP is set to MAC, then arc-consistency is maintained.
+  If s->cp is set to MAC, then arc-consistency is maintained.
 */
-int mac(Variable var, Problem p, Backup backup) {  
+int mac(Solver s, Variable var, Problem p, Backup backup) {  
   Queue arcQueue = emptyQueue();
+  s->stats.propagations++;
 	
-	addLog("Maintaining arc consistency after assignment of variable X%d\n", var->index);
+	traceEvent(s, TRACE_SEARCH, EVENT_MAC, var->index, 0, 0);
 	
 	/* enqueue all arcs directed at var, so all (X --> var) */
-  addVariableArcs(var, arcQueue, p);
+  addVariableArcs(s, var, arcQueue, p);
   
   /* enqueue all new arcs (two directions of constraints that had arity 3
       before assignment of var, but became binary after) */
-  addNewArcs(var, arcQueue, p);
+  addNewArcs(s, var, arcQueue, p);
+  
+  /* propagate the globals of var, variables reduced by them get their arcs enqueued */
+  if(!propagateGlobals(s, var, p, backup, arcQueue)) {
+    makeArcQueueEmpty(s, arcQueue);
+    freeQueue(arcQueue);
+    return 0;
+  }
   
   /* for all arcs in queue */
   while(!isEmptyQueue(arcQueue)) {		
@@ -458,14 +543,14 @@ int mac(Variable var, Problem p, Backup backup) {
     Variable var1 = firstVarOfArc(arc);
     
     /* set arc 'not available' */
-    inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;		
+    s->inArcsQueue[indexOfConstraint(c)][indexOfVar(var1)] = 0;		
 		
 		/* make backup before reduction */
 		IntegerSet domBackup = copyIntegerSet(domainOfVar(var1));
 	  varPos seqBackup = *(sequencePosition(var1));	
 	  
 	  /* check if domain of variable can be reduced by arc */
-	  int reduced = arcReduce(arc, p);
+	  int reduced = arcReduce(s, arc, p);
 	  freeArc(arc);
 	  
 	  /* if domain of variable is reduced by arc */
@@ -474,20 +559,25 @@ int mac(Variable var, Problem p, Backup backup) {
 		  addBackup(var1->index, domBackup, seqBackup, backup);
 		  /* resort variable in sequence */
 			resortVarSeq(p->varSequence, sequencePosition(var1));
-			addLog(
-			  "X%d = %d -> Domain limited of variable X%d.\n", 
+			traceEvent(s, TRACE_SEARCH, EVENT_LIMIT, 
 		    indexOfVar(var), domainMinimumOfVar(var), indexOfVar(var1)
 		  );				
 			int domSize = domainSizeOfVar(var1);
 			/* if domain of variable became empty after reduction */
 		  if(domSize == 0) {
-		    makeArcQueueEmpty(arcQueue);
+		    makeArcQueueEmpty(s, arcQueue);
 		    freeQueue(arcQueue);
 		    /* return error */
 			  return 0;
 			} 
+			/* the globals of the variable are propagated */
+			if(sizeOfSet(var1->globals) > 0 && !propagateGlobals(s, var1, p, backup, arcQueue)) {
+			  makeArcQueueEmpty(s, arcQueue);
+			  freeQueue(arcQueue);
+			  return 0;
+			}
 			/* apply constraint propagation for variable with reduced domain */
-			addVariableArcs(var1, arcQueue, p);	
+			addVariableArcs(s, var1, arcQueue, p);	
 		} else {
 		  /* backup not needed */
 		  freeIntegerSet(domBackup);
@@ -507,8 +597,8 @@ Variable selectUnassignedVar(Problem p) {
 
 
 
-int init(Problem p) {
-	int i, j;
+int init(Solver s, Problem p) {
+	int i, j, consistent;
 	p->assignCount = 0;
 	
 	int possibilities = 0;
@@ -526,40 +616,52 @@ int init(Problem p) {
 		}
 		domainCounts[domSize]++;
 	}
-	addLog("\n");
-	addLog(
+	traceText(s, TRACE_INFO, "\n");
+	traceText(s, TRACE_INFO,
 	  "# Before init: %d possible values and %d ", 
 	  possibilities, (domainCounts[0] == 0)
   );
 	for(i = 1; i <= maxDomSize; i++) {
 		if(domainCounts[i]) {
-			addLog("* %d^%d ", i, domainCounts[i]);
+			traceText(s, TRACE_INFO, "* %d^%d ", i, domainCounts[i]);
 		}
 	}
-	addLog("combinations\n");
-	addLog(
+	traceText(s, TRACE_INFO, "combinations\n");
+	traceText(s, TRACE_INFO,
 	  "# Applying substitution for single-value domains \
 	  and checking applicable constraints:\n"
 	);
 	
-	switch(MAKECONSISTENT) {
+	switch(s->makeConsistent) {
 		case NODE:
-			makeNodeConsistent(p);
+			consistent = makeNodeConsistent(s, p);
 			break;
 		case ARC:
-			makeArcConsistent(p);
+			consistent = makeArcConsistent(s, p);
 			break;
+		default:
+			consistent = 1;
+			break;
+	}
+	if(!consistent) {
+		free(domainCounts);
+		return 0;
+	}
+	if(s->makeConsistent != OFF && !initGlobals(s, p)) {
+		traceText(s, TRACE_INFO, "No solutions found for the problem, a global constraint can not be satisfied\n");
+		free(domainCounts);
+		return 0;
 	}
 	
-	switch(CP) {
+	switch(s->cp) {
 	  case FC:
-	    propagationSuccess = forwardChecking;
+	    s->propagationSuccess = forwardChecking;
 	    break;
 	  case MAC:
-	    propagationSuccess = mac;
+	    s->propagationSuccess = mac;
 	    break;
 	  default:
-	    propagationSuccess = skipPropagationTest;
+	    s->propagationSuccess = skipPropagationTest;
 	    break;
 	}
 	
@@ -572,20 +674,22 @@ int init(Problem p) {
 		possibilities += domSize;
 		domainCounts[domSize]++;
 	}
-	addLog(
+	traceText(s, TRACE_INFO,
 	  "# After init: %d possible values and %d ", 
 	  possibilities, (domainCounts[0] == 0)
 	);
 	for(i = 1; i <= maxDomSize; i++) {
 		if(domainCounts[i]) {
-			addLog("* %d^%d ", i, domainCounts[i]);
+			traceText(s, TRACE_INFO, "* %d^%d ", i, domainCounts[i]);
 		}
 	}
-	addLog("combinations\n");
+	traceText(s, TRACE_INFO, "combinations\n");
 	free(domainCounts);
-	addLog("# After init: domains\n");
-	printVarDomains(p);
-	initdone = 1;
+	traceText(s, TRACE_DETAIL, "# After init: domains\n");
+	if(TRACING(s, TRACE_DETAIL)) {
+		printVarDomains(s->log, p);
+	}
+	s->initdone = 1;
 	return 1;
 }
 
@@ -608,32 +712,146 @@ SolutionSet newSolutionSet(int varAmount, int solutionSpace) {
 	}
 }
 
-SolutionList newSolution(Problem p) {
-	int i;
+SolutionList newSolution(int *values, int varCount) {
 	SolutionList list = safeMalloc(sizeof(solutionList));
-	list->values = safeMalloc(p->varCount*sizeof(int));
-	for(i = 0; i < p->varCount; i++) {
-		list->values[i] = domainMinimumOfVar(varByIndex(p, i));
-	}
+	list->values = safeMalloc(varCount*sizeof(int));
+	memcpy(list->values, values, varCount*sizeof(int));
 	list->next = NULL;
 	return list;
 }
 
-void addSolution(SolutionSet solset, Problem p) {
+void appendSolution(SolutionSet solset, int *values) {
 	if(solset->solutionCount == solset->solutionSpace) {
 		fprintf(stderr, "No more solutions can be added to this set\n");
 		exit(-1);
 	}
 	if(solset->solutionCount == 0) {
-		solset->first = newSolution(p);
+		solset->first = newSolution(values, solset->varAmount);
 		solset->last = solset->first;
 	} else {
-		solset->last->next = newSolution(p);
+		solset->last->next = newSolution(values, solset->varAmount);
 		solset->last = solset->last->next;
 	}
 	solset->solutionCount++;
 }
 
+/* stores the values of the current (complete) assignment in values */
+void currentAssignment(Problem p, int *values) {
+	int i;
+	for(i = 0; i < p->varCount; i++) {
+		values[i] = domainMinimumOfVar(varByIndex(p, i));
+	}
+}
+
+void addSolution(SolutionSet solset, Problem p) {
+	int values[p->varCount];
+	currentAssignment(p, values);
+	appendSolution(solset, values);
+}
+
+SolutionSink newSolutionSink(FILE *out, int limit) {
+	SolutionSink sink = safeMalloc(sizeof(solutionSink));
+	sink->emit = NULL;
+	sink->finish = NULL;
+	sink->callback = NULL;
+	sink->out = out;
+	sink->data = NULL;
+	sink->count = 0;
+	sink->limit = limit;
+	return sink;
+}
+
+/* text sink: one line per solution, values separated by spaces */
+void emitText(SolutionSink sink, int *values, int varCount) {
+	int i;
+	for(i = 0; i < varCount; i++) {
+		fprintf(sink->out, "%d ", values[i]);
+	}
+	fputc('\n', sink->out);
+}
+
+void finishStream(SolutionSink sink) {
+	fflush(sink->out);
+}
+
+SolutionSink newTextSink(FILE *out, int limit) {
+	SolutionSink sink = newSolutionSink(out, limit);
+	/* flush every line, so that consumers can read solutions while searching */
+	setvbuf(out, NULL, _IOLBF, 0);
+	sink->emit = emitText;
+	sink->finish = finishStream;
+	return sink;
+}
+
+/* 
+  binary sink: a single int holding the amount of variables, followed by one 
+  record of varCount native ints per solution 
+*/
+void emitBinary(SolutionSink sink, int *values, int varCount) {
+	if(fwrite(values, sizeof(int), varCount, sink->out) != varCount) {
+		fprintf(stderr, "[ERROR] Could not write solution\n");
+		exit(-1);
+	}
+	fflush(sink->out);
+}
+
+SolutionSink newBinarySink(FILE *out, int varCount, int limit) {
+	SolutionSink sink = newSolutionSink(out, limit);
+	if(fwrite(&varCount, sizeof(int), 1, out) != 1) {
+		fprintf(stderr, "[ERROR] Could not write solution header\n");
+		exit(-1);
+	}
+	sink->emit = emitBinary;
+	sink->finish = finishStream;
+	return sink;
+}
+
+/* count sink: solutions are only counted, the values are dropped */
+void emitNothing(SolutionSink sink, int *values, int varCount) {
+}
+
+SolutionSink newCountSink(int limit) {
+	SolutionSink sink = newSolutionSink(NULL, limit);
+	sink->emit = emitNothing;
+	return sink;
+}
+
+/* collect sink: solutions are kept in memory in a SolutionSet */
+void emitCollect(SolutionSink sink, int *values, int varCount) {
+	appendSolution(sink->data, values);
+}
+
+SolutionSink newCollectSink(SolutionSet solset) {
+	SolutionSink sink = newSolutionSink(NULL, solset->solutionSpace);
+	sink->data = solset;
+	sink->emit = emitCollect;
+	return sink;
+}
+
+/* callback sink: solutions are passed to a function, that returns nonzero to stop the search */
+void emitCallback(SolutionSink sink, int *values, int varCount) {
+	if(sink->callback(values, varCount, sink->data)) {
+		/* full after this solution has been counted */
+		sink->limit = sink->count + 1;
+	}
+}
+
+SolutionSink newCallbackSink(int (*callback)(const int *values, int varCount, void *data), void *data, int limit) {
+	SolutionSink sink = newSolutionSink(NULL, limit);
+	sink->callback = callback;
+	sink->data = data;
+	sink->emit = emitCallback;
+	return sink;
+}
+
+int sinkFull(SolutionSink sink) {
+	return sink->count == sink->limit;
+}
+
+void freeSolutionSink(SolutionSink sink) {
+	free(sink);
+}
+
 int solutionsLeft(SolutionSet solset) {
   return (solset->solutionSpace - solset->solutionCount != 0);
 }
@@ -716,15 +934,24 @@ void removeVarFromConstraints(Variable var, Problem p) {
   }
 }
 
-void recursiveBacktracking(Problem p, SolutionSet solset) {		
+void recursiveBacktracking(Solver s, Problem p, SolutionSink sink) {		
 	Variable var;
 	varPos sequencePos;
 	int *values, i;
 	IntegerSet fullDomain;
 	
-	stateCount++;
+	s->stateCount++;
+	if(statisticsRequest) {
+		handleStatisticsRequest(s);
+	}
+	if(p->assignCount > s->stats.maxDepth) {
+		s->stats.maxDepth = p->assignCount;
+	}
 	if(p->varCount == p->assignCount) {
-		addSolution(solset, p);
+		currentAssignment(p, s->solutionValues);
+		sink->emit(sink, s->solutionValues, p->varCount);
+		sink->count++;
+		s->stats.solutions++;
 		return;
 	}
 	
@@ -736,13 +963,15 @@ void recursiveBacktracking(Problem p, SolutionSet solset) {
 	removeVarFromConstraints(var, p);
 	removeVarFromSequence(p->varSequence, var->sequencePos);
 	
-	for(i = 0; i < sizeOfSet(fullDomain) && solutionsLeft(solset); i++) {
-		addLog("Trying value %d for variable X%d.\n", values[i], var->index);
+	for(i = 0; i < sizeOfSet(fullDomain) && !sinkFull(sink); i++) {
+		traceEvent(s, TRACE_SEARCH, EVENT_TRY, values[i], var->index, 0);
 		p->assignCount++;
 		setDomainOfVar(var, createSingletonDomain(values[i]));
 		Backup backup = emptyBackup();	
-		if(isConsistent(var, p, backup)) {
-		  recursiveBacktracking(p, solset);	
+		if(isConsistent(s, var, p, backup)) {
+		  recursiveBacktracking(s, p, sink);	
+		} else {
+		  s->stats.failures++;
 		}
 		restoreBackup(backup, p);
 		freeIntegerSet(domainOfVar(var));
@@ -751,13 +980,15 @@ void recursiveBacktracking(Problem p, SolutionSet solset) {
 	resetVar(p, var, sequencePos, fullDomain);
 }
 
-int checkConstantConstraints(Problem p) {
+int checkConstantConstraints(Solver s, Problem p) {
 	int i;
 	for(i = 0; i < p->constraintCount; i++) {
 		if(arityOfConstraint(p->constraints[i]) == 0 && 
 		   !satisfiable(p->constraints[i], p)) {
-			addLog("constant constraint %d is not satisfiable:\n", i);
-			printConstraint(p->constraints[i]);
+			traceText(s, TRACE_INFO, "constant constraint %d is not satisfiable:\n", i);
+			if(TRACING(s, TRACE_INFO)) {
+				printConstraint(s->log, p->constraints[i]);
+			}
 			return 0;
 		}
 	}
@@ -765,36 +996,16 @@ int checkConstantConstraints(Problem p) {
 }
 
 
-SolutionSet solve(Problem p) {
+/* maximum amount of solutions requested by the problem, -1 for all */
+int solutionLimit(Problem p) {
+	return (p->solvespec.type == SOLVEALL ? -1 : p->solvespec.max);
+}
+
+/* makes p initially consistent and searches it, if that left any solution */
+static void initAndSearch(Solver s, Problem p, SolutionSink sink) {
 	int i;
-	
-	/* set right function pointers */
-	if(MRV) {
-		varOrdered = mrvOrdered;
-		if(DEGREE_HEURISTIC) {
-			varOrdered = mrvPlusDegreeOrdered;
-		} else if(MOSTCONNECTED) {
-		  varOrdered = mrvPlusConnectedOrdered;
-		}
-	} else if(MOSTCONNECTED) {
-	  varOrdered = mostConnectedOrdered;
-	} else {
-		varOrdered = skipTest;
-	}
-	
-	inArcsQueue = safeMalloc(p->constraintCount * sizeof(int *));
-	for(i = 0; i < p->constraintCount; i++) {
-		inArcsQueue[i] = safeCalloc(p->varCount, sizeof(int));
-	}
-	
-	SolutionSet solset = newSolutionSet(p->varCount, 
-			(p->solvespec.type == SOLVEALL ? -1 : p->solvespec.max));
-	
-	p->varSequence = emptyVarSeq();
-	
-	addLog("\n####################################################\n");	
-	
-	if(checkConstantConstraints(p)) {	
+	startPhase(s, PHASE_INIT);
+	if(checkConstantConstraints(s, p)) {	
 	  /* for all constraints of problem */
 	  for(i = 0; i < p->constraintCount; i++) {
 	    Constraint c = constraintByIndex(p, i);
@@ -816,22 +1027,221 @@ SolutionSet solve(Problem p) {
 	    }
 	  }	  
 	  
-	  init(p);
-		int i;
-		for(i = 0; i < p->varCount; i++) {
-			insertVarInSequence(p->varSequence, varByIndex(p, i));
+	  /* a global counts as the binary constraints it replaces */
+	  for(i = 0; i < p->globalCount; i++) {
+	    Global g = p->globals[i];
+	    int j, k;
+	    for(j = 0; j < g->varCount; j++) {
+	      for(k = 1; k < g->varCount; k++) {
+	        plusDegree(varByIndex(p, g->vars[j]));
+	        plusVarConnections(varByIndex(p, g->vars[j]));
+	      }
+	    }
+	    /* the result of a maximum, minimum or element is connected to all its variables */
+	    for(j = 0; g->result >= 0 && j < g->varCount; j++) {
+	      plusDegree(varByIndex(p, g->result));
+	      plusVarConnections(varByIndex(p, g->result));
+	    }
+	  }
+	  
+	  if(init(s, p)) {
+		  int i;
+		  for(i = 0; i < p->varCount; i++) {
+			  insertVarInSequence(p->varSequence, varByIndex(p, i));
+		  }
+		  endPhase(s, PHASE_INIT);
+		  startPhase(s, PHASE_SEARCH);
+		  recursiveBacktracking(s, p, sink);
+		  endPhase(s, PHASE_SEARCH);
+	  }
+	}
+}
+
+/* 
+  Searches p, passing every solution to sink as soon as it is found.
+  Returns the amount of solutions found, or -1 if solving failed on an error.
+*/
+static int searchToSink(Solver s, Problem p, SolutionSink sink) {
+	jmp_buf recovery, *outer = solveRecovery;
+	volatile int failed = 0;
+	int i;
+	int (*varOrdered)(Variable, Variable);
+	
+	/* set right function pointers */
+	if(s->mrv) {
+		varOrdered = mrvOrdered;
+		if(s->degreeHeuristic) {
+			varOrdered = mrvPlusDegreeOrdered;
+		} else if(s->mostConnected) {
+		  varOrdered = mrvPlusConnectedOrdered;
 		}
-		recursiveBacktracking(p, solset);
+	} else if(s->mostConnected) {
+	  varOrdered = mostConnectedOrdered;
+	} else {
+		varOrdered = skipTest;
 	}
+	s->initdone = 0;
 	
+	if(s->alldiff) {
+		int cliques = promoteCliques(p);
+		traceText(s, TRACE_INFO, "alldiff: %d cliques of '<>' constraints promoted, %d constraints left\n",
+		  cliques, p->constraintCount);
+	}
+	if(s->maxmin) {
+		int extrema = promoteExtrema(p);
+		traceText(s, TRACE_INFO, "maxmin: %d max and min constraints promoted, %d constraints left\n",
+		  extrema, p->constraintCount);
+	}
+	/* arrays indexed by variables are only propagated as element constraints */
+	int elements = promoteElements(p);
+	if(elements > 0) {
+		traceText(s, TRACE_INFO, "element: %d element constraints promoted, %d constraints left\n",
+		  elements, p->constraintCount);
+	}
+	/* tables are only propagated as table constraints */
+	int tables = promoteTables(p);
+	if(tables > 0) {
+		traceText(s, TRACE_INFO, "table: %d table constraints promoted, %d constraints left\n",
+		  tables, p->constraintCount);
+	}
+	/* sums of any(X = v) compared with a variable or constant are only propagated as counts */
+	int counts = promoteCounts(p);
+	if(counts > 0) {
+		traceText(s, TRACE_INFO, "count: %d count constraints promoted, %d constraints left\n",
+		  counts, p->constraintCount);
+	}
+	/* disjunctions of literals are only propagated as clauses */
+	int clauses = promoteClauses(p);
+	if(clauses > 0) {
+		traceText(s, TRACE_INFO, "clause: %d clauses promoted, %d constraints left\n",
+		  clauses, p->constraintCount);
+	}
+	/* the other disjunctions get globals that watch two of their disjuncts */
+	int disjunctions = addDisjunctions(p);
+	if(disjunctions > 0) {
+		traceText(s, TRACE_INFO, "disjunction: %d disjunctions watched\n", disjunctions);
+	}
+	
+	s->inArcsQueue = safeMalloc(p->constraintCount * sizeof(int *));
 	for(i = 0; i < p->constraintCount; i++) {
-		free(inArcsQueue[i]);
+		s->inArcsQueue[i] = safeCalloc(p->varCount, sizeof(int));
 	}
-	free(inArcsQueue);
 	
-	fprintf(logFile, "backtracking points: %ld\n", stateCount);
+	s->solutionValues = safeMalloc(p->varCount * sizeof(int));
+	
+	p->varSequence = emptyVarSeq(varOrdered);
+	
+	traceText(s, TRACE_INFO, "\n####################################################\n");	
+	
+	startProfiling(s, p);
+	solveRecovery = &recovery;
+	if(setjmp(recovery)) {
+		failed = 1;
+		endPhase(s, PHASE_SEARCH);
+	} else {
+		initAndSearch(s, p, sink);
+	}
+	solveRecovery = outer;
+	endPhase(s, PHASE_INIT);
+	stopProfiling(s, p);
+	
+	for(i = 0; i < p->constraintCount; i++) {
+		free(s->inArcsQueue[i]);
+	}
+	free(s->inArcsQueue);
+	free(s->solutionValues);
+	
+	if(sink->finish != NULL) {
+		sink->finish(sink);
+	}
 	
-	printf("%ld\n", stateCount);
+	traceText(s, TRACE_INFO, "backtracking points: %ld\n", s->stateCount);
 					 
+	return (failed ? -1 : sink->count);
+}
+
+/* what the sink of a reduced problem passes on to the sink of the original problem */
+typedef struct expansion {
+	Presolved pre;
+	SolutionSink sink;
+	int *values;
+} expansion;
+
+void emitExpanded(SolutionSink reduced, int *values, int varCount) {
+	expansion *e = reduced->data;
+	expandSolution(e->pre, values, e->values);
+	e->sink->emit(e->sink, e->values, e->pre->varCount);
+	e->sink->count++;
+	/* the sink may have stopped the search from its emit */
+	if(sinkFull(e->sink)) {
+		reduced->limit = reduced->count + 1;
+	}
+}
+
+/* presolves p into pre and searches the reduced problem */
+static int presolveToSink(Solver s, Problem p, Presolved pre, SolutionSink sink) {
+	SolutionSink reduced;
+	expansion e;
+	int failed = 0;
+
+	presolveProblem(pre);
+	if(TRACING(s, TRACE_INFO)) {
+		printPresolveReport(s->log, pre);
+	}
+	if(pre->problem != NULL) {
+		e.pre = pre;
+		e.sink = sink;
+		e.values = safeMalloc(p->varCount * sizeof(int));
+		reduced = newSolutionSink(NULL, (sink->limit < 0 ? -1 : sink->limit - sink->count));
+		reduced->data = &e;
+		reduced->emit = emitExpanded;
+		failed = (searchToSink(s, pre->problem, reduced) < 0);
+		freeSolutionSink(reduced);
+		free(e.values);
+	}
+	if(sink->finish != NULL) {
+		sink->finish(sink);
+	}
+	return (failed ? -1 : sink->count);
+}
+
+/* 
+  Solves problem p, passing every solution to sink as soon as it is found.
+  Returns the amount of solutions found, or -1 if solving failed on an error,
+  e.g. a division by zero, that has been reported on stderr.
+*/
+int solveToSink(Solver s, Problem p, SolutionSink sink) {
+	jmp_buf recovery;
+	/* the search recovers from its own errors, this catches those of presolve */
+	volatile Presolved pre = NULL;
+	int count;
+
+	solveRecovery = &recovery;
+	if(setjmp(recovery)) {
+		if(sink->finish != NULL) {
+			sink->finish(sink);
+		}
+		count = -1;
+	} else if(s->presolve) {
+		pre = newPresolved(p);
+		count = presolveToSink(s, p, pre, sink);
+	} else {
+		count = searchToSink(s, p, sink);
+	}
+	solveRecovery = NULL;
+	if(pre != NULL) {
+		freePresolved(pre);
+	}
+	return count;
+}
+
+SolutionSet solve(Solver s, Problem p) {
+	SolutionSet solset = newSolutionSet(p->varCount, solutionLimit(p));
+	SolutionSink sink = newCollectSink(solset);
+	/* the error has been reported, there is no solution set to return */
+	if(solveToSink(s, p, sink) < 0) {
+		exit(-1);
+	}
+	freeSolutionSink(sink);
 	return solset;
 }
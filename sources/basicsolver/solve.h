@@ -6,7 +6,45 @@
 #include <assert.h>
 #include "variable.h"
 #include "problem.h"
-#include <stdarg.h>
+#include "backup.h"
+#include "trace.h"
+#include "stats.h"
+#include "profile.h"
+
+/*
+  A solver holds the options and all state of a search, so that several
+  solvers can run at the same time in different threads. A solver solves
+  one problem at a time.
+*/
+typedef struct solver {
+	/* which techniques should be applied while solving CSP, see copySolverOptions */
+	int makeConsistent;			/* OFF/NODE/ARC */
+	int mrv;					/* ON/OFF */
+	int degreeHeuristic;		/* ON/OFF */
+	int mostConnected;			/* ON/OFF */
+	int cp;						/* OFF/FC/MAC */
+	int presolve;				/* ON/OFF */
+	int alldiff;				/* ON/OFF */
+	int maxmin;					/* ON/OFF */
+	
+	/* set based on the applied techniques */
+	int (*propagationSuccess)(Solver, Variable, Problem, Backup);
+	
+	/* marks the directed arcs (constraint, variable) that are in the arc queue */
+	int **inArcsQueue;
+	int initdone;
+	/* counts the amount of backtracking calls */
+	long stateCount;
+	/* buffer holding the assignment that is passed to the solution sink */
+	int *solutionValues;
+	
+	FILE *log;					/* NULL: no log */
+	int traceLevel;
+	traceRing *ring;
+	statistics stats;
+	int profiling;				/* amount of constraints in the report, 0: off */
+	constraintProfile *profiles;
+} solver;
 
 typedef struct solutionSet *SolutionSet;
 typedef struct solutionList *SolutionList;
@@ -24,17 +62,49 @@ typedef struct solutionSet {
 	int solutionCount;
 } solutionSet;
 
+/* 
+  A solution sink receives every solution at the moment the search finds it.
+  emit is called with the values of all variables (indexed by variable index),
+  finish once after the search has ended. limit is the maximum number of
+  solutions the sink accepts, -1 for no limit.
+*/
+typedef struct solutionSink *SolutionSink;
+
+typedef struct solutionSink {
+	void (*emit)(SolutionSink sink, int *values, int varCount);
+	void (*finish)(SolutionSink sink);
+	int (*callback)(const int *values, int varCount, void *data);
+	FILE *out;
+	void *data;
+	int count;
+	int limit;
+} solutionSink;
+
+SolutionSink newTextSink(FILE *out, int limit);
+SolutionSink newBinarySink(FILE *out, int varCount, int limit);
+SolutionSink newCountSink(int limit);
+SolutionSink newCollectSink(SolutionSet solset);
+SolutionSink newCallbackSink(int (*callback)(const int *values, int varCount, void *data), void *data, int limit);
+int sinkFull(SolutionSink sink);
+void freeSolutionSink(SolutionSink sink);
+
 SolutionSet newSolutionSet(int varAmount, int solutionSpace);
 void addSolution(SolutionSet solset, Problem p);
 int solutionsLeft(SolutionSet solset);
 void freeSolutionSet(SolutionSet solset);
 void printSolution(int *solution, int varCount);
 
-void addLog(const char * format, ...);
-int init(Problem p);
-Problem backtrack(Problem p);
-SolutionSet solve(Problem p);
-void enableHeuristics(int argc, char **argv);
+Solver newSolver();
+void copySolverOptions(Solver to, Solver from);
+void resetSolver(Solver s);
+void freeSolver(Solver s);
+void enableHeuristics(Solver s, int argc, char **argv);
+int init(Solver s, Problem p);
+void addVariableArcs(Solver s, Variable var, Queue arcQueue, Problem p);
+SolutionSet solve(Solver s, Problem p);
+int solveToSink(Solver s, Problem p, SolutionSink sink);
+void solveFailed(int status);
+int solutionLimit(Problem p);
 
 
 #endif
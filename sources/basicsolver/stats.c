@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include "datatypes.h"
+#include "solve.h"
+
+volatile sig_atomic_t statisticsRequest = 0;
+
+/*
+  The solver reported on at exit and on signals, if any. This state is
+  process-wide because atexit and signal handlers take no arguments. Only
+  the solver program sets it, with enableStatistics; the library, the
+  daemon and batch workers never do.
+*/
+static Solver reportSolver = NULL;
+static int textReport = 0;
+static char *jsonReport = NULL;
+static char *reportInput = NULL;
+static volatile sig_atomic_t interrupted = 0;
+
+double secondsSince(struct timespec *start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec)*1.0e-9;
+}
+
+void resetStatistics(statistics *stats) {
+	memset(stats, 0, sizeof(statistics));
+	clock_gettime(CLOCK_MONOTONIC, &stats->start);
+}
+
+void startPhase(Solver s, Phase phase) {
+	if(statisticsRequest) {
+		handleStatisticsRequest(s);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &s->stats.phaseStart[phase]);
+	s->stats.phaseRunning[phase] = 1;
+}
+
+void endPhase(Solver s, Phase phase) {
+	if(s->stats.phaseRunning[phase]) {
+		s->stats.phaseTime[phase] += secondsSince(&s->stats.phaseStart[phase]);
+		s->stats.phaseRunning[phase] = 0;
+	}
+	if(statisticsRequest) {
+		handleStatisticsRequest(s);
+	}
+}
+
+/* time spent in phase so far, including a phase that is still running */
+double phaseSeconds(Solver s, Phase phase) {
+	double t = s->stats.phaseTime[phase];
+	if(s->stats.phaseRunning[phase]) {
+		t += secondsSince(&s->stats.phaseStart[phase]);
+	}
+	return t;
+}
+
+long peakMemory() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+double nodesPerSecond(Solver s) {
+	double t = phaseSeconds(s, PHASE_SEARCH);
+	return (t > 0 ? s->stateCount / t : 0);
+}
+
+double totalSeconds(Solver s) {
+	return secondsSince(&s->stats.start) + phaseSeconds(s, PHASE_GROUND);
+}
+
+void printStatistics(FILE *out, Solver s) {
+	fprintf(out, "Statistics%s:\n", (interrupted ? " (interrupted)" : ""));
+	fprintf(out, "  ground:       %10.6f s\n", phaseSeconds(s, PHASE_GROUND));
+	fprintf(out, "  parse:        %10.6f s\n", phaseSeconds(s, PHASE_PARSE));
+	fprintf(out, "  init:         %10.6f s\n", phaseSeconds(s, PHASE_INIT));
+	fprintf(out, "  search:       %10.6f s\n", phaseSeconds(s, PHASE_SEARCH));
+	fprintf(out, "  total:        %10.6f s\n", totalSeconds(s));
+	fprintf(out, "  nodes:        %10ld\n", s->stateCount);
+	fprintf(out, "  nodes/s:      %10.0f\n", nodesPerSecond(s));
+	fprintf(out, "  failures:     %10ld\n", s->stats.failures);
+	fprintf(out, "  propagations: %10ld\n", s->stats.propagations);
+	fprintf(out, "  revisions:    %10ld\n", s->stats.revisions);
+	fprintf(out, "  pruned:       %10ld\n", s->stats.pruned);
+	fprintf(out, "  max depth:    %10d\n", s->stats.maxDepth);
+	fprintf(out, "  solutions:    %10ld\n", s->stats.solutions);
+	fprintf(out, "  peak memory:  %10ld KB\n", peakMemory());
+}
+
+/* prints str as a JSON string, escaping quotes, backslashes and control characters */
+void printJSONString(FILE *out, char *str) {
+	fputc('"', out);
+	for(; *str != '\0'; str++) {
+		if(*str == '"' || *str == '\\') {
+			fprintf(out, "\\%c", *str);
+		} else if((unsigned char)*str < 0x20) {
+			fprintf(out, "\\u%04x", *str);
+		} else {
+			fputc(*str, out);
+		}
+	}
+	fputc('"', out);
+}
+
+void writeStatisticsJSON(char *path, Solver s) {
+	FILE *out = fopen(path, "a");
+	if(out == NULL) {
+		fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+		return;
+	}
+	fprintf(out, "{\"input\":");
+	printJSONString(out, reportInput);
+	fprintf(out, ",\"status\":\"%s\"", (interrupted ? "interrupted" : "done"));
+	fprintf(out, ",\"ground_s\":%.6f", phaseSeconds(s, PHASE_GROUND));
+	fprintf(out, ",\"parse_s\":%.6f", phaseSeconds(s, PHASE_PARSE));
+	fprintf(out, ",\"init_s\":%.6f", phaseSeconds(s, PHASE_INIT));
+	fprintf(out, ",\"search_s\":%.6f", phaseSeconds(s, PHASE_SEARCH));
+	fprintf(out, ",\"total_s\":%.6f", totalSeconds(s));
+	fprintf(out, ",\"nodes\":%ld", s->stateCount);
+	fprintf(out, ",\"nodes_per_s\":%.0f", nodesPerSecond(s));
+	fprintf(out, ",\"failures\":%ld", s->stats.failures);
+	fprintf(out, ",\"propagations\":%ld", s->stats.propagations);
+	fprintf(out, ",\"revisions\":%ld", s->stats.revisions);
+	fprintf(out, ",\"pruned\":%ld", s->stats.pruned);
+	fprintf(out, ",\"max_depth\":%d", s->stats.maxDepth);
+	fprintf(out, ",\"solutions\":%ld", s->stats.solutions);
+	fprintf(out, ",\"peak_rss_kb\":%ld}\n", peakMemory());
+	fclose(out);
+}
+
+void reportStatistics() {
+	if(textReport) {
+		printStatistics(stderr, reportSolver);
+	}
+	if(jsonReport != NULL) {
+		writeStatisticsJSON(jsonReport, reportSolver);
+	}
+}
+
+/*
+  SIGUSR1 only requests a report. SIGINT and SIGTERM end the run. Either is
+  only recorded here and handled at the next search node or phase boundary,
+  as reporting uses stdio, which is not safe in a signal handler.
+*/
+void statisticsSignal(int sig) {
+	if(sig != SIGUSR1) {
+		interrupted = 1;
+	}
+	statisticsRequest = sig;
+}
+
+void handleStatisticsRequest(Solver s) {
+	int sig;
+	if(s != reportSolver) {
+		return;
+	}
+	sig = statisticsRequest;
+	statisticsRequest = 0;
+	if(sig == SIGUSR1) {
+		printStatistics(stderr, s);
+		return;
+	}
+	interrupted = 1;
+	exit(EXIT_FAILURE);
+}
+
+void enableStatistics(Solver s, int text, char *jsonFile, char *inputName) {
+	char *ground = getenv("CSP_GROUND_TIME");
+	if(ground != NULL) {
+		s->stats.phaseTime[PHASE_GROUND] = atof(ground);
+	}
+
+	if(!text && jsonFile == NULL) {
+		return;
+	}
+	reportSolver = s;
+	textReport = text;
+	jsonReport = jsonFile;
+	reportInput = inputName;
+	atexit(reportStatistics);
+	signal(SIGUSR1, statisticsSignal);
+	signal(SIGINT, statisticsSignal);
+	signal(SIGTERM, statisticsSignal);
+}
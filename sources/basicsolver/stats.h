@@ -0,0 +1,50 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "problem.h"
+#include <signal.h>
+#include <time.h>
+
+/*
+ * Statistics of a solver run, kept in the solver. The counters are always
+ * collected; the solver program reports them at exit (also when the run is
+ * interrupted) if enabled with -stats (text on stderr) and/or -statsjson
+ * FILE (one JSON object per run, appended to FILE). SIGUSR1 reports the
+ * statistics of a running search without stopping it.
+ *
+ * Phases are timed with the monotonic clock. The ground phase is done by
+ * csp, which passes its duration in the environment variable
+ * CSP_GROUND_TIME.
+ */
+
+typedef enum {
+	PHASE_GROUND, PHASE_PARSE, PHASE_INIT, PHASE_SEARCH, PHASE_COUNT
+} Phase;
+
+typedef struct statistics {
+	struct timespec start;
+	struct timespec phaseStart[PHASE_COUNT];
+	int phaseRunning[PHASE_COUNT];
+	double phaseTime[PHASE_COUNT];
+	long failures;
+	long propagations;
+	long revisions;
+	long pruned;
+	long solutions;
+	int maxDepth;
+} statistics;
+
+/* set by the signal handler, checked once per search node and when a phase starts or ends */
+extern volatile sig_atomic_t statisticsRequest;
+
+void resetStatistics(statistics *stats);
+void startPhase(Solver s, Phase phase);
+void endPhase(Solver s, Phase phase);
+void enableStatistics(Solver s, int text, char *jsonFile, char *inputName);
+void handleStatisticsRequest(Solver s);
+void printStatistics(FILE *out, Solver s);
+void printJSONString(FILE *out, char *str);
+
+#endif
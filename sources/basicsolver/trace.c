@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "datatypes.h"
+#include "solve.h"
+
+void setTraceLevel(Solver s, int level) {
+	if(level > TRACE_MAX) {
+		fprintf(stderr, "[WARNING] Trace level %d not compiled in, using %d.\n", level, TRACE_MAX);
+		level = TRACE_MAX;
+	}
+	s->traceLevel = level;
+}
+
+void recordTraceEvent(Solver s, int type, int a, int b, int c) {
+	if(s->ring == NULL) {
+		s->ring = safeCalloc(1, sizeof(traceRing));
+	}
+	traceRecord *r = &s->ring->records[s->ring->count & (TRACE_RING_SIZE-1)];
+	r->state = s->stateCount;
+	r->type = type;
+	r->args[0] = a;
+	r->args[1] = b;
+	r->args[2] = c;
+	s->ring->count++;
+}
+
+void printTraceRecord(FILE *out, traceRecord *r) {
+	fprintf(out, "[%ld] ", r->state);
+	switch(r->type) {
+		case EVENT_TRY:
+			fprintf(out, "Trying value %d for variable X%d.\n", r->args[0], r->args[1]);
+			break;
+		case EVENT_FC:
+			fprintf(out, "forward checking based on assignment of variable X%d\n", r->args[0]);
+			break;
+		case EVENT_MAC:
+			fprintf(out, "Maintaining arc consistency after assignment of variable X%d\n", r->args[0]);
+			break;
+		case EVENT_LIMIT:
+			fprintf(out, "X%d = %d -> Domain limited of variable X%d.\n", r->args[0], r->args[1], r->args[2]);
+			break;
+	}
+}
+
+/* formats the search events still in the ring buffer to the log, oldest first */
+void flushTrace(Solver s) {
+	long i, first = 0;
+	traceRing *ring = s->ring;
+	if(ring == NULL || ring->count == 0 || s->log == NULL) {
+		return;
+	}
+	if(ring->count > TRACE_RING_SIZE) {
+		first = ring->count - TRACE_RING_SIZE;
+	}
+	fprintf(s->log, "# Last %ld of %ld search events:\n", ring->count - first, ring->count);
+	for(i = first; i < ring->count; i++) {
+		printTraceRecord(s->log, &ring->records[i & (TRACE_RING_SIZE-1)]);
+	}
+	ring->count = 0;
+}
@@ -0,0 +1,61 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "problem.h"
+
+/*
+ * Tracing of the solver. A trace point is only executed if its level is at
+ * most TRACE_MAX (fixed at compile time, make TRACE_MAX=n) and at most the
+ * trace level of the solver (set at startup with -trace n). Trace points
+ * above TRACE_MAX are removed by the compiler, the others cost a single
+ * comparison when disabled: the arguments are not evaluated and no function
+ * is called.
+ *
+ * TRACE_INFO   formatted text in the log: initialisation and results
+ * TRACE_SEARCH search events (tried values, propagation, domain reductions),
+ *              stored as binary records in a ring buffer
+ * TRACE_DETAIL formatted text in the log: domains after initialisation
+ */
+
+#define TRACE_OFF 0
+#define TRACE_INFO 1
+#define TRACE_SEARCH 2
+#define TRACE_DETAIL 3
+
+#ifndef TRACE_MAX
+#define TRACE_MAX TRACE_DETAIL
+#endif
+
+/* number of search events kept, must be a power of 2 */
+#define TRACE_RING_SIZE 4096
+
+typedef enum {
+	EVENT_TRY, EVENT_FC, EVENT_MAC, EVENT_LIMIT
+} TraceEventType;
+
+typedef struct traceRecord {
+	long state;
+	int type;
+	int args[3];
+} traceRecord;
+
+typedef struct traceRing {
+	traceRecord records[TRACE_RING_SIZE];
+	long count;
+} traceRing;
+
+#define TRACING(s, level) ((level) <= TRACE_MAX && (level) <= (s)->traceLevel)
+
+#define traceText(s, level, ...) \
+	do { if(TRACING(s, level)) fprintf((s)->log, __VA_ARGS__); } while(0)
+
+#define traceEvent(s, level, type, a, b, c) \
+	do { if(TRACING(s, level)) recordTraceEvent(s, type, a, b, c); } while(0)
+
+void setTraceLevel(Solver s, int level);
+void recordTraceEvent(Solver s, int type, int a, int b, int c);
+void flushTrace(Solver s);
+
+#endif
@@ -6,9 +6,8 @@
 #include "problem.h"
 #include "variable.h"
 #include "solve.h"
+#include "profile.h"
 
-extern FILE *logFile;
-extern int (*varOrdered)(Variable, Variable);
   
 /* BEGIN functions Variable */
 Variable newVariable(int varIndex, DataType d) {
@@ -20,6 +19,7 @@ Variable newVariable(int varIndex, DataType d) {
 	v->type = d;
 	v->domain = emptyIntegerSet();
 	v->constraints = emptyIntegerSet();
+	v->globals = emptyIntegerSet();
 	v->sequencePos = NULL;	
 	return v;
 }
@@ -32,6 +32,7 @@ void freeVariable(Variable v) {
   if(v != NULL) {
 	  freeIntegerSet(v->domain);
 	  freeIntegerSet(v->constraints);
+	  freeIntegerSet(v->globals);
 	  free(v);
 	}
 }
@@ -106,18 +107,18 @@ IntegerSet createSingletonDomain(int value) {
 	return singleton;
 }
 
-void printDomainOfVar(Variable v) {
+void printDomainOfVar(FILE *out, Variable v) {
   IntegerSet domain = v->domain;
 	int i;
 	int *values = valuesOfSet(domain);
-	addLog("[");
+	fprintf(out, "[");
 	if(sizeOfSet(domain) > 0) {
-		addLog("%d", values[0]);
+		fprintf(out, "%d", values[0]);
 	}
 	for(i = 1; i < sizeOfSet(domain); i++) {
-		addLog(", %d", values[i]);
+		fprintf(out, ", %d", values[i]);
 	}
-	addLog("]");
+	fprintf(out, "]");
 }
 
 int singletonDomain(IntegerSet domain) {
@@ -156,40 +157,44 @@ VarList newVarList(int varIndex, VarList next) {
  * 
 */ 
 void freeVarList(VarList vl) {
-	if(vl != NULL) {
-		freeVarList(vl->next);
+	VarList next;
+	while(vl != NULL) {
+		next = vl->next;
 		free(vl);
+		vl = next;
 	}
 }
 
 /*
- * creates a Variable, given  to a VarList
+ * appends varIndex after *last, the last item of a VarList, and updates last
 */ 
-void addVar(VarList vl, int varIndex) {
-	VarList end = vl;
-	while(end->next != NULL) {
-		end = end->next;
-	}
-	end->next = newVarList(varIndex, NULL);
+void addVar(VarList *last, int varIndex) {
+	(*last)->next = newVarList(varIndex, NULL);
+	*last = (*last)->next;
 }
 
 /*
- * 
+ * appends toAdd, of type d, to vl; last is the last item of vl and is
+ * updated, both are NULL for an empty list
 */ 
-VarList addVars(VarList vl, DataType d, VarList toAdd) {
+VarList addVars(VarList vl, VarList *last, DataType d, VarList toAdd) {
 	VarList tempList = toAdd;
+	if(toAdd == NULL) {
+		return vl;
+	}
 	while(tempList != NULL) {
 		tempList->varType = d;
+		if(tempList->next == NULL) {
+			break;
+		}
 		tempList = tempList->next;
 	}
 	if(vl == NULL) {
-		return toAdd;
-	}
-	tempList = vl;
-	while(tempList->next != NULL) {
-		tempList = tempList->next;
+		vl = toAdd;
+	} else {
+		(*last)->next = toAdd;
 	}
-	tempList->next = toAdd;
+	*last = tempList;
 	return vl;
 }
 
@@ -202,14 +207,14 @@ VarList addVars(VarList vl, DataType d, VarList toAdd) {
 /*
  * 
 */ 
-void printVar(Variable v) {
-	addLog("X%d : %s\n", v->index, (v->type == INTEGER ? "integer" : "boolean"));
-	addLog("\tDomain(%d): ", sizeOfSet(v->domain));
-	printDomainOfVar(v);
-	addLog("\n");
-	addLog("\tDegree(%d): \n", v->constraintDegree);
-	addLog("\tConnectivity(%d): \n", v->connectivity);
-	addLog("\n");
+void printVar(FILE *out, Variable v) {
+	fprintf(out, "X%d : %s\n", v->index, (v->type == INTEGER ? "integer" : "boolean"));
+	fprintf(out, "\tDomain(%d): ", sizeOfSet(v->domain));
+	printDomainOfVar(out, v);
+	fprintf(out, "\n");
+	fprintf(out, "\tDegree(%d): \n", v->constraintDegree);
+	fprintf(out, "\tConnectivity(%d): \n", v->connectivity);
+	fprintf(out, "\n");
 }
 
 
@@ -221,9 +226,10 @@ void printVar(Variable v) {
 /*
  * 
 */ 
-VarSeq emptyVarSeq() {
+VarSeq emptyVarSeq(int (*ordered)(Variable, Variable)) {
 	VarSeq seq = safeMalloc(sizeof(varSeq));
 	seq->first = NULL;
+	seq->ordered = ordered;
 	return seq;
 }
 
@@ -348,12 +354,12 @@ void resortVarSeq(VarSeq sequence, VarPos position) {
 	VarPos next = position->next;
 	VarPos prev = position->prev;
 	/* shift to right as long as needed */
-	while(next != NULL && !varOrdered(position->var, next->var)) { 	
+	while(next != NULL && !sequence->ordered(position->var, next->var)) { 	
 		prev = next;
 		next = next->next;
 	}
 	/* shift to left as long as needed */
-	while(prev != NULL && !varOrdered(prev->var, position->var)) {	
+	while(prev != NULL && !sequence->ordered(prev->var, position->var)) {	
 		next = prev;
 		prev = prev->prev;
 	}
@@ -369,7 +375,7 @@ void assertSequenceSorted(VarSeq sequence) {
   VarPos first = sequence->first;
   VarPos second = first->next;
   while(second != NULL) {
-    assert(varOrdered(first->var, second->var));
+    assert(sequence->ordered(first->var, second->var));
     first = second;
     second = second->next;
   }
@@ -417,14 +423,14 @@ Variable varAtPosition(VarSeq seq, VarPos pos) {
  * - the domains of the variable
  * - the degree (constraints with unassigned variables) of the variable
 */
-void printVarSequence(VarSeq sequence) {
+void printVarSequence(FILE *out, VarSeq sequence) {
 	VarPos pos = sequence->first;
-	addLog("BEGIN Sequence of variables: \n");	
+	fprintf(out, "BEGIN Sequence of variables: \n");	
 	while(pos != NULL) {
-		printVar(pos->var);
+		printVar(out, pos->var);
 		pos = pos->next;
 	}
-	addLog("END Sequence of variables: \n");
+	fprintf(out, "END Sequence of variables: \n");
 }
 
 /* 
@@ -486,49 +492,63 @@ int skipTest(Variable first, Variable second) {
 /* END Functions VarSequence */
 
 
-int nodeReduce(Variable v, Constraint c, Problem p) {
+int nodeReduce(Solver s, Variable v, Constraint c, Problem p) {
 	IntegerSet domain = domainOfVar(v);
 	int *values = valuesOfSet(domain);
 	int changed = 0;
 	int remove, i;
+	int before = sizeOfSet(domain);
+	unsigned long long start = (s->profiling ? profileTicks() : 0);
 	if(arityOfConstraint(c) != 1) {
 		return 0;
 	}
+	s->stats.revisions++;
 	for(i = 0; i < sizeOfSet(domain); i++) {
 		setDomainOfVar(v, createSingletonDomain(values[i]));
 		remove = !checkConstraint(c, p);
 		freeIntegerSet(domainOfVar(v));
 		if(remove) {
+			s->stats.pruned++;
 			changed = 1;
 			removeNthIntegerFromSet(domain, i);
 			i--;
 		}
 	}
 	setDomainOfVar(v, domain);
+	if(s->profiling) {
+		profileRevision(s, c, before - sizeOfSet(domain), sizeOfSet(domain) == 0, start);
+	}
 	return changed;
 }
 
-int arcReduce(DirectedArc arc, Problem p) {
+int arcReduce(Solver s, DirectedArc arc, Problem p) {
   Variable v = firstVarOfArc(arc);
   Constraint c = constraintOfArc(arc);
 	IntegerSet domain = domainOfVar(v);
 	int *values = valuesOfSet(domain);
 	int changed = 0;
 	int remove, i;
+	int before = sizeOfSet(domain);
+	unsigned long long start = (s->profiling ? profileTicks() : 0);
 	/* arity of constraint must be 2 (binary, in case of arc consistency check) or
 	    arity must be 1 (after assignment var and forwardchecking for all arcs directed at var) */
 	assert(arityOfConstraint(c) <= 2);
+	s->stats.revisions++;
 	for(i = 0; i < sizeOfSet(domain); i++) {
 		setDomainOfVar(v, createSingletonDomain(values[i]));
 		remove = !satisfiable(c, p);
 		freeIntegerSet(domainOfVar(v));
 		if(remove) {
+			s->stats.pruned++;
 			changed = 1;
 			removeNthIntegerFromSet(domain, i);
 			i--;
 		}
 	}
 	setDomainOfVar(v, domain);
+	if(s->profiling) {
+		profileRevision(s, c, before - sizeOfSet(domain), sizeOfSet(domain) == 0, start);
+	}
 	return changed;
 }
 
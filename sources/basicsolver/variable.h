@@ -25,6 +25,7 @@ typedef struct variable {
 	DataType type;
 	IntegerSet domain;
 	IntegerSet constraints;
+	IntegerSet globals;			/* indices of the global constraints of the variable */
 	VarPos sequencePos;
 } variable;
 
@@ -41,6 +42,7 @@ typedef struct varPos {
 
 typedef struct varSeq {
 	VarPos first;
+	int (*ordered)(Variable, Variable);	/* variable ordering heuristic */
 } varSeq;
 
 
@@ -66,7 +68,7 @@ void plusConnectivity(Variable v);
 
 IntegerSet createSingletonDomain(int value);
 int domainSizeOfVar(Variable v);
-void printDomainOfVar(Variable v);
+void printDomainOfVar(FILE *out, Variable v);
 int singletonDomain(IntegerSet d);
 int *domainValuesOfVar(Variable v);
 int domainMinimumOfVar(Variable v);
@@ -74,14 +76,14 @@ int domainMaximumOfVar(Variable v);
 
 VarList newVarList(int varIndex, VarList next);
 void freeVarList(VarList vl);
-void addVar(VarList vl, int varIndex);
-VarList addVars(VarList vl, DataType d, VarList toAdd);
+void addVar(VarList *last, int varIndex);
+VarList addVars(VarList vl, VarList *last, DataType d, VarList toAdd);
 Variable *varListToArray(VarList vl);
 
-void printVar(Variable v);
+void printVar(FILE *out, Variable v);
 
 
-VarSeq emptyVarSeq();
+VarSeq emptyVarSeq(int (*ordered)(Variable, Variable));
 void freeVarSeq(VarSeq sequence);
 void restoreVarSeq(VarSeq sequence, varPos backup);
 void resortVarSeq(VarSeq sequence, VarPos position);
@@ -92,7 +94,7 @@ VarPos insertVarInSequence(VarSeq sequence, Variable v);
 void removeVarFromSequence(VarSeq sequence, VarPos position);
 VarPos firstVarPosition(VarSeq sequence);
 Variable varAtPosition(VarSeq sequence, VarPos position);
-void printVarSequence(VarSeq sequence);
+void printVarSequence(FILE *out, VarSeq sequence);
 
 
 int mrvPlusDegreeOrdered(Variable first, Variable second);
@@ -101,8 +103,8 @@ int mostConnectedOrdered(Variable first, Variable second);
 int mrvPlusConnectedOrdered(Variable first, Variable second);
 int skipTest(Variable first, Variable second);
 
-int nodeReduce(Variable v, Constraint c, Problem p);
-int arcReduce(DirectedArc arc, Problem p);
+int nodeReduce(Solver s, Variable v, Constraint c, Problem p);
+int arcReduce(Solver s, DirectedArc arc, Problem p);
 
 void plusVarConnections(Variable v);
 
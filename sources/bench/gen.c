@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * Instance generators for the benchmark suite. Every generator writes a
+ * model in the input language of csp to stdout:
+ *
+ *   gen queens N              n-queens on an N x N board
+ *   gen rb N SEED             random binary CSP (model RB) at the phase transition
+ *   gen magic N               magic square of order N
+ *   gen golomb K [L]          golomb ruler with K marks and length at most L
+ *   gen sudoku GIVENS SEED    sudoku with GIVENS prefilled cells
+ *   gen load N                about N trivial constraints, to time loading
+ *
+ * Random instances only depend on SEED, not on the C library.
+ */
+
+/* known optimal golomb ruler lengths, indexed by the number of marks */
+static int golombOptimal[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
+
+static unsigned long long rngState;
+
+/* xorshift64* */
+unsigned long long nextRandom() {
+	rngState ^= rngState >> 12;
+	rngState ^= rngState << 25;
+	rngState ^= rngState >> 27;
+	return rngState * 2685821657736338717ULL;
+}
+
+int randomBelow(int n) {
+	return (int)(nextRandom() % n);
+}
+
+void seedRandom(int seed) {
+	rngState = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)seed;
+	nextRandom();
+}
+
+void shuffle(int *a, int n) {
+	int i, j, t;
+	for(i = n-1; i > 0; i--) {
+		j = randomBelow(i+1);
+		t = a[i];
+		a[i] = a[j];
+		a[j] = t;
+	}
+}
+
+void queens(int n) {
+	printf("# %d-queens\n", n);
+	printf("variables:\n\tq[%d] : integer;\n\n", n);
+	printf("domains:\n\tq <- [0..%d];\n\n", n-1);
+	printf("constraints:\n");
+	printf("\talldiff(q[0..%d]);\n", n-1);
+	printf("\tforall(i in [0..%d])\n", n-1);
+	printf("\t\tforall(j in [i+1..%d])\n", n-1);
+	printf("\t\t\tabs(q[i]-q[j]) <> j-i;\n");
+	printf("\t\tend\n\tend\n\n");
+	printf("solutions: 1\n");
+}
+
+/*
+  Model RB (Xu and Li) with alpha = 0.8 and r = 0.8: N variables with
+  domain size N^alpha, r*N*ln(N) binary constraints, each forbidding a
+  fraction p = 1 - e^(-alpha/r) of the value pairs, which is the
+  theoretical phase transition.
+*/
+void modelRB(int n, int seed) {
+	double alpha = 0.8, r = 0.8;
+	int d = (int)(pow(n, alpha) + 0.5);
+	int m = (int)(r * n * log(n) + 0.5);
+	int t = (int)((1 - exp(-alpha/r)) * d * d + 0.5);
+	int *pairs = malloc(d*d*sizeof(int));
+	int c, i, x, y;
+
+	seedRandom(seed);
+	printf("# model RB: n = %d, d = %d, m = %d, t = %d, seed = %d\n", n, d, m, t, seed);
+	printf("variables:\n\tx[%d] : integer;\n\n", n);
+	printf("domains:\n\tx <- [0..%d];\n\n", d-1);
+	printf("constraints:\n");
+	for(c = 0; c < m; c++) {
+		x = randomBelow(n);
+		do {
+			y = randomBelow(n);
+		} while(y == x);
+		for(i = 0; i < d*d; i++) {
+			pairs[i] = i;
+		}
+		shuffle(pairs, d*d);
+		/* forbid the first t pairs */
+		for(i = 0; i < t; i++) {
+			printf("\tabs(x[%d]-%d) + abs(x[%d]-%d) <> 0;\n", x, pairs[i]/d, y, pairs[i]%d);
+		}
+	}
+	printf("\nsolutions: 1\n");
+	free(pairs);
+}
+
+void magic(int n) {
+	int sum = n*(n*n+1)/2;
+	int i;
+	printf("# magic square of order %d\n", n);
+	printf("variables:\n\tsq[%d][%d] : integer;\n\n", n, n);
+	printf("domains:\n\tsq <- [1..%d];\n\n", n*n);
+	printf("constraints:\n");
+	printf("\talldiff(sq[0..%d][0..%d]);\n", n-1, n-1);
+	printf("\tforall(i in [0..%d])\n", n-1);
+	printf("\t\tsum(sq[i][0..%d]) = %d;\n", n-1, sum);
+	printf("\t\tsum(sq[0..%d][i]) = %d;\n", n-1, sum);
+	printf("\tend\n");
+	printf("\tsq[0][0]");
+	for(i = 1; i < n; i++) {
+		printf(" + sq[%d][%d]", i, i);
+	}
+	printf(" = %d;\n", sum);
+	printf("\tsq[0][%d]", n-1);
+	for(i = 1; i < n; i++) {
+		printf(" + sq[%d][%d]", i, n-1-i);
+	}
+	printf(" = %d;\n", sum);
+	printf("\nsolutions: 1\n");
+}
+
+void golomb(int k, int length) {
+	int i, j, d = 0;
+	printf("# golomb ruler: %d marks, length at most %d\n", k, length);
+	printf("variables:\n\tm[%d] : integer;\n\tdiff[%d] : integer;\n\n", k, k*(k-1)/2);
+	printf("domains:\n\tm <- [0..%d];\n\tdiff <- [1..%d];\n\n", length, length);
+	printf("constraints:\n");
+	printf("\tm[0] = 0;\n");
+	printf("\tforall(i in [0..%d])\n\t\tm[i] < m[i+1];\n\tend\n", k-2);
+	for(i = 0; i < k; i++) {
+		for(j = i+1; j < k; j++) {
+			printf("\tdiff[%d] = m[%d] - m[%d];\n", d++, j, i);
+		}
+	}
+	printf("\talldiff(diff[0..%d]);\n", d-1);
+	/* symmetry breaking: the first difference is smaller than the last */
+	printf("\tm[1] - m[0] < m[%d] - m[%d];\n", k-1, k-2);
+	printf("\nsolutions: 1\n");
+}
+
+/*
+  A random valid grid is made by permuting digits, rows within bands,
+  columns within stacks, bands and stacks of a base pattern. Then all but
+  GIVENS cells are removed. The puzzle is solvable, not necessarily unique.
+*/
+void sudoku(int givens, int seed) {
+	int digits[9], rows[9], cols[9], bands[3], stacks[3], cells[81];
+	int grid[9][9];
+	int i, r, c, b;
+
+	seedRandom(seed);
+	for(i = 0; i < 9; i++) {
+		digits[i] = i+1;
+	}
+	shuffle(digits, 9);
+	for(i = 0; i < 3; i++) {
+		bands[i] = stacks[i] = i;
+	}
+	shuffle(bands, 3);
+	shuffle(stacks, 3);
+	for(b = 0; b < 3; b++) {
+		int inBand[3] = {0, 1, 2};
+		int inStack[3] = {0, 1, 2};
+		shuffle(inBand, 3);
+		shuffle(inStack, 3);
+		for(i = 0; i < 3; i++) {
+			rows[b*3+i] = bands[b]*3 + inBand[i];
+			cols[b*3+i] = stacks[b]*3 + inStack[i];
+		}
+	}
+	for(r = 0; r < 9; r++) {
+		for(c = 0; c < 9; c++) {
+			int pr = rows[r], pc = cols[c];
+			grid[r][c] = digits[(pr*3 + pr/3 + pc) % 9];
+		}
+	}
+	for(i = 0; i < 81; i++) {
+		cells[i] = i;
+	}
+	shuffle(cells, 81);
+
+	printf("# sudoku: %d givens, seed = %d\n", givens, seed);
+	printf("variables:\n\tsud[9][9] : integer;\n\n");
+	printf("domains:\n\tsud <- [1..9];\n\n");
+	printf("constraints:\n");
+	printf("\tforall (i in [0..8])\n");
+	printf("\t\talldiff(sud[i][0..8]);\n");
+	printf("\t\talldiff(sud[0..8][i]);\n");
+	printf("\t\talldiff(sud[(i div 3)*3..(i div 3)*3+2][(i mod 3)*3..(i mod 3)*3+2]);\n");
+	printf("\tend\n");
+	for(i = 0; i < givens && i < 81; i++) {
+		r = cells[i] / 9;
+		c = cells[i] % 9;
+		printf("\tsud[%d][%d] = %d;\n", r, c, grid[r][c]);
+	}
+	printf("\nsolutions: 1\n");
+}
+
+/*
+  A model that is all size and no search: about n distinct binary
+  constraints over 1000 variables, every assignment satisfies them.
+*/
+void load(int n) {
+	int rounds = (n + 998) / 999;
+	printf("# load test, %d constraints\n", rounds*999);
+	printf("variables:\n\tx[1000] : integer;\n\n");
+	printf("domains:\n\tx <- [0..1];\n\n");
+	printf("constraints:\n");
+	printf("\tforall(k in [1..%d])\n", rounds);
+	printf("\t\tforall(i in [0..998])\n");
+	printf("\t\t\tx[i] + x[i+1] <= k + 1;\n");
+	printf("\t\tend\n\tend\n\n");
+	printf("solutions: 1\n");
+}
+
+void usage() {
+	fprintf(stderr, "Usage: gen queens N | rb N SEED | magic N | golomb K [L] | sudoku GIVENS SEED | load N\n");
+	exit(-1);
+}
+
+int main(int argc, char **argv) {
+	if(argc < 3) {
+		usage();
+	}
+	int n = atoi(argv[2]);
+	if(n < 1) {
+		fprintf(stderr, "[ERROR] Expecting a positive size, got '%s'.\n", argv[2]);
+		exit(-1);
+	}
+	if(!strcmp(argv[1], "queens")) {
+		queens(n);
+	} else if(!strcmp(argv[1], "rb") && argc > 3) {
+		modelRB(n, atoi(argv[3]));
+	} else if(!strcmp(argv[1], "magic")) {
+		magic(n);
+	} else if(!strcmp(argv[1], "golomb")) {
+		if(argc <= 3 && n >= sizeof(golombOptimal)/sizeof(int)) {
+			fprintf(stderr, "[ERROR] No known optimal length for %d marks, give a length.\n", n);
+			exit(-1);
+		}
+		golomb(n, (argc > 3 ? atoi(argv[3]) : golombOptimal[n]));
+	} else if(!strcmp(argv[1], "sudoku") && argc > 3) {
+		sudoku(n, atoi(argv[3]));
+	} else if(!strcmp(argv[1], "load")) {
+		load(n);
+	} else {
+		usage();
+	}
+	return 0;
+}
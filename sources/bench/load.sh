@@ -0,0 +1,44 @@
+#!/bin/sh
+#
+# Load-time benchmark: grounds and solves models of growing size that need
+# no search (gen load N) and prints the grounding and parsing time of each.
+# Both should grow linearly with the number of constraints.
+#
+# Usage: ./load.sh [SIZES]
+#   SIZES   numbers of constraints (default 10000 100000 1000000)
+#
+
+BENCH=$(cd "$(dirname "$0")" && pwd)
+SOURCES=$(dirname "$BENCH")
+GEN=$BENCH/gen
+CSP=$SOURCES/cspsolver/csp
+WORK=$BENCH/work
+SIZES=${*:-"10000 100000 1000000"}
+
+for tool in "$GEN" "$CSP"; do
+	if [ ! -x "$tool" ]; then
+		echo "[ERROR] $tool not found, run make first." >&2
+		exit 1
+	fi
+done
+
+mkdir -p "$WORK"
+cd "$WORK" || exit 1
+
+# extracts a numeric field from the last JSON statistics line
+field() {
+	tail -n 1 stats.jsonl | sed -n "s/.*\"$1\":\([0-9.]*\).*/\1/p"
+}
+
+printf "%-12s %10s %10s %10s %10s\n" "constraints" "ground (s)" "parse (s)" "total (s)" "mem (KB)"
+for size in $SIZES; do
+	"$GEN" load "$size" > "load-$size.csp" || exit 1
+	rm -f stats.jsonl
+	"$CSP" -nocache -trace 0 -statsjson stats.jsonl "load-$size.csp" < /dev/null > output.txt 2>&1
+	if [ ! -s stats.jsonl ]; then
+		printf "%-12s %10s\n" "$size" "error"
+		continue
+	fi
+	printf "%-12s %10s %10s %10s %10s\n" "$size" "$(field ground_s)" "$(field parse_s)" \
+		"$(field total_s)" "$(field peak_rss_kb)"
+done
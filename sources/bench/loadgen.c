@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/*
+ * Load generator for the solver daemon (solver -serve SOCKET):
+ *
+ *   loadgen SOCKET MODEL [CONNECTIONS [REQUESTS]]
+ *
+ * Opens CONNECTIONS connections (default 4) that together send REQUESTS
+ * requests (default 1000) for MODEL, each connection waiting for the
+ * answer before sending its next request. MODEL is a file in textual or
+ * binary normal form, e.g. translation.csp or a file written with
+ * -writenf. Prints the throughput and the latency percentiles.
+ */
+
+static char *socketPath;
+static char *model;
+static long modelSize;
+static int binaryModel;
+
+typedef struct client {
+	pthread_t thread;
+	int requests;
+	double *latencies;			/* seconds per request */
+	int errors;
+} client;
+
+double now() {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec*1.0e-9;
+}
+
+int connectToServer() {
+	struct sockaddr_un addr;
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path)-1);
+	if(fd < 0 || connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+		fprintf(stderr, "[ERROR] Could not connect to %s\n", socketPath);
+		exit(1);
+	}
+	return fd;
+}
+
+/* sends one request, reads the response up to its end line; returns 0 on an error response */
+int request(FILE *in, FILE *out) {
+	static char line[1<<16];
+	fprintf(out, "solve %s %ld\n", (binaryModel ? "nfb" : "nf"), modelSize);
+	fwrite(model, 1, modelSize, out);
+	fflush(out);
+	while(fgets(line, sizeof(line), in) != NULL) {
+		if(!strncmp(line, "end ", 4)) {
+			return 1;
+		}
+		if(!strncmp(line, "error", 5)) {
+			return 0;
+		}
+	}
+	fprintf(stderr, "[ERROR] Connection closed by the server\n");
+	exit(1);
+}
+
+void *runClient(void *arg) {
+	client *c = arg;
+	int fd = connectToServer();
+	FILE *in = fdopen(fd, "r");
+	FILE *out = fdopen(dup(fd), "w");
+	int i;
+	double start;
+	for(i = 0; i < c->requests; i++) {
+		start = now();
+		if(!request(in, out)) {
+			c->errors++;
+		}
+		c->latencies[i] = now() - start;
+	}
+	fclose(out);
+	fclose(in);
+	return NULL;
+}
+
+int compareDoubles(const void *a, const void *b) {
+	double x = *(double *)a, y = *(double *)b;
+	return (x > y) - (x < y);
+}
+
+void readModel(char *path) {
+	FILE *f = fopen(path, "rb");
+	if(f == NULL) {
+		fprintf(stderr, "[ERROR] Could not open file %s\n", path);
+		exit(1);
+	}
+	fseek(f, 0, SEEK_END);
+	modelSize = ftell(f);
+	rewind(f);
+	model = malloc(modelSize);
+	if(fread(model, 1, modelSize, f) != modelSize) {
+		fprintf(stderr, "[ERROR] Could not read file %s\n", path);
+		exit(1);
+	}
+	fclose(f);
+	binaryModel = (modelSize >= 4 && !memcmp(model, "CSPB", 4));
+}
+
+int main(int argc, char **argv) {
+	int connections = 4, requests = 1000, total = 0, errors = 0;
+	int i, j;
+	client *clients;
+	double *latencies, start, seconds;
+
+	if(argc < 3) {
+		fprintf(stderr, "Usage: loadgen SOCKET MODEL [CONNECTIONS [REQUESTS]]\n");
+		return 1;
+	}
+	socketPath = argv[1];
+	readModel(argv[2]);
+	if(argc > 3) {
+		connections = atoi(argv[3]);
+	}
+	if(argc > 4) {
+		requests = atoi(argv[4]);
+	}
+	if(connections < 1 || requests < connections) {
+		fprintf(stderr, "[ERROR] Expecting at least one request per connection\n");
+		return 1;
+	}
+
+	clients = calloc(connections, sizeof(client));
+	latencies = malloc(requests*sizeof(double));
+	start = now();
+	for(i = 0; i < connections; i++) {
+		clients[i].requests = requests/connections + (i < requests%connections);
+		clients[i].latencies = latencies + total;
+		total += clients[i].requests;
+		pthread_create(&clients[i].thread, NULL, runClient, &clients[i]);
+	}
+	for(i = 0; i < connections; i++) {
+		pthread_join(clients[i].thread, NULL);
+		errors += clients[i].errors;
+	}
+	seconds = now() - start;
+
+	qsort(latencies, total, sizeof(double), compareDoubles);
+	j = (int)(0.99*total);
+	printf("requests:    %10d (%d errors) on %d connections\n", total, errors, connections);
+	printf("time:        %10.3f s\n", seconds);
+	printf("throughput:  %10.1f requests/s\n", total/seconds);
+	printf("latency p50: %10.3f ms\n", 1000*latencies[total/2]);
+	printf("latency p99: %10.3f ms\n", 1000*latencies[j < total ? j : total-1]);
+	printf("latency max: %10.3f ms\n", 1000*latencies[total-1]);
+	return 0;
+}
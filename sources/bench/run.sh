@@ -0,0 +1,107 @@
+#!/bin/sh
+#
+# Benchmark runner: generates the instances of the suite, solves each of them
+# under each configuration and prints a table of time, nodes and peak memory.
+# When a baseline has been saved, the table is compared against it.
+#
+# Usage: ./run.sh [-save]
+#   -save   store the results as the new baseline (baseline.tsv)
+#
+# Environment:
+#   BENCH_INSTANCES  instances, generator arguments separated by ':'
+#   BENCH_CONFIGS    solver configurations, separated by ','
+#   BENCH_TIMEOUT    seconds per run (default 10)
+#
+
+BENCH=$(cd "$(dirname "$0")" && pwd)
+SOURCES=$(dirname "$BENCH")
+GEN=$BENCH/gen
+CSP=$SOURCES/cspsolver/csp
+WORK=$BENCH/work
+RESULTS=$BENCH/results.tsv
+BASELINE=$BENCH/baseline.tsv
+
+INSTANCES=${BENCH_INSTANCES:-"queens:8 queens:16 queens:32 queens:64 \
+	rb:10:1 rb:10:2 rb:12:1 rb:12:2 \
+	magic:3 golomb:5 golomb:6 golomb:7 \
+	sudoku:30:1 sudoku:30:2 sudoku:25:3 sudoku:25:4"}
+CONFIGS=${BENCH_CONFIGS:-"-mrv -fc,-mrv -arc,-iconst 2 -mrv -arc,-mrv -deg -fc"}
+TIMEOUT=${BENCH_TIMEOUT:-10}
+
+for tool in "$GEN" "$CSP"; do
+	if [ ! -x "$tool" ]; then
+		echo "[ERROR] $tool not found, run make first." >&2
+		exit 1
+	fi
+done
+
+mkdir -p "$WORK"
+cd "$WORK" || exit 1
+rm -f stats.jsonl
+
+# extracts a numeric field from the last JSON statistics line
+field() {
+	tail -n 1 stats.jsonl | sed -n "s/.*\"$1\":\([0-9.]*\).*/\1/p"
+}
+
+printf "instance\tconfig\tstatus\ttime\tnodes\tmemory\tsolutions\n" > "$RESULTS"
+
+for instance in $INSTANCES; do
+	name=$(echo "$instance" | tr ':' '-')
+	"$GEN" $(echo "$instance" | tr ':' ' ') > "$name.csp" || exit 1
+	echo "$CONFIGS" | tr ',' '\n' | while read -r config; do
+		rm -f stats.jsonl
+		timeout -k 5 "$TIMEOUT" "$CSP" $config -trace 0 -statsjson stats.jsonl "$name.csp" < /dev/null > output.txt 2>&1
+		code=$?
+		if [ $code -eq 124 ] || [ $code -eq 137 ]; then
+			status=timeout
+		elif [ $code -ne 0 ] || [ ! -s stats.jsonl ]; then
+			status=error
+		else
+			status=ok
+		fi
+		if [ -s stats.jsonl ]; then
+			time=$(field total_s)
+			nodes=$(field nodes)
+			memory=$(field peak_rss_kb)
+			solutions=$(field solutions)
+		else
+			time=-; nodes=-; memory=-; solutions=-
+		fi
+		printf "%s\t%s\t%s\t%s\t%s\t%s\t%s\n" "$name" "$config" "$status" \
+			"$time" "$nodes" "$memory" "$solutions" >> "$RESULTS"
+		printf "." >&2
+	done
+done
+echo >&2
+
+if [ "$1" = "-save" ]; then
+	cp "$RESULTS" "$BASELINE"
+	echo "Baseline saved in $BASELINE" >&2
+fi
+
+# table, with the baseline time and nodes and the time ratio if available
+awk -F '\t' -v baseline="$BASELINE" '
+	BEGIN {
+		while((getline line < baseline) > 0) {
+			split(line, f, "\t");
+			baseTime[f[1] SUBSEP f[2]] = f[4];
+			baseNodes[f[1] SUBSEP f[2]] = f[5];
+		}
+	}
+	NR == 1 {
+		printf "%-14s %-22s %-8s %10s %10s %9s %10s %10s %7s\n", "instance", "config",
+			"status", "time (s)", "nodes", "mem (KB)", "base time", "base nodes", "ratio";
+		next;
+	}
+	{
+		key = $1 SUBSEP $2;
+		bt = (key in baseTime ? baseTime[key] : "-");
+		bn = (key in baseNodes ? baseNodes[key] : "-");
+		ratio = "-";
+		if(bt != "-" && $4 != "-" && bt > 0) {
+			ratio = sprintf("%.2f", $4 / bt);
+		}
+		printf "%-14s %-22s %-8s %10s %10s %9s %10s %10s %7s\n", $1, $2, $3, $4, $5, $6, bt, bn, ratio;
+	}
+' "$RESULTS"
@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include "rewrite.h"
+#include "vardb.h"
+#include "cache.h"
+
+/* creates the directory path and its parents */
+static int makeDirectory(char *path) {
+	char *p;
+	for(p = path+1; *p != '\0'; p++) {
+		if(*p == '/') {
+			*p = '\0';
+			mkdir(path, 0777);
+			*p = '/';
+		}
+	}
+	return (mkdir(path, 0777) == 0 || errno == EEXIST);
+}
+
+static int cacheDirectory(char *dir, size_t size) {
+	char *base;
+	if((base = getenv("CSP_CACHE")) != NULL && *base != '\0') {
+		snprintf(dir, size, "%s", base);
+	} else if((base = getenv("XDG_CACHE_HOME")) != NULL && *base != '\0') {
+		snprintf(dir, size, "%s/csp", base);
+	} else if((base = getenv("HOME")) != NULL) {
+		snprintf(dir, size, "%s/.cache/csp", base);
+	} else {
+		return 0;
+	}
+	return makeDirectory(dir);
+}
+
+/* 64 bit FNV-1a */
+static unsigned long long hashBytes(unsigned long long hash, const unsigned char *data, size_t size) {
+	size_t i;
+	for(i = 0; i < size; i++) {
+		hash ^= data[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+/* fills in the paths of the entry of the model in source, returns 0 if there is no cache */
+int openCacheEntry(char *source, cacheEntry *entry) {
+	char dir[3072];
+	unsigned char buffer[65536];
+	unsigned long long hash = 14695981039346656037ULL;
+	size_t n;
+	FILE *in;
+
+	if(!cacheDirectory(dir, sizeof(dir))) {
+		return 0;
+	}
+	in = fopen(source, "rb");
+	if(in == NULL) {
+		return 0;
+	}
+	hash = hashBytes(hash, (unsigned char *) REWRITER_VERSION, sizeof(REWRITER_VERSION));
+	while((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+		hash = hashBytes(hash, buffer, n);
+	}
+	fclose(in);
+	snprintf(entry->problem, sizeof(entry->problem), "%s/%016llx.nfb", dir, hash);
+	snprintf(entry->variables, sizeof(entry->variables), "%s/%016llx.vars", dir, hash);
+	snprintf(entry->translation, sizeof(entry->translation), "%s/%016llx.csp", dir, hash);
+	snprintf(entry->temporary, sizeof(entry->temporary), "%s/%016llx.%d.tmp", dir, hash, (int) getpid());
+	return 1;
+}
+
+/* copies the file from to the file to, returns 0 if that failed */
+static int copyFile(char *from, char *to) {
+	char buffer[65536];
+	size_t n;
+	int ok = 1;
+	FILE *in = fopen(from, "rb"), *out;
+
+	if(in == NULL) {
+		return 0;
+	}
+	out = fopen(to, "wb");
+	if(out == NULL) {
+		fclose(in);
+		return 0;
+	}
+	while((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+		ok = ok && (fwrite(buffer, 1, n, out) == n);
+	}
+	ok = ok && !ferror(in);
+	fclose(in);
+	return (fclose(out) == 0 && ok);
+}
+
+static void corruptEntry(cacheEntry *entry) {
+	fprintf(stderr, "[ERROR] Cache entry %s is corrupt, run with -regenerate\n", entry->variables);
+	exit(-1);
+}
+
+/* 
+  Fills the variable database from the entry if it exists, then the model
+  does not need to be parsed, and copies its text normal form to
+  translation. Returns 0 if the entry does not exist.
+*/
+int loadCachedModel(cacheEntry *entry, char *translation) {
+	char name[256];
+	int dims, size, i;
+	List dimsizes, last;
+	FILE *in;
+
+	if(access(entry->problem, R_OK) != 0 || access(entry->translation, R_OK) != 0 ||
+	   (in = fopen(entry->variables, "r")) == NULL) {
+		return 0;
+	}
+	if(fscanf(in, "%255s", name) != 1 || strcmp(name, REWRITER_VERSION) != 0) {
+		corruptEntry(entry);
+	}
+	while(fscanf(in, "%255s %d", name, &dims) == 2) {
+		dimsizes = last = NULL;
+		for(i = 0; i < dims; i++) {
+			if(fscanf(in, "%d", &size) != 1) {
+				corruptEntry(entry);
+			}
+			dimsizes = addToListEnd(newConstantNumExp(size), dimsizes, &last);
+		}
+		addVarToDB(newVariable(strdup(name), dims, dimsizes));
+	}
+	if(!feof(in)) {
+		corruptEntry(entry);
+	}
+	fclose(in);
+	if(!copyFile(entry->translation, translation)) {
+		fprintf(stderr, "[ERROR] Could not write %s\n", translation);
+		exit(-1);
+	}
+	/* the modification time is the last use, for eviction */
+	utime(entry->problem, NULL);
+	return 1;
+}
+
+typedef struct cachedFile {
+	char name[256];
+	time_t used;
+	long size;
+} cachedFile;
+
+static int compareUse(const void *a, const void *b) {
+	const cachedFile *x = a, *y = b;
+	return (x->used > y->used) - (x->used < y->used);
+}
+
+/* removes the least recently used entries from dir until it holds at most maxBytes */
+static void evictEntries(char *dir, long maxBytes) {
+	char path[4096];
+	cachedFile *files = NULL;
+	int count = 0, space = 0, i;
+	long total = 0;
+	struct dirent *file;
+	struct stat st;
+	DIR *d = opendir(dir);
+	size_t length;
+
+	if(d == NULL) {
+		return;
+	}
+	while((file = readdir(d)) != NULL) {
+		length = strlen(file->d_name);
+		if(length < 5 || length >= sizeof(files->name) || strcmp(file->d_name+length-4, ".nfb") != 0) {
+			continue;
+		}
+		if(count == space) {
+			space = (space == 0 ? 64 : 2*space);
+			files = realloc(files, space*sizeof(cachedFile));
+		}
+		strcpy(files[count].name, file->d_name);
+		files[count].name[length-4] = '\0';
+		snprintf(path, sizeof(path), "%s/%s", dir, file->d_name);
+		if(stat(path, &st) != 0) {
+			continue;
+		}
+		files[count].used = st.st_mtime;
+		files[count].size = st.st_size;
+		snprintf(path, sizeof(path), "%s/%s.vars", dir, files[count].name);
+		if(stat(path, &st) == 0) {
+			files[count].size += st.st_size;
+		}
+		snprintf(path, sizeof(path), "%s/%s.csp", dir, files[count].name);
+		if(stat(path, &st) == 0) {
+			files[count].size += st.st_size;
+		}
+		total += files[count].size;
+		count++;
+	}
+	closedir(d);
+
+	qsort(files, count, sizeof(cachedFile), compareUse);
+	for(i = 0; i < count && total > maxBytes; i++) {
+		snprintf(path, sizeof(path), "%s/%s.nfb", dir, files[i].name);
+		unlink(path);
+		snprintf(path, sizeof(path), "%s/%s.vars", dir, files[i].name);
+		unlink(path);
+		snprintf(path, sizeof(path), "%s/%s.csp", dir, files[i].name);
+		unlink(path);
+		total -= files[i].size;
+	}
+	free(files);
+}
+
+/* 
+  Completes the entry after the problem has been written to its temporary
+  file: writes the variable table, copies the text normal form from
+  translation and makes the entry visible.
+*/
+void storeCachedModel(cacheEntry *entry, char *translation, long maxBytes) {
+	char path[4200];
+	List variables = getAllVariables(), dimsizes;
+	Variable var;
+	FILE *out;
+
+	snprintf(path, sizeof(path), "%s.tmp", entry->variables);
+	out = fopen(path, "w");
+	if(out == NULL) {
+		unlink(entry->temporary);
+		return;
+	}
+	fprintf(out, "%s\n", REWRITER_VERSION);
+	for(; variables != NULL; variables = variables->next) {
+		var = variables->item;
+		fprintf(out, "%s %d", var->name, var->dims);
+		for(dimsizes = var->dimsizes; dimsizes != NULL; dimsizes = dimsizes->next) {
+			fprintf(out, " %d", calcNumExp(dimsizes->item, NULL));
+		}
+		fprintf(out, "\n");
+	}
+	fclose(out);
+	/* the variables first, an entry is used only if its problem exists */
+	rename(path, entry->variables);
+	snprintf(path, sizeof(path), "%s.tmp", entry->translation);
+	if(!copyFile(translation, path)) {
+		unlink(path);
+		unlink(entry->temporary);
+		return;
+	}
+	rename(path, entry->translation);
+	rename(entry->temporary, entry->problem);
+
+	strcpy(path, entry->problem);
+	*strrchr(path, '/') = '\0';
+	evictEntries(path, maxBytes);
+}
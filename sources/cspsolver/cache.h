@@ -0,0 +1,36 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdio.h>
+
+/*
+ * Cache of grounded models. A model is keyed by a hash of its source and
+ * of REWRITER_VERSION, so that running it again, for example with other
+ * heuristics, skips parsing and rewriting. An entry holds the problem in
+ * binary normal form (KEY.nfb), the variable table that csp needs to
+ * print solutions and to translate data (KEY.vars) and the text normal
+ * form (KEY.csp), which is copied to translation.csp on a hit.
+ *
+ * The cache is the directory $CSP_CACHE, or else $XDG_CACHE_HOME/csp or
+ * ~/.cache/csp. It is kept below a size bound by removing the entries that
+ * were used least recently.
+ */
+
+/* must change whenever the rewriting or the binary normal form changes */
+#define REWRITER_VERSION "csp-7"
+
+/* default bound of the cache in megabytes (-cachesize) */
+#define DEFAULT_CACHE_SIZE 256
+
+typedef struct cacheEntry {
+	char problem[4096];			/* KEY.nfb */
+	char variables[4096];		/* KEY.vars */
+	char translation[4096];		/* KEY.csp */
+	char temporary[4096];		/* the problem while it is written */
+} cacheEntry;
+
+int openCacheEntry(char *source, cacheEntry *entry);
+int loadCachedModel(cacheEntry *entry, char *translation);
+void storeCachedModel(cacheEntry *entry, char *translation, long maxBytes);
+
+#endif
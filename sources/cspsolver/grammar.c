@@ -8,10 +8,13 @@
 #include <unistd.h>
 #include <signal.h>
 #include <sys/wait.h>
+#include <time.h>
+#include "../basicsolver/cspsolver.h"
+#include "cache.h"
 
-#line 13 "grammar.c"
-#define LL_NTERMINALS 46
-#define LL_NSETS 25
+#line 16 "grammar.c"
+#define LL_NTERMINALS 49
+#define LL_NSETS 26
 #define LL_SSETS 8
 #define LLinset(LLx) (LLsets[LLx*LL_SSETS + (LLcsymb/8)] & (1<<(LLcsymb & 7)))
 #define LL_SCANDONE(LLx) if (LLsymb != LLx) LLerror(LLx);
@@ -20,30 +23,31 @@ static int LLcsymb;
 #include <string.h>
 static const char LLsets[] = {
 	'\x04', 	'\x00', 	'\x02', 	'\x10', 	'\x08', 	'\x00', 	'\x00', 	'\x00', 
-	'\x28', 	'\x08', 	'\x02', 	'\xB4', 	'\x9F', 	'\x3F', 	'\x00', 	'\x00', 
+	'\x28', 	'\x08', 	'\x02', 	'\xB4', 	'\x9F', 	'\xFF', 	'\x01', 	'\x00', 
 	'\x30', 	'\x00', 	'\x02', 	'\x20', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\xC0', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x00', 	'\x00', 	'\x10', 	'\x08', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x08', 	'\x00', 	'\xB4', 	'\x9F', 	'\x3F', 	'\x00', 	'\x00', 
+	'\x20', 	'\x08', 	'\x00', 	'\xB4', 	'\x9F', 	'\xFF', 	'\x01', 	'\x00', 
 	'\x20', 	'\x00', 	'\x00', 	'\x20', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\xFF', 	'\x01', 	'\xF7', 	'\x9F', 	'\x3F', 	'\x00', 	'\x00', 
-	'\x20', 	'\xFE', 	'\x00', 	'\xF7', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
-	'\x20', 	'\x78', 	'\xFD', 	'\xB7', 	'\x9F', 	'\x3F', 	'\x00', 	'\x00', 
-	'\x20', 	'\x78', 	'\x00', 	'\xF7', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
-	'\x20', 	'\x78', 	'\x00', 	'\xB7', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
+	'\x20', 	'\xFF', 	'\x01', 	'\xF7', 	'\x9F', 	'\xFF', 	'\x01', 	'\x00', 
+	'\x20', 	'\xFE', 	'\x00', 	'\xF7', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
+	'\x20', 	'\x78', 	'\xFD', 	'\xB7', 	'\x9F', 	'\xFF', 	'\x01', 	'\x00', 
+	'\x20', 	'\x78', 	'\x00', 	'\xF7', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
+	'\x20', 	'\x78', 	'\x00', 	'\xB7', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
 	'\x00', 	'\x00', 	'\xFC', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
 	'\x00', 	'\x18', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x68', 	'\x00', 	'\xB7', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
+	'\x20', 	'\x68', 	'\x00', 	'\xB7', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
 	'\x00', 	'\x20', 	'\x00', 	'\x03', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\x48', 	'\x00', 	'\xB4', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
-	'\x20', 	'\x00', 	'\x00', 	'\xB4', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
-	'\x20', 	'\x78', 	'\xFC', 	'\xB7', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
-	'\x20', 	'\xF8', 	'\xFC', 	'\xBF', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
+	'\x20', 	'\x48', 	'\x00', 	'\xB4', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
+	'\x20', 	'\x00', 	'\x00', 	'\xB4', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
+	'\x20', 	'\x78', 	'\xFC', 	'\xB7', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
+	'\x20', 	'\xF8', 	'\xFC', 	'\xBF', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
 	'\x00', 	'\x00', 	'\x00', 	'\x80', 	'\x01', 	'\x00', 	'\x00', 	'\x00', 
 	'\x20', 	'\x00', 	'\x00', 	'\x00', 	'\x04', 	'\x00', 	'\x00', 	'\x00', 
-	'\x20', 	'\xF8', 	'\xFC', 	'\xB7', 	'\x97', 	'\x3F', 	'\x00', 	'\x00', 
+	'\x20', 	'\xF8', 	'\xFC', 	'\xB7', 	'\x97', 	'\xFF', 	'\x01', 	'\x00', 
 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x90', 	'\x3F', 	'\x00', 	'\x00', 
 	'\x00', 	'\x02', 	'\x00', 	'\x10', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 
+	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x00', 	'\x40', 	'\x01', 	'\x00', 
 	0
 };
 static const int LLindex[] = { 0,
@@ -84,7 +88,8 @@ static const int LLindex[] = { 0,
 	  16,   17,   18,   19,   20,   21,   22,   23,
 	  24,   25,   26,   27,   28,   29,   30,   31,
 	  32,   33,   34,   35,   36,   37,   38,   39,
-	  40,   41,   42,   43,   44,   45};
+	  40,   41,   42,   43,   44,   45,   46,   47,
+	  48};
 int LLsymb;
 static int LLreissue;
 int yylex(void);
@@ -130,7 +135,7 @@ static void LLerror(int LLtoken) {
 	if (LLsymb != LLtoken) { LLreissue = LLsymb; LLmessage(LLtoken); }
 }
 #include "grammar.h"
-#line 21 "grammar.g"
+#line 24 "grammar.g"
 
 	#include <stdio.h>
 	#include <stdlib.h>
@@ -196,12 +201,13 @@ static void LLerror(int LLtoken) {
 		exit(0);
 	}
 	
-	void waitForChild() {
+	int waitForChild() {
 		int returnStatus; 
 		waitpid(solver_pid, &returnStatus, 0);
 		if (returnStatus == 1) {
 		   printf("The child process terminated with an error!.");
 		}
+		return returnStatus;
 	}
 	
 	int match(char *str1, char *str2) {
@@ -216,6 +222,207 @@ static void LLerror(int LLtoken) {
 	
 	
 	
+	/* returns the filename following flag in argv, or NULL if flag is absent */
+	char *optionValue(int argc, char **argv, char *flag) {
+		for(int i = 1; i < argc-2; i++) {
+			if(match(argv[i], flag)) {
+				return argv[i+1];
+			}
+		}
+		return NULL;
+	}
+	
+	/* grounds the instance in inputName to translationName in a child process, returns its pid */
+	int groundInstance(char *inputName, char *translationName) {
+		int pid = fork();
+		if(pid == -1) {
+		    fprintf(stderr, "[ERROR] Could not fork\n");
+		    exit(EXIT_FAILURE);
+		}
+		if(pid == 0) {
+			stdin = fopen(inputName, "r");
+			if(stdin == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", inputName);
+				exit(-1);
+			}
+			stdout = fopen(translationName, "w");
+			if(stdout == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", translationName);
+				exit(-1);
+			}
+			parser();
+			fclose(stdout);
+			exit(0);
+		}
+		return pid;
+	}
+	
+	/* translates the data in dataName for the grounded model to translationName */
+	int translateDataFile(char *dataName, char *translationName) {
+		FILE *in = fopen(dataName, "r");
+		FILE *out;
+		int ok;
+		if(in == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", dataName);
+			return 0;
+		}
+		out = fopen(translationName, "w");
+		if(out == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", translationName);
+			exit(-1);
+		}
+		ok = translateData(in, out, dataName);
+		fclose(out);
+		fclose(in);
+		return ok;
+	}
+	
+	/* waits for a grounding child, removes the translation if the instance could not be grounded */
+	void reapInstance(int *pids, int count, char *dir) {
+		char path[4096];
+		int status, i;
+		int pid = wait(&status);
+		if(pid <= 0 || (WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+			return;
+		}
+		for(i = 0; i < count; i++) {
+			if(pids[i] == pid) {
+				snprintf(path, sizeof(path), "%s/%d.csp", dir, i);
+				unlink(path);
+			}
+		}
+	}
+	
+	/*
+	  csp [OPTION]... [-j N] [-stream FORMAT DIR] [-model MODEL] -batch LIST
+	  
+	  The rewriter keeps its state in globals, so the instances in LIST are
+	  grounded in child processes, N at a time, into a temporary directory.
+	  The translations are then solved by the batch mode of the solver (see
+	  basicsolver/batch.h), which reports them by their name in LIST. An
+	  instance that can not be grounded is reported as unreadable.
+	  
+	  With -model, LIST holds data files for MODEL instead. MODEL is grounded
+	  once, the data only needs its variables translated.
+	*/
+	int batchMain(int argc, char **argv) {
+		char dir[] = "/tmp/cspbatchXXXXXX";
+		char path[4096], listName[4096], modelName[4096];
+		char *model = optionValue(argc, argv, "-model");
+		char *line = NULL, *name;
+		size_t space = 0;
+		ssize_t length;
+		int count = 0, running = 0, allocated = 0, status, i;
+		int *pids;
+		char **inputs = NULL;
+		int jobs = sysconf(_SC_NPROCESSORS_ONLN);
+		FILE *list, *translations;
+		
+		if(optionValue(argc, argv, "-j") != NULL && atoi(optionValue(argc, argv, "-j")) > 0) {
+			jobs = atoi(optionValue(argc, argv, "-j"));
+		}
+		list = fopen(argv[argc-1], "r");
+		if(list == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", argv[argc-1]);
+			exit(-1);
+		}
+		if(mkdtemp(dir) == NULL) {
+			fprintf(stderr, "[ERROR] Could not create a temporary directory\n");
+			exit(-1);
+		}
+		if(model != NULL) {
+			snprintf(modelName, sizeof(modelName), "%s/model.csp", dir);
+			stdin = fopen(model, "r");
+			if(stdin == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", model);
+				exit(-1);
+			}
+			stdout = fopen(modelName, "w");
+			parser();
+			freopen("/dev/stdin", "r", stdin);
+			freopen("/dev/stdout", "w", stdout);
+			for(i = 1; i < argc-2; i++) {
+				if(match(argv[i], "-model")) {
+					argv[i+1] = modelName;
+				}
+			}
+		}
+		snprintf(listName, sizeof(listName), "%s/list", dir);
+		translations = fopen(listName, "w");
+		if(translations == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", listName);
+			exit(-1);
+		}
+		
+		while((length = getline(&line, &space, list)) != -1) {
+			while(length > 0 && (line[length-1] == '\n' || line[length-1] == '\r')) {
+				line[--length] = '\0';
+			}
+			if(length == 0) {
+				continue;
+			}
+			name = strchr(line, '\t');
+			if(name != NULL) {
+				*name++ = '\0';
+			} else {
+				name = line;
+			}
+			if(count == allocated) {
+				allocated = (allocated == 0 ? 64 : 2*allocated);
+				inputs = realloc(inputs, allocated*sizeof(char *));
+			}
+			inputs[count] = strdup(line);
+			snprintf(path, sizeof(path), "%s/%d.csp", dir, count);
+			fprintf(translations, "%s\t%s\n", path, name);
+			/* data that can not be translated is reported as unreadable */
+			if(model != NULL && !translateDataFile(line, path)) {
+				unlink(path);
+			}
+			count++;
+		}
+		fclose(translations);
+		fclose(list);
+		free(line);
+		/* the children would flush pending output again */
+		fflush(NULL);
+		
+		pids = malloc((count > 0 ? count : 1)*sizeof(int));
+		for(i = 0; i < count && model == NULL; i++) {
+			/* at most jobs children at a time */
+			if(running == jobs) {
+				reapInstance(pids, i, dir);
+				running--;
+			}
+			snprintf(path, sizeof(path), "%s/%d.csp", dir, i);
+			pids[i] = groundInstance(inputs[i], path);
+			running++;
+		}
+		for(i = 0; i < count; i++) {
+			free(inputs[i]);
+		}
+		free(inputs);
+		while(running > 0) {
+			reapInstance(pids, count, dir);
+			running--;
+		}
+		free(pids);
+		
+		argv[0] = "solver";
+		argv[argc-1] = listName;
+		status = cspSolverMain(argc, argv);
+		
+		for(i = 0; i < count; i++) {
+			snprintf(path, sizeof(path), "%s/%d.csp", dir, i);
+			unlink(path);
+		}
+		unlink(listName);
+		if(model != NULL) {
+			unlink(modelName);
+		}
+		rmdir(dir);
+		return status;
+	}
+	
 	int main(int argc, char** argv) {
 		FILE *solution_file;	
 
@@ -237,20 +444,88 @@ static void LLerror(int LLtoken) {
 			printf("-deg         Use the degree heuristic.\n");
 			printf("-arc         Keep the problem arc-consistent. Can not be combined with '-fc'\n");
 			printf("-fc          Use Forward Checking. Can not be combined with '-arc'.\n");
+			printf("-presolve    Simplify the problem before the search: remove fixed and aliased\n");
+			printf("             variables, entailed and duplicate constraints.\n");
+			printf("-alldiff     Propagate cliques of pairwise '<>' constraints as alldiff constraints.\n");
+			printf("-maxmin      Propagate R = max(..) and R = min(..) over variables by their bounds.\n");
+			printf("-trace N     Trace level in csp.log: 0 off, 1 info (default), 2 search events, 3 detail.\n");
+			printf("-profile K   Write the K most expensive constraints with their counters to csp.log.\n");
+			printf("-stats       Print search statistics on stderr when the solver exits.\n");
+			printf("-statsjson F Append the search statistics as a JSON line to F.\n");
+			printf("-writenf F   Write the grounded problem in binary normal form to F, do not solve.\n");
+			printf("-stream T F  Write solutions to F ('-' for standard output) while searching,\n");
+			printf("             in format T: text, binary or count (F is not written).\n");
+			printf("-batch L     Solve every instance listed in file L (one per line, as the last\n");
+			printf("             option), writing one JSON line per instance to standard output.\n");
+			printf("-j N         Ground and solve N batch instances at the same time.\n");
+			printf("-data D      Apply the values and domains in file D to the model, e.g.\n");
+			printf("             'b[0][1] = 5; x <- [1..3];'.\n");
+			printf("-model M     Ground M once and solve it for each data file in the batch list.\n");
+			printf("-nocache     Do not use the cache of grounded models.\n");
+			printf("-regenerate  Ground the model even if it is in the cache, and update the cache.\n");
+			printf("-cachesize N Keep the cache below N megabytes (default %d).\n", DEFAULT_CACHE_SIZE);
 			printf("\n");
 			exit(0);
 		}
+		
+		/* the cache options are handled by csp, the solver does not know them */
+		int useCache = 1, regenerate = 0, kept = 1;
+		long cacheSize = DEFAULT_CACHE_SIZE;
+		for(int i = 1; i < argc-1; i++) {
+			if(match(argv[i], "-nocache")) {
+				useCache = 0;
+			} else if(match(argv[i], "-regenerate")) {
+				regenerate = 1;
+			} else if(match(argv[i], "-cachesize")) {
+				if(i+1 >= argc-1 || atol(argv[i+1]) < 0) {
+					fprintf(stderr, "[ERROR] Expecting a size in megabytes following flag '-cachesize'.\n");
+					exit(1);
+				}
+				cacheSize = atol(argv[++i]);
+			} else {
+				argv[kept++] = argv[i];
+			}
+		}
+		argv[kept++] = argv[argc-1];
+		argv[kept] = NULL;
+		argc = kept;
+		
+		if(argc >= 3 && match(argv[argc-2], "-batch")) {
+			return batchMain(argc, argv);
+		}
 
-		stdin = fopen(argv[argc-1], "r");	
-		if(stdin == NULL) {
-			fprintf(stderr, "[ERROR] Could not open %s\n", argv[argc-1]);
-			exit(-1);
-		}		
-		stdout = fopen("translation.csp", "w");	
+		/* a model that has been grounded before is not parsed again */
+		cacheEntry entry;
+		int cached = 0;
+		useCache = useCache && openCacheEntry(argv[argc-1], &entry);
+		if(useCache && !regenerate) {
+			cached = loadCachedModel(&entry, "translation.csp");
+		}
 		
-  		parser();
-  		freopen("/dev/stdin", "r", stdin);
-  		freopen("/dev/stdout", "w", stdout);
+		struct timespec groundStart, groundEnd;
+		clock_gettime(CLOCK_MONOTONIC, &groundStart);
+		if(!cached) {
+			stdin = fopen(argv[argc-1], "r");	
+			if(stdin == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", argv[argc-1]);
+				exit(-1);
+			}		
+			stdout = fopen("translation.csp", "w");	
+	  		parser();
+	  		freopen("/dev/stdin", "r", stdin);
+	  		freopen("/dev/stdout", "w", stdout);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &groundEnd);
+  		
+  		/* the data of the instance refers to the variables of the model */
+  		for(int i = 1; i < argc-2; i++) {
+  			if(match(argv[i], "-data")) {
+  				if(!translateDataFile(argv[i+1], "translation.dat")) {
+  					exit(-1);
+  				}
+  				argv[i+1] = "translation.dat";
+  			}
+  		}
   		
   		solver_pid = fork();
 		if(solver_pid == -1) {
@@ -261,19 +536,41 @@ static void LLerror(int LLtoken) {
   		if(solver_pid == 0) {		    
 		    signal(SIGKILL, exitChild);
 		    
-		    argv[argc-1] = "translation.csp";
-		    int error;
-		    if( access("./solver", F_OK ) != -1 ) { // check if file exists
-		    	argv[0] = "./solver";
-		    	error = execvp("./solver", argv);
-		    } else {
-		    	argv[0] = "solver";
-		    	error = execvp("solver", argv);
+		    argv[argc-1] = (cached ? entry.problem : "translation.csp");
+		    /* the solver reports the grounding time in its statistics */
+		    char groundTime[32];
+		    snprintf(groundTime, sizeof(groundTime), "%.6f", (groundEnd.tv_sec - groundStart.tv_sec) + 
+		    	(groundEnd.tv_nsec - groundStart.tv_nsec)*1.0e-9);
+		    setenv("CSP_GROUND_TIME", groundTime, 1);
+		    argv[0] = "solver";
+		    if(useCache && !cached) {
+		    	/* the solver writes the problem for the cache while it loads it */
+		    	char **args = safeMalloc((argc+3)*sizeof(char *));
+		    	memcpy(args, argv, (argc-1)*sizeof(char *));
+		    	args[argc-1] = "-savenf";
+		    	args[argc] = entry.temporary;
+		    	args[argc+1] = argv[argc-1];
+		    	args[argc+2] = NULL;
+		    	exit(cspSolverMain(argc+2, args));
 		    }
-			fprintf(stderr, "[ERROR] Solver executed with errorcode %d.\n", error);
+		    exit(cspSolverMain(argc, argv));
 		} else {
 			signal(SIGINT, exitParent);
-			waitForChild();
+			int status = waitForChild();
+			if(useCache && !cached) {
+				if(status == 0 && access(entry.temporary, R_OK) == 0) {
+					storeCachedModel(&entry, "translation.csp", cacheSize*1024*1024);
+				} else {
+					unlink(entry.temporary);
+				}
+			}
+			
+			char *binaryOutput = optionValue(argc, argv, "-writenf");
+			if(binaryOutput != NULL) {
+				unlink("solution.txt");
+				printf("Binary normal form written to %s\n", binaryOutput);
+				return 0;
+			}
 			
 			solution_file = fopen("solution.txt", "r");
 			if(solution_file == NULL) {
@@ -284,7 +581,10 @@ static void LLerror(int LLtoken) {
 		    fscanf(solution_file, "%d", &backtracking_points);
 		    fscanf(solution_file, "%d", &solution_count);
 		    
-		    for(int i = 0; i < solution_count; i++) {
+		    /* streamed solutions have already been written by the solver */
+		    int streamed = (optionValue(argc, argv, "-stream") != NULL);
+		    
+		    for(int i = 0; i < solution_count && !streamed; i++) {
 		    	printf("### Solution %d ###\n", i+1);
 		    	printSolution(solution_file);
 		    	printf("\n");
@@ -302,7 +602,7 @@ static void LLerror(int LLtoken) {
 	}
 
 
-#line 306 "grammar.c"
+#line 606 "grammar.c"
 static void LL0_problem(void);
 static void LL1_body(void);
 static void LL2_vars(void);
@@ -325,9 +625,9 @@ static List LL18_constraintlist(void);
 static char * LL19_varname(void);
 static NumExp LL20_indexspec(void);
 static void LL21_vardef
-#line 390 "grammar.g"
+#line 688 "grammar.g"
 (int comma)
-#line 331 "grammar.c"
+#line 631 "grammar.c"
 ;
 static VarCall LL22_varcall(void);
 static FunctionCall LL23_functioncall(void);
@@ -336,6 +636,7 @@ static void LL25_vardeflist(void);
 static void LL26_relop(void);
 static void LL27_termop(void);
 static void LL28_factorop(void);
+static List LL29_tuple(void);
 static void LL0_problem(void){
 LL1_body();
 }
@@ -358,9 +659,9 @@ LL_SCANDONE(257);/* VARSTOK */
 LLread();
 LLtcnt[17]--;
 LL_SCANDONE(273);/* COLONTOK */
-#line 201 "grammar.g"
+#line 499 "grammar.g"
 {prnt("variables:\n");}
-#line 364 "grammar.c"
+#line 665 "grammar.c"
 LLread();
 for (;;) {
 LL_0:
@@ -377,36 +678,36 @@ LLtcnt[16]++;
 LL25_vardeflist();
 LLtcnt[17]--;
 LL_SCANDONE(273);/* COLONTOK */
-#line 204 "grammar.g"
+#line 502 "grammar.g"
 {
 						prnt(" : ");
 					}
-#line 385 "grammar.c"
+#line 686 "grammar.c"
 LLread();
 LLscnt[3]--;
 LL9_datatype();
 LLread();
 LLtcnt[16]--;
 LL_SCANDONE(272);/* SEMITOK */
-#line 208 "grammar.g"
+#line 506 "grammar.g"
 {
 						prnt(";\n");
 					}
-#line 396 "grammar.c"
+#line 697 "grammar.c"
 LLread();
 continue;
 }
 LLtcnt[28]--;
 break;
 }
-#line 212 "grammar.g"
+#line 510 "grammar.g"
 {prnt("\n");}
-#line 405 "grammar.c"
+#line 706 "grammar.c"
 }
 static void LL3_domains(void){
-#line 240 "grammar.g"
+#line 538 "grammar.g"
 RecursiveType
-#line 410 "grammar.c"
+#line 711 "grammar.c"
 domspec;
 memset(&domspec, 0, sizeof(domspec));
 {
@@ -416,9 +717,9 @@ LL_SCANDONE(258);/* DOMAINSTOK */
 LLread();
 LLtcnt[17]--;
 LL_SCANDONE(273);/* COLONTOK */
-#line 215 "grammar.g"
+#line 513 "grammar.g"
 {prnt("domains:\n");}
-#line 422 "grammar.c"
+#line 723 "grammar.c"
 LLread();
 for (;;) {
 LL_0:
@@ -431,26 +732,26 @@ break;
 case 28:/* VARNAME */
 case 35:/* FORALLTOK */
 domspec = LL6_domainspec();
-#line 217 "grammar.g"
+#line 515 "grammar.g"
 {
 						rewriteDomainSpec(domspec, NULL);
 					}
-#line 439 "grammar.c"
+#line 740 "grammar.c"
 LLread();
 continue;
 }
 LLscnt[4]--;
 break;
 }
-#line 221 "grammar.g"
+#line 519 "grammar.g"
 {checkDomainsSet(); prnt("\n");}
-#line 448 "grammar.c"
+#line 749 "grammar.c"
 }
 }
 static void LL4_constraints(void){
-#line 259 "grammar.g"
+#line 557 "grammar.g"
 RecursiveType
-#line 454 "grammar.c"
+#line 755 "grammar.c"
 cspec;
 memset(&cspec, 0, sizeof(cspec));
 {
@@ -460,9 +761,9 @@ LL_SCANDONE(259);/* CONSTRAINTSTOK */
 LLread();
 LLtcnt[17]--;
 LL_SCANDONE(273);/* COLONTOK */
-#line 224 "grammar.g"
+#line 522 "grammar.g"
 {prnt("constraints:\n");}
-#line 466 "grammar.c"
+#line 767 "grammar.c"
 LLread();
 for (;;) {
 LL_0:
@@ -490,42 +791,45 @@ case 42:/* MINIMUMTOK */
 case 43:/* EQUALTOK */
 case 44:/* INCREASINGTOK */
 case 45:/* DECREASINGTOK */
+case 46:/* TABLETOK */
+case 47:/* COUNTTOK */
+case 48:/* GCCTOK */
 cspec = LL7_constraintspec();
-#line 226 "grammar.g"
+#line 524 "grammar.g"
 {
 						rewriteConstraintSpec(cspec, NULL);
 					}
-#line 499 "grammar.c"
+#line 803 "grammar.c"
 LLread();
 continue;
 }
 LLscnt[5]--;
 break;
 }
-#line 230 "grammar.g"
+#line 528 "grammar.g"
 {prnt("\n");}
-#line 508 "grammar.c"
+#line 812 "grammar.c"
 }
 }
 static void LL5_solvespec(void){
-#line 310 "grammar.g"
+#line 608 "grammar.g"
 int
-#line 514 "grammar.c"
+#line 818 "grammar.c"
 posint;
 memset(&posint, 0, sizeof(posint));
 {
 LLtcnt[17]++;
 LLscnt[6]++;
 LL_SCANDONE(260);/* SOLVETOK */
-#line 234 "grammar.g"
+#line 532 "grammar.g"
 {prnt(yytext);}
-#line 523 "grammar.c"
+#line 827 "grammar.c"
 LLread();
 LLtcnt[17]--;
 LL_SCANDONE(273);/* COLONTOK */
-#line 235 "grammar.g"
+#line 533 "grammar.g"
 {prnt(yytext);}
-#line 529 "grammar.c"
+#line 833 "grammar.c"
 LLread();
 LL_0:
 switch (LLcsymb) {
@@ -542,34 +846,34 @@ LLscnt[6]--;
 posint = LL12_posint();
 break;
 }
-#line 236 "grammar.g"
+#line 534 "grammar.g"
 {prnt(yytext);}
-#line 548 "grammar.c"
-#line 237 "grammar.g"
+#line 852 "grammar.c"
+#line 535 "grammar.g"
 {prnt("\n");}
-#line 551 "grammar.c"
+#line 855 "grammar.c"
 }
 }
 static RecursiveType LL6_domainspec(void){
-#line 240 "grammar.g"
+#line 538 "grammar.g"
 RecursiveType
-#line 557 "grammar.c"
+#line 861 "grammar.c"
 LLretval;
-#line 289 "grammar.g"
+#line 587 "grammar.g"
 List
-#line 561 "grammar.c"
+#line 865 "grammar.c"
 doms;
-#line 457 "grammar.g"
+#line 776 "grammar.g"
 List
-#line 565 "grammar.c"
+#line 869 "grammar.c"
 vars;
-#line 277 "grammar.g"
+#line 575 "grammar.g"
 ForAll
-#line 569 "grammar.c"
+#line 873 "grammar.c"
 fa;
-#line 240 "grammar.g"
+#line 538 "grammar.g"
 RecursiveType
-#line 573 "grammar.c"
+#line 877 "grammar.c"
 domspec;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&doms, 0, sizeof(doms));
@@ -577,9 +881,9 @@ memset(&vars, 0, sizeof(vars));
 memset(&fa, 0, sizeof(fa));
 memset(&domspec, 0, sizeof(domspec));
 {
-#line 240 "grammar.g"
-Type type; void *data; List items = NULL;
-#line 583 "grammar.c"
+#line 538 "grammar.g"
+Type type; void *data; List items = NULL; List last = NULL;
+#line 887 "grammar.c"
 LLscnt[7]++;
 LL_0:
 switch (LLcsymb) {
@@ -600,9 +904,9 @@ break;
 case 28:/* VARNAME */
 case 35:/* FORALLTOK */
 domspec = LL6_domainspec();
-#line 246 "grammar.g"
-{items = addToListEnd(domspec, items);}
-#line 606 "grammar.c"
+#line 544 "grammar.g"
+{items = addToListEnd(domspec, items, &last);}
+#line 910 "grammar.c"
 LLread();
 continue;
 }
@@ -611,9 +915,9 @@ break;
 }
 LLtcnt[38]--;
 LL_SCANDONE(294);/* ENDTOK */
-#line 248 "grammar.g"
+#line 546 "grammar.g"
 {type = FORALL; fa->items = items; data = fa;}
-#line 617 "grammar.c"
+#line 921 "grammar.c"
 break;
 default:
 if (LLskip())
@@ -633,45 +937,45 @@ doms = LL10_domain();
 LLread();
 LLtcnt[16]--;
 LL_SCANDONE(272);/* SEMITOK */
-#line 251 "grammar.g"
+#line 549 "grammar.g"
 {
 						type = DOMSET; 
 						data = newDomainSet(vars, doms);
 					}
-#line 642 "grammar.c"
+#line 946 "grammar.c"
 break;
 }
-#line 256 "grammar.g"
+#line 554 "grammar.g"
 {LLretval = newRecursiveType(type, data);}
-#line 647 "grammar.c"
+#line 951 "grammar.c"
 }
 return LLretval;
 }
 static RecursiveType LL7_constraintspec(void){
-#line 259 "grammar.g"
+#line 557 "grammar.g"
 RecursiveType
-#line 654 "grammar.c"
+#line 958 "grammar.c"
 LLretval;
-#line 259 "grammar.g"
+#line 557 "grammar.g"
 RecursiveType
-#line 658 "grammar.c"
+#line 962 "grammar.c"
 cspec;
-#line 314 "grammar.g"
+#line 612 "grammar.g"
 Constraint
-#line 662 "grammar.c"
+#line 966 "grammar.c"
 c;
-#line 277 "grammar.g"
+#line 575 "grammar.g"
 ForAll
-#line 666 "grammar.c"
+#line 970 "grammar.c"
 fa;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&cspec, 0, sizeof(cspec));
 memset(&c, 0, sizeof(c));
 memset(&fa, 0, sizeof(fa));
 {
-#line 259 "grammar.g"
-Type type; void *data; List items = NULL;
-#line 675 "grammar.c"
+#line 557 "grammar.g"
+Type type; void *data; List items = NULL; List last = NULL;
+#line 979 "grammar.c"
 LLscnt[9]++;
 LL_0:
 switch (LLcsymb) {
@@ -707,10 +1011,13 @@ case 42:/* MINIMUMTOK */
 case 43:/* EQUALTOK */
 case 44:/* INCREASINGTOK */
 case 45:/* DECREASINGTOK */
+case 46:/* TABLETOK */
+case 47:/* COUNTTOK */
+case 48:/* GCCTOK */
 cspec = LL7_constraintspec();
-#line 264 "grammar.g"
-{items = addToListEnd(cspec, items);}
-#line 714 "grammar.c"
+#line 562 "grammar.g"
+{items = addToListEnd(cspec, items, &last);}
+#line 1021 "grammar.c"
 LLread();
 continue;
 }
@@ -719,9 +1026,9 @@ break;
 }
 LLtcnt[38]--;
 LL_SCANDONE(294);/* ENDTOK */
-#line 266 "grammar.g"
+#line 564 "grammar.g"
 {type = FORALL; fa->items = items; data = fa;}
-#line 725 "grammar.c"
+#line 1032 "grammar.c"
 break;
 default:
 if (LLskip())
@@ -744,37 +1051,40 @@ case 42:/* MINIMUMTOK */
 case 43:/* EQUALTOK */
 case 44:/* INCREASINGTOK */
 case 45:/* DECREASINGTOK */
+case 46:/* TABLETOK */
+case 47:/* COUNTTOK */
+case 48:/* GCCTOK */
 LLscnt[9]--;
 LLtcnt[16]++;
 c = LL13_constraint();
 LLtcnt[16]--;
 LL_SCANDONE(272);/* SEMITOK */
-#line 269 "grammar.g"
+#line 567 "grammar.g"
 {
 						type = CONSTRAINT;
 						data = c;
 					}
-#line 758 "grammar.c"
+#line 1068 "grammar.c"
 break;
 }
-#line 274 "grammar.g"
+#line 572 "grammar.g"
 {LLretval = newRecursiveType(type, data);}
-#line 763 "grammar.c"
+#line 1073 "grammar.c"
 }
 return LLretval;
 }
 static ForAll LL8_forallspec(void){
-#line 277 "grammar.g"
+#line 575 "grammar.g"
 ForAll
-#line 770 "grammar.c"
+#line 1080 "grammar.c"
 LLretval;
-#line 289 "grammar.g"
+#line 587 "grammar.g"
 List
-#line 774 "grammar.c"
+#line 1084 "grammar.c"
 values;
-#line 382 "grammar.g"
+#line 680 "grammar.g"
 char *
-#line 778 "grammar.c"
+#line 1088 "grammar.c"
 name;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&values, 0, sizeof(values));
@@ -801,9 +1111,9 @@ values = LL10_domain();
 LLread();
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
-#line 280 "grammar.g"
+#line 578 "grammar.g"
 {LLretval = newForAll(name, values, NULL);}
-#line 807 "grammar.c"
+#line 1117 "grammar.c"
 }
 return LLretval;
 }
@@ -824,25 +1134,25 @@ LLscnt[3]--;
 LL_SCANDONE(263);/* BOOLTYPE */
 break;
 }
-#line 285 "grammar.g"
+#line 583 "grammar.g"
 {prnt(yytext);}
-#line 830 "grammar.c"
+#line 1140 "grammar.c"
 }
 static List LL10_domain(void){
-#line 289 "grammar.g"
+#line 587 "grammar.g"
 List
-#line 835 "grammar.c"
+#line 1145 "grammar.c"
 LLretval;
-#line 300 "grammar.g"
+#line 598 "grammar.g"
 Subdomain
-#line 839 "grammar.c"
+#line 1149 "grammar.c"
 dom;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&dom, 0, sizeof(dom));
 {
-#line 289 "grammar.g"
-LLretval = NULL;
-#line 846 "grammar.c"
+#line 587 "grammar.g"
+List last = NULL; LLretval = NULL;
+#line 1156 "grammar.c"
 LLscnt[10]++;
 LLtcnt[15]++;
 LLtcnt[10]++;
@@ -850,9 +1160,9 @@ LL_SCANDONE(265);/* BRACKOPEN */
 LLread();
 LLscnt[10]--;
 dom = LL11_subdomain();
-#line 292 "grammar.g"
-{LLretval = addToListEnd(dom, LLretval);}
-#line 856 "grammar.c"
+#line 590 "grammar.g"
+{LLretval = addToListEnd(dom, LLretval, &last);}
+#line 1166 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
@@ -867,9 +1177,9 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[10]--;
 dom = LL11_subdomain();
-#line 295 "grammar.g"
-{LLretval = addToListEnd(dom, LLretval);}
-#line 873 "grammar.c"
+#line 593 "grammar.g"
+{LLretval = addToListEnd(dom, LLretval, &last);}
+#line 1183 "grammar.c"
 continue;
 }
 LLtcnt[15]--;
@@ -881,30 +1191,30 @@ LL_SCANDONE(266);/* BRACKCLOSE */
 return LLretval;
 }
 static Subdomain LL11_subdomain(void){
-#line 300 "grammar.g"
+#line 598 "grammar.g"
 Subdomain
-#line 887 "grammar.c"
+#line 1197 "grammar.c"
 LLretval;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 891 "grammar.c"
+#line 1201 "grammar.c"
 min;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 895 "grammar.c"
+#line 1205 "grammar.c"
 max;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&min, 0, sizeof(min));
 memset(&max, 0, sizeof(max));
 {
-#line 300 "grammar.g"
+#line 598 "grammar.g"
 NumExp min, max;
-#line 903 "grammar.c"
+#line 1213 "grammar.c"
 LLtcnt[30]++;
 min = LL14_numexp();
-#line 302 "grammar.g"
+#line 600 "grammar.g"
 {max = min;}
-#line 908 "grammar.c"
+#line 1218 "grammar.c"
 LL_0:
 switch (LLcsymb) {
 default:
@@ -923,46 +1233,46 @@ LLread();
 LLscnt[11]--;
 max = LL14_numexp();
 }
-#line 307 "grammar.g"
+#line 605 "grammar.g"
 {LLretval = newSubdomain(min, max);}
-#line 929 "grammar.c"
+#line 1239 "grammar.c"
 }
 return LLretval;
 }
 static int LL12_posint(void){
-#line 310 "grammar.g"
+#line 608 "grammar.g"
 int
-#line 936 "grammar.c"
+#line 1246 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
 LL_SCANDONE(285);/* DECTOK */
-#line 311 "grammar.g"
+#line 609 "grammar.g"
 {LLretval = atoi(yytext);}
-#line 943 "grammar.c"
+#line 1253 "grammar.c"
 }
 return LLretval;
 }
 static Constraint LL13_constraint(void){
-#line 314 "grammar.g"
+#line 612 "grammar.g"
 Constraint
-#line 950 "grammar.c"
+#line 1260 "grammar.c"
 LLretval;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 954 "grammar.c"
+#line 1264 "grammar.c"
 exp1;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 958 "grammar.c"
+#line 1268 "grammar.c"
 exp2;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&exp1, 0, sizeof(exp1));
 memset(&exp2, 0, sizeof(exp2));
 {
-#line 314 "grammar.g"
+#line 612 "grammar.g"
 NumExp exp2 = NULL; NumExp exp1 = NULL; char *op = NULL;
-#line 966 "grammar.c"
+#line 1276 "grammar.c"
 LLscnt[12]++;
 exp1 = LL14_numexp();
 LL_0:
@@ -986,39 +1296,39 @@ LLscnt[12]--;
 LLscnt[12]++;
 LLscnt[11]++;
 LL26_relop();
-#line 318 "grammar.g"
+#line 616 "grammar.g"
 {op = copyToken();}
-#line 992 "grammar.c"
+#line 1302 "grammar.c"
 LLread();
 LLscnt[11]--;
 exp2 = LL14_numexp();
 }
-#line 321 "grammar.g"
+#line 619 "grammar.g"
 {LLretval = newConstraint(exp1, op, exp2);}
-#line 999 "grammar.c"
+#line 1309 "grammar.c"
 }
 return LLretval;
 }
 static NumExp LL14_numexp(void){
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 1006 "grammar.c"
+#line 1316 "grammar.c"
 LLretval;
-#line 334 "grammar.g"
+#line 632 "grammar.g"
 Term
-#line 1010 "grammar.c"
+#line 1320 "grammar.c"
 t;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&t, 0, sizeof(t));
 {
-#line 324 "grammar.g"
-List termList = NULL; List opList = NULL;
-#line 1017 "grammar.c"
+#line 622 "grammar.g"
+List termList = NULL; List opList = NULL; List termLast = NULL; List opLast = NULL;
+#line 1327 "grammar.c"
 LLscnt[13]++;
 t = LL15_term();
-#line 326 "grammar.g"
-{termList = addToListEnd(t, termList);}
-#line 1022 "grammar.c"
+#line 624 "grammar.g"
+{termList = addToListEnd(t, termList, &termLast);}
+#line 1332 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
@@ -1042,46 +1352,46 @@ case 12:/* PLUSTOK */
 LLscnt[13]++;
 LLscnt[14]++;
 LL27_termop();
-#line 328 "grammar.g"
-{opList = addToListEnd(copyToken(), opList);}
-#line 1048 "grammar.c"
+#line 626 "grammar.g"
+{opList = addToListEnd(copyToken(), opList, &opLast);}
+#line 1358 "grammar.c"
 LLread();
 LLscnt[14]--;
 t = LL15_term();
-#line 329 "grammar.g"
-{termList = addToListEnd(t, termList);}
-#line 1054 "grammar.c"
+#line 627 "grammar.g"
+{termList = addToListEnd(t, termList, &termLast);}
+#line 1364 "grammar.c"
 continue;
 }
 LLscnt[13]--;
 break;
 }
-#line 331 "grammar.g"
+#line 629 "grammar.g"
 {LLretval = newNumExp(termList, opList);}
-#line 1062 "grammar.c"
+#line 1372 "grammar.c"
 }
 return LLretval;
 }
 static Term LL15_term(void){
-#line 334 "grammar.g"
+#line 632 "grammar.g"
 Term
-#line 1069 "grammar.c"
+#line 1379 "grammar.c"
 LLretval;
-#line 344 "grammar.g"
+#line 642 "grammar.g"
 Factor
-#line 1073 "grammar.c"
+#line 1383 "grammar.c"
 f;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&f, 0, sizeof(f));
 {
-#line 334 "grammar.g"
-List factorList = NULL; List opList = NULL; 
-#line 1080 "grammar.c"
+#line 632 "grammar.g"
+List factorList = NULL; List opList = NULL; List factorLast = NULL; List opLast = NULL; 
+#line 1390 "grammar.c"
 LLscnt[15]++;
 f = LL16_factor();
-#line 336 "grammar.g"
-{factorList = addToListEnd(f, factorList);}
-#line 1085 "grammar.c"
+#line 634 "grammar.g"
+{factorList = addToListEnd(f, factorList, &factorLast);}
+#line 1395 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
@@ -1108,46 +1418,46 @@ case 25:/* DIVTOK */
 LLscnt[15]++;
 LLscnt[16]++;
 LL28_factorop();
-#line 338 "grammar.g"
-{opList = addToListEnd(copyToken(), opList);}
-#line 1114 "grammar.c"
+#line 636 "grammar.g"
+{opList = addToListEnd(copyToken(), opList, &opLast);}
+#line 1424 "grammar.c"
 LLread();
 LLscnt[16]--;
 f = LL16_factor();
-#line 339 "grammar.g"
-{factorList = addToListEnd(f, factorList);}
-#line 1120 "grammar.c"
+#line 637 "grammar.g"
+{factorList = addToListEnd(f, factorList, &factorLast);}
+#line 1430 "grammar.c"
 continue;
 }
 LLscnt[15]--;
 break;
 }
-#line 341 "grammar.g"
+#line 639 "grammar.g"
 {LLretval = newTerm(factorList, opList);}
-#line 1128 "grammar.c"
+#line 1438 "grammar.c"
 }
 return LLretval;
 }
 static Factor LL16_factor(void){
-#line 344 "grammar.g"
+#line 642 "grammar.g"
 Factor
-#line 1135 "grammar.c"
+#line 1445 "grammar.c"
 LLretval;
-#line 344 "grammar.g"
+#line 642 "grammar.g"
 Factor
-#line 1139 "grammar.c"
+#line 1449 "grammar.c"
 f;
-#line 355 "grammar.g"
+#line 653 "grammar.g"
 Value
-#line 1143 "grammar.c"
+#line 1453 "grammar.c"
 v;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&f, 0, sizeof(f));
 memset(&v, 0, sizeof(v));
 {
-#line 344 "grammar.g"
+#line 642 "grammar.g"
 Type ftype = -1; void *data;
-#line 1151 "grammar.c"
+#line 1461 "grammar.c"
 LLscnt[16]++;
 LL_0:
 switch (LLcsymb) {
@@ -1171,11 +1481,14 @@ case 42:/* MINIMUMTOK */
 case 43:/* EQUALTOK */
 case 44:/* INCREASINGTOK */
 case 45:/* DECREASINGTOK */
+case 46:/* TABLETOK */
+case 47:/* COUNTTOK */
+case 48:/* GCCTOK */
 LLscnt[16]--;
 v = LL17_value();
-#line 347 "grammar.g"
+#line 645 "grammar.g"
 {ftype = VALUE; data = v;}
-#line 1179 "grammar.c"
+#line 1492 "grammar.c"
 break;
 case 11:/* MINUSTOK */
 LLscnt[16]--;
@@ -1184,41 +1497,41 @@ LL_SCANDONE(267);/* MINUSTOK */
 LLread();
 LLscnt[16]--;
 f = LL16_factor();
-#line 350 "grammar.g"
+#line 648 "grammar.g"
 {ftype = NEGATION; data = f;}
-#line 1190 "grammar.c"
+#line 1503 "grammar.c"
 break;
 }
-#line 352 "grammar.g"
+#line 650 "grammar.g"
 {LLretval = newFactor(ftype, data);}
-#line 1195 "grammar.c"
+#line 1508 "grammar.c"
 }
 return LLretval;
 }
 static Value LL17_value(void){
-#line 355 "grammar.g"
+#line 653 "grammar.g"
 Value
-#line 1202 "grammar.c"
+#line 1515 "grammar.c"
 LLretval;
-#line 405 "grammar.g"
+#line 703 "grammar.g"
 VarCall
-#line 1206 "grammar.c"
+#line 1519 "grammar.c"
 vsc;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 1210 "grammar.c"
+#line 1523 "grammar.c"
 e;
-#line 310 "grammar.g"
+#line 608 "grammar.g"
 int
-#line 1214 "grammar.c"
+#line 1527 "grammar.c"
 posint;
-#line 344 "grammar.g"
+#line 642 "grammar.g"
 Factor
-#line 1218 "grammar.c"
+#line 1531 "grammar.c"
 powFactor;
-#line 413 "grammar.g"
+#line 711 "grammar.g"
 FunctionCall
-#line 1222 "grammar.c"
+#line 1535 "grammar.c"
 fc;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&vsc, 0, sizeof(vsc));
@@ -1227,9 +1540,9 @@ memset(&posint, 0, sizeof(posint));
 memset(&powFactor, 0, sizeof(powFactor));
 memset(&fc, 0, sizeof(fc));
 {
-#line 355 "grammar.g"
+#line 653 "grammar.g"
 Type vtype = -1; int powtok = 0; Factor powFactor = NULL; void *data; 
-#line 1233 "grammar.c"
+#line 1546 "grammar.c"
 LLscnt[17]++;
 LLtcnt[14]++;
 LL_0:
@@ -1241,17 +1554,17 @@ goto LL_0;
 case 29:/* DECTOK */
 LLscnt[17]--;
 posint = LL12_posint();
-#line 358 "grammar.g"
+#line 656 "grammar.g"
 {vtype = INT; data = copyToken();}
-#line 1247 "grammar.c"
+#line 1560 "grammar.c"
 LLread();
 break;
 case 28:/* VARNAME */
 LLscnt[17]--;
 vsc = LL22_varcall();
-#line 360 "grammar.g"
+#line 658 "grammar.g"
 {vtype = VARSUBSTCALL; data = vsc;}
-#line 1255 "grammar.c"
+#line 1568 "grammar.c"
 break;
 case 5:/* ALLTOK */
 case 31:/* MAXTOK */
@@ -1266,11 +1579,14 @@ case 42:/* MINIMUMTOK */
 case 43:/* EQUALTOK */
 case 44:/* INCREASINGTOK */
 case 45:/* DECREASINGTOK */
+case 46:/* TABLETOK */
+case 47:/* COUNTTOK */
+case 48:/* GCCTOK */
 LLscnt[17]--;
 fc = LL23_functioncall();
-#line 362 "grammar.g"
+#line 660 "grammar.g"
 {vtype = FUNCTIONCALL; data = fc;}
-#line 1274 "grammar.c"
+#line 1590 "grammar.c"
 LLread();
 break;
 case 26:/* PARENTOPEN */
@@ -1281,9 +1597,9 @@ LL_SCANDONE(282);/* PARENTOPEN */
 LLread();
 LLscnt[11]--;
 e = LL14_numexp();
-#line 365 "grammar.g"
+#line 663 "grammar.g"
 {vtype = NUMEXP; data = e;}
-#line 1287 "grammar.c"
+#line 1603 "grammar.c"
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
 LLread();
@@ -1317,44 +1633,44 @@ case 14:/* POWTOK */
 LLtcnt[14]--;
 LLscnt[16]++;
 LL_SCANDONE(270);/* POWTOK */
-#line 369 "grammar.g"
+#line 667 "grammar.g"
 {powtok = 1;}
-#line 1323 "grammar.c"
+#line 1639 "grammar.c"
 LLread();
 LLscnt[16]--;
 powFactor = LL16_factor();
 }
-#line 372 "grammar.g"
+#line 670 "grammar.g"
 {LLretval = newValue(vtype, data, powtok, powFactor);}
-#line 1330 "grammar.c"
+#line 1646 "grammar.c"
 }
 return LLretval;
 }
 static List LL18_constraintlist(void){
-#line 376 "grammar.g"
+#line 674 "grammar.g"
 List
-#line 1337 "grammar.c"
+#line 1653 "grammar.c"
 LLretval;
-#line 314 "grammar.g"
+#line 612 "grammar.g"
 Constraint
-#line 1341 "grammar.c"
+#line 1657 "grammar.c"
 c;
-#line 314 "grammar.g"
+#line 612 "grammar.g"
 Constraint
-#line 1345 "grammar.c"
+#line 1661 "grammar.c"
 c2;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&c, 0, sizeof(c));
 memset(&c2, 0, sizeof(c2));
 {
-#line 376 "grammar.g"
-LLretval = NULL;
-#line 1353 "grammar.c"
+#line 674 "grammar.g"
+List last = NULL; LLretval = NULL;
+#line 1669 "grammar.c"
 LLtcnt[15]++;
 c = LL13_constraint();
-#line 378 "grammar.g"
-{LLretval = addToListEnd(c, LLretval);}
-#line 1358 "grammar.c"
+#line 676 "grammar.g"
+{LLretval = addToListEnd(c, LLretval, &last);}
+#line 1674 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
@@ -1369,9 +1685,9 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[18]--;
 c2 = LL13_constraint();
-#line 379 "grammar.g"
-{LLretval = addToListEnd(c2, LLretval);}
-#line 1375 "grammar.c"
+#line 677 "grammar.g"
+{LLretval = addToListEnd(c2, LLretval, &last);}
+#line 1691 "grammar.c"
 continue;
 }
 LLtcnt[15]--;
@@ -1381,23 +1697,23 @@ break;
 return LLretval;
 }
 static char * LL19_varname(void){
-#line 382 "grammar.g"
+#line 680 "grammar.g"
 char *
-#line 1387 "grammar.c"
+#line 1703 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
 LL_SCANDONE(284);/* VARNAME */
-#line 383 "grammar.g"
+#line 681 "grammar.g"
 {LLretval = copyToken();}
-#line 1394 "grammar.c"
+#line 1710 "grammar.c"
 }
 return LLretval;
 }
 static NumExp LL20_indexspec(void){
-#line 386 "grammar.g"
+#line 684 "grammar.g"
 NumExp
-#line 1401 "grammar.c"
+#line 1717 "grammar.c"
 LLretval;
 memset(&LLretval, 0, sizeof(LLretval));
 {
@@ -1413,24 +1729,24 @@ LL_SCANDONE(266);/* BRACKCLOSE */
 return LLretval;
 }
 static void LL21_vardef
-#line 390 "grammar.g"
+#line 688 "grammar.g"
 (int comma)
-#line 1419 "grammar.c"
+#line 1735 "grammar.c"
 {
-#line 386 "grammar.g"
+#line 684 "grammar.g"
 NumExp
-#line 1423 "grammar.c"
+#line 1739 "grammar.c"
 idx;
-#line 382 "grammar.g"
+#line 680 "grammar.g"
 char *
-#line 1427 "grammar.c"
+#line 1743 "grammar.c"
 name;
 memset(&idx, 0, sizeof(idx));
 memset(&name, 0, sizeof(name));
 {
-#line 390 "grammar.g"
-int dims = 0; List dimsizes = NULL;
-#line 1434 "grammar.c"
+#line 688 "grammar.g"
+int dims = 0; List dimsizes = NULL; List last = NULL;
+#line 1750 "grammar.c"
 LLtcnt[9]++;
 name = LL19_varname();
 LLread();
@@ -1445,47 +1761,47 @@ case 17:/* COLONTOK */
 break;
 case 9:/* BRACKOPEN */
 idx = LL20_indexspec();
-#line 393 "grammar.g"
+#line 691 "grammar.g"
 {
 			dims++; 
-			dimsizes = addToListEnd(idx, dimsizes);
+			dimsizes = addToListEnd(idx, dimsizes, &last);
 		}
-#line 1454 "grammar.c"
+#line 1770 "grammar.c"
 LLread();
 continue;
 }
 LLtcnt[9]--;
 break;
 }
-#line 398 "grammar.g"
+#line 696 "grammar.g"
 {
 		Variable var = newVariable(name, dims, dimsizes);
 		addVarToDB(var);
 		rewriteVarDef(var, comma);
 	}
-#line 1467 "grammar.c"
+#line 1783 "grammar.c"
 }
 }
 static VarCall LL22_varcall(void){
-#line 405 "grammar.g"
+#line 703 "grammar.g"
 VarCall
-#line 1473 "grammar.c"
+#line 1789 "grammar.c"
 LLretval;
-#line 289 "grammar.g"
+#line 587 "grammar.g"
 List
-#line 1477 "grammar.c"
+#line 1793 "grammar.c"
 dom;
-#line 382 "grammar.g"
+#line 680 "grammar.g"
 char *
-#line 1481 "grammar.c"
+#line 1797 "grammar.c"
 name;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&dom, 0, sizeof(dom));
 memset(&name, 0, sizeof(name));
 {
-#line 405 "grammar.g"
-List indices = NULL; char *name;
-#line 1489 "grammar.c"
+#line 703 "grammar.g"
+List indices = NULL; List last = NULL; char *name;
+#line 1805 "grammar.c"
 LLtcnt[9]++;
 name = LL19_varname();
 LLread();
@@ -1503,6 +1819,7 @@ case 13:/* STARTOK */
 case 14:/* POWTOK */
 case 15:/* COMMATOK */
 case 16:/* SEMITOK */
+case 17:/* COLONTOK */
 case 18:/* ISTOK */
 case 19:/* SMALLERTOK */
 case 20:/* GREATERTOK */
@@ -1516,56 +1833,61 @@ case 30:/* RANGETOK */
 break;
 case 9:/* BRACKOPEN */
 dom = LL10_domain();
-#line 408 "grammar.g"
-{indices = addToListEnd(dom, indices); }
-#line 1522 "grammar.c"
+#line 706 "grammar.g"
+{indices = addToListEnd(dom, indices, &last); }
+#line 1839 "grammar.c"
 LLread();
 continue;
 }
 LLtcnt[9]--;
 break;
 }
-#line 410 "grammar.g"
+#line 708 "grammar.g"
 {LLretval = newVarCall(name, indices);}
-#line 1531 "grammar.c"
+#line 1848 "grammar.c"
 }
 return LLretval;
 }
 static FunctionCall LL23_functioncall(void){
-#line 413 "grammar.g"
+#line 711 "grammar.g"
 FunctionCall
-#line 1538 "grammar.c"
+#line 1855 "grammar.c"
 LLretval;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 1542 "grammar.c"
+#line 1859 "grammar.c"
 e;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 1546 "grammar.c"
+#line 1863 "grammar.c"
 exp1;
-#line 324 "grammar.g"
+#line 622 "grammar.g"
 NumExp
-#line 1550 "grammar.c"
+#line 1867 "grammar.c"
 exp2;
-#line 376 "grammar.g"
+#line 674 "grammar.g"
 List
-#line 1554 "grammar.c"
+#line 1871 "grammar.c"
 cl;
-#line 405 "grammar.g"
+#line 703 "grammar.g"
 VarCall
-#line 1558 "grammar.c"
+#line 1875 "grammar.c"
 vc;
+#line 802 "grammar.g"
+List
+#line 1879 "grammar.c"
+t;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&e, 0, sizeof(e));
 memset(&exp1, 0, sizeof(exp1));
 memset(&exp2, 0, sizeof(exp2));
 memset(&cl, 0, sizeof(cl));
 memset(&vc, 0, sizeof(vc));
+memset(&t, 0, sizeof(t));
 {
-#line 413 "grammar.g"
-char *funcName; Type type = -1; List argList = NULL;
-#line 1569 "grammar.c"
+#line 711 "grammar.g"
+char *funcName; Type type = -1; List argList = NULL; List last = NULL; List vars = NULL; List varsLast = NULL;
+#line 1891 "grammar.c"
 LLscnt[19]++;
 LL_0:
 switch (LLcsymb) {
@@ -1593,26 +1915,26 @@ LLscnt[20]--;
 LL_SCANDONE(288);/* MINTOK */
 break;
 }
-#line 415 "grammar.g"
+#line 713 "grammar.g"
 {funcName = copyToken(); type = MAXMIN;}
-#line 1599 "grammar.c"
+#line 1921 "grammar.c"
 LLread();
 LLtcnt[26]--;
 LL_SCANDONE(282);/* PARENTOPEN */
 LLread();
 LLscnt[11]--;
 exp1 = LL14_numexp();
-#line 417 "grammar.g"
-{argList = addToListEnd(exp1, argList);}
-#line 1608 "grammar.c"
+#line 715 "grammar.g"
+{argList = addToListEnd(exp1, argList, &last);}
+#line 1930 "grammar.c"
 LLtcnt[15]--;
 LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[11]--;
 exp2 = LL14_numexp();
-#line 419 "grammar.g"
-{argList = addToListEnd(exp2, argList);}
-#line 1616 "grammar.c"
+#line 717 "grammar.g"
+{argList = addToListEnd(exp2, argList, &last);}
+#line 1938 "grammar.c"
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
 break;
@@ -1642,18 +1964,18 @@ LLscnt[21]--;
 LL_SCANDONE(290);/* ANYTOK */
 break;
 }
-#line 422 "grammar.g"
+#line 720 "grammar.g"
 {funcName = copyToken(); type = ALLANY;}
-#line 1648 "grammar.c"
+#line 1970 "grammar.c"
 LLread();
 LLtcnt[26]--;
 LL_SCANDONE(282);/* PARENTOPEN */
 LLread();
 LLscnt[22]--;
 cl = LL18_constraintlist();
-#line 424 "grammar.g"
+#line 722 "grammar.g"
 {argList = cl;}
-#line 1657 "grammar.c"
+#line 1979 "grammar.c"
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
 break;
@@ -1663,18 +1985,18 @@ LLtcnt[26]++;
 LLscnt[11]++;
 LLtcnt[27]++;
 LL_SCANDONE(289);/* ABSTOK */
-#line 427 "grammar.g"
+#line 725 "grammar.g"
 {funcName = copyToken(); type = ABS;}
-#line 1669 "grammar.c"
+#line 1991 "grammar.c"
 LLread();
 LLtcnt[26]--;
 LL_SCANDONE(282);/* PARENTOPEN */
 LLread();
 LLscnt[11]--;
 e = LL14_numexp();
-#line 429 "grammar.g"
-{argList = addToListEnd(e, argList);}
-#line 1678 "grammar.c"
+#line 727 "grammar.g"
+{argList = addToListEnd(e, argList, &last);}
+#line 2000 "grammar.c"
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
 break;
@@ -1701,58 +2023,58 @@ goto LL_3;
 case 36:/* ALLDIFFTOK */
 LLscnt[23]--;
 LL_SCANDONE(292);/* ALLDIFFTOK */
-#line 433 "grammar.g"
+#line 731 "grammar.g"
 {funcName = copyToken(); type = ALLDIFF;}
-#line 1707 "grammar.c"
+#line 2029 "grammar.c"
 break;
 case 39:/* SUMTOK */
 LLscnt[23]--;
 LL_SCANDONE(295);/* SUMTOK */
-#line 435 "grammar.g"
+#line 733 "grammar.g"
 {funcName = copyToken(); type = SUM;}
-#line 1714 "grammar.c"
+#line 2036 "grammar.c"
 break;
 case 40:/* PRODUCTTOK */
 LLscnt[23]--;
 LL_SCANDONE(296);/* PRODUCTTOK */
-#line 437 "grammar.g"
+#line 735 "grammar.g"
 {funcName = copyToken(); type = PRODUCT;}
-#line 1721 "grammar.c"
+#line 2043 "grammar.c"
 break;
 case 41:/* MAXIMUMTOK */
 LLscnt[23]--;
 LL_SCANDONE(297);/* MAXIMUMTOK */
-#line 439 "grammar.g"
+#line 737 "grammar.g"
 {funcName = copyToken(); type = MAXIMUM;}
-#line 1728 "grammar.c"
+#line 2050 "grammar.c"
 break;
 case 42:/* MINIMUMTOK */
 LLscnt[23]--;
 LL_SCANDONE(298);/* MINIMUMTOK */
-#line 441 "grammar.g"
+#line 739 "grammar.g"
 {funcName = copyToken(); type = MINIMUM;}
-#line 1735 "grammar.c"
+#line 2057 "grammar.c"
 break;
 case 44:/* INCREASINGTOK */
 LLscnt[23]--;
 LL_SCANDONE(300);/* INCREASINGTOK */
-#line 443 "grammar.g"
+#line 741 "grammar.g"
 {funcName = copyToken(); type = INCREASING;}
-#line 1742 "grammar.c"
+#line 2064 "grammar.c"
 break;
 case 45:/* DECREASINGTOK */
 LLscnt[23]--;
 LL_SCANDONE(301);/* DECREASINGTOK */
-#line 445 "grammar.g"
+#line 743 "grammar.g"
 {funcName = copyToken(); type = DECREASING;}
-#line 1749 "grammar.c"
+#line 2071 "grammar.c"
 break;
 case 43:/* EQUALTOK */
 LLscnt[23]--;
 LL_SCANDONE(299);/* EQUALTOK */
-#line 447 "grammar.g"
+#line 745 "grammar.g"
 {funcName = copyToken(); type = EQUAL;}
-#line 1756 "grammar.c"
+#line 2078 "grammar.c"
 break;
 }
 LLread();
@@ -1761,9 +2083,9 @@ LL_SCANDONE(282);/* PARENTOPEN */
 LLread();
 LLscnt[24]--;
 vc = LL22_varcall();
-#line 450 "grammar.g"
-{argList = addToListEnd(vc, argList);}
-#line 1767 "grammar.c"
+#line 748 "grammar.g"
+{argList = addToListEnd(vc, argList, &last);}
+#line 2089 "grammar.c"
 for (;;) {
 LL_4:
 switch (LLcsymb) {
@@ -1778,44 +2100,202 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[24]--;
 vc = LL22_varcall();
-#line 451 "grammar.g"
-{argList = addToListEnd(vc, argList);}
-#line 1784 "grammar.c"
+#line 749 "grammar.g"
+{argList = addToListEnd(vc, argList, &last);}
+#line 2106 "grammar.c"
+continue;
+}
+LLtcnt[15]--;
+break;
+}
+LLtcnt[27]--;
+LL_SCANDONE(283);/* PARENTCLOSE */
+break;
+case 46:/* TABLETOK */
+case 48:/* GCCTOK */
+LLscnt[19]--;
+LLscnt[25]++;
+LLtcnt[26]++;
+LLscnt[24]++;
+LLtcnt[15]++;
+LLtcnt[17]++;
+LLtcnt[9]++;
+LLtcnt[15]++;
+LLtcnt[27]++;
+LL_5:
+switch (LLcsymb) {
+default:
+if (LLskip())
+goto LL_5;
+/*FALLTHROUGH*/
+case 46:/* TABLETOK */
+LLscnt[25]--;
+LL_SCANDONE(302);/* TABLETOK */
+#line 753 "grammar.g"
+{funcName = copyToken(); type = TABLE;}
+#line 2137 "grammar.c"
+break;
+case 48:/* GCCTOK */
+LLscnt[25]--;
+LL_SCANDONE(304);/* GCCTOK */
+#line 755 "grammar.g"
+{funcName = copyToken(); type = GCC;}
+#line 2144 "grammar.c"
+break;
+}
+LLread();
+LLtcnt[26]--;
+LL_SCANDONE(282);/* PARENTOPEN */
+LLread();
+LLscnt[24]--;
+vc = LL22_varcall();
+#line 758 "grammar.g"
+{vars = addToListEnd(vc, vars, &varsLast);}
+#line 2155 "grammar.c"
+for (;;) {
+LL_6:
+switch (LLcsymb) {
+default:
+if (LLskip()) goto LL_6;
+break;
+case 17:/* COLONTOK */
+break;
+case 15:/* COMMATOK */
+LLscnt[24]++;
+LL_SCANDONE(271);/* COMMATOK */
+LLread();
+LLscnt[24]--;
+vc = LL22_varcall();
+#line 759 "grammar.g"
+{vars = addToListEnd(vc, vars, &varsLast);}
+#line 2172 "grammar.c"
+continue;
+}
+LLtcnt[15]--;
+break;
+}
+LLtcnt[17]--;
+LL_SCANDONE(273);/* COLONTOK */
+LLread();
+LLtcnt[9]--;
+t = LL29_tuple();
+#line 761 "grammar.g"
+{argList = addToListEnd(t, argList, &last);}
+#line 2185 "grammar.c"
+LLread();
+for (;;) {
+LL_7:
+switch (LLcsymb) {
+default:
+if (LLskip()) goto LL_7;
+break;
+case 27:/* PARENTCLOSE */
+break;
+case 15:/* COMMATOK */
+LLtcnt[9]++;
+LL_SCANDONE(271);/* COMMATOK */
+LLread();
+LLtcnt[9]--;
+t = LL29_tuple();
+#line 762 "grammar.g"
+{argList = addToListEnd(t, argList, &last);}
+#line 2203 "grammar.c"
+LLread();
+continue;
+}
+LLtcnt[15]--;
+break;
+}
+LLtcnt[27]--;
+LL_SCANDONE(283);/* PARENTCLOSE */
+#line 763 "grammar.g"
+{argList = newList(vars, argList);}
+#line 2214 "grammar.c"
+break;
+case 47:/* COUNTTOK */
+LLscnt[19]--;
+LLtcnt[26]++;
+LLscnt[24]++;
+LLtcnt[15]++;
+LLtcnt[17]++;
+LLscnt[11]++;
+LLtcnt[27]++;
+LL_SCANDONE(303);/* COUNTTOK */
+#line 765 "grammar.g"
+{funcName = copyToken(); type = COUNT;}
+#line 2227 "grammar.c"
+LLread();
+LLtcnt[26]--;
+LL_SCANDONE(282);/* PARENTOPEN */
+LLread();
+LLscnt[24]--;
+vc = LL22_varcall();
+#line 767 "grammar.g"
+{vars = addToListEnd(vc, vars, &varsLast);}
+#line 2236 "grammar.c"
+for (;;) {
+LL_8:
+switch (LLcsymb) {
+default:
+if (LLskip()) goto LL_8;
+break;
+case 17:/* COLONTOK */
+break;
+case 15:/* COMMATOK */
+LLscnt[24]++;
+LL_SCANDONE(271);/* COMMATOK */
+LLread();
+LLscnt[24]--;
+vc = LL22_varcall();
+#line 768 "grammar.g"
+{vars = addToListEnd(vc, vars, &varsLast);}
+#line 2253 "grammar.c"
 continue;
 }
 LLtcnt[15]--;
 break;
 }
+LLtcnt[17]--;
+LL_SCANDONE(273);/* COLONTOK */
+LLread();
+LLscnt[11]--;
+e = LL14_numexp();
+#line 770 "grammar.g"
+{argList = addToListEnd(e, argList, &last);}
+#line 2266 "grammar.c"
 LLtcnt[27]--;
 LL_SCANDONE(283);/* PARENTCLOSE */
+#line 771 "grammar.g"
+{argList = newList(vars, argList);}
+#line 2271 "grammar.c"
 break;
 }
-#line 454 "grammar.g"
+#line 773 "grammar.g"
 {LLretval = newFunctionCall(type, funcName, argList);}
-#line 1796 "grammar.c"
+#line 2276 "grammar.c"
 }
 return LLretval;
 }
 static List LL24_varlist(void){
-#line 457 "grammar.g"
+#line 776 "grammar.g"
 List
-#line 1803 "grammar.c"
+#line 2283 "grammar.c"
 LLretval;
-#line 405 "grammar.g"
+#line 703 "grammar.g"
 VarCall
-#line 1807 "grammar.c"
+#line 2287 "grammar.c"
 vc;
 memset(&LLretval, 0, sizeof(LLretval));
 memset(&vc, 0, sizeof(vc));
 {
-#line 457 "grammar.g"
-LLretval = NULL;
-#line 1814 "grammar.c"
+#line 776 "grammar.g"
+List last = NULL; LLretval = NULL;
+#line 2294 "grammar.c"
 LLtcnt[15]++;
 vc = LL22_varcall();
-#line 459 "grammar.g"
-{LLretval = addToListEnd(vc, LLretval);}
-#line 1819 "grammar.c"
+#line 778 "grammar.g"
+{LLretval = addToListEnd(vc, LLretval, &last);}
+#line 2299 "grammar.c"
 for (;;) {
 LL_0:
 switch (LLcsymb) {
@@ -1830,9 +2310,9 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[24]--;
 vc = LL22_varcall();
-#line 461 "grammar.g"
-{LLretval = addToListEnd(vc, LLretval);}
-#line 1836 "grammar.c"
+#line 780 "grammar.g"
+{LLretval = addToListEnd(vc, LLretval, &last);}
+#line 2316 "grammar.c"
 continue;
 }
 LLtcnt[15]--;
@@ -1844,9 +2324,9 @@ return LLretval;
 static void LL25_vardeflist(void){
 LLtcnt[15]++;
 LL21_vardef
-#line 465 "grammar.g"
+#line 784 "grammar.g"
 (0)
-#line 1850 "grammar.c"
+#line 2330 "grammar.c"
 ;
 for (;;) {
 LL_0:
@@ -1862,9 +2342,9 @@ LL_SCANDONE(271);/* COMMATOK */
 LLread();
 LLscnt[24]--;
 LL21_vardef
-#line 465 "grammar.g"
+#line 784 "grammar.g"
 (1)
-#line 1868 "grammar.c"
+#line 2348 "grammar.c"
 ;
 continue;
 }
@@ -1943,6 +2423,58 @@ LL_SCANDONE(281);/* DIVTOK */
 break;
 }
 }
+static List LL29_tuple(void){
+#line 802 "grammar.g"
+List
+#line 2430 "grammar.c"
+LLretval;
+#line 622 "grammar.g"
+NumExp
+#line 2434 "grammar.c"
+e;
+memset(&LLretval, 0, sizeof(LLretval));
+memset(&e, 0, sizeof(e));
+{
+#line 802 "grammar.g"
+List last = NULL; LLretval = NULL;
+#line 2441 "grammar.c"
+LLscnt[11]++;
+LLtcnt[15]++;
+LLtcnt[10]++;
+LL_SCANDONE(265);/* BRACKOPEN */
+LLread();
+LLscnt[11]--;
+e = LL14_numexp();
+#line 805 "grammar.g"
+{LLretval = addToListEnd(e, LLretval, &last);}
+#line 2451 "grammar.c"
+for (;;) {
+LL_0:
+switch (LLcsymb) {
+default:
+if (LLskip()) goto LL_0;
+break;
+case 10:/* BRACKCLOSE */
+break;
+case 15:/* COMMATOK */
+LLscnt[11]++;
+LL_SCANDONE(271);/* COMMATOK */
+LLread();
+LLscnt[11]--;
+e = LL14_numexp();
+#line 806 "grammar.g"
+{LLretval = addToListEnd(e, LLretval, &last);}
+#line 2468 "grammar.c"
+continue;
+}
+LLtcnt[15]--;
+break;
+}
+LLtcnt[10]--;
+LL_SCANDONE(266);/* BRACKCLOSE */
+}
+return LLretval;
+}
 void parser(void) {
 	memset(LLscnt, 0, LL_NSETS * sizeof(int));
 	memset(LLtcnt, 0, LL_NTERMINALS * sizeof(int));
@@ -4,7 +4,7 @@
 		BRACKOPEN, BRACKCLOSE, MINUSTOK, PLUSTOK, STARTOK, POWTOK, COMMATOK,
 		SEMITOK, COLONTOK, ISTOK, SMALLERTOK, GREATERTOK, NEQTOK, LEQTOK, GEQTOK, MODTOK, 
 		DIVTOK, PARENTOPEN, PARENTCLOSE, VARNAME, DECTOK, RANGETOK, MAXTOK, MINTOK, ABSTOK, ANYTOK,
-		FORALLTOK, ALLDIFFTOK, INTOK, ENDTOK, SUMTOK, PRODUCTTOK, MAXIMUMTOK, MINIMUMTOK, EQUALTOK, INCREASINGTOK, DECREASINGTOK;
+		FORALLTOK, ALLDIFFTOK, INTOK, ENDTOK, SUMTOK, PRODUCTTOK, MAXIMUMTOK, MINIMUMTOK, EQUALTOK, INCREASINGTOK, DECREASINGTOK, TABLETOK, COUNTTOK, GCCTOK;
 %options "generate-lexer-wrapper";
 %lexical yylex;
 
@@ -16,6 +16,9 @@
 #include <unistd.h>
 #include <signal.h>
 #include <sys/wait.h>
+#include <time.h>
+#include "../basicsolver/cspsolver.h"
+#include "cache.h"
 }
 
 {
@@ -83,12 +86,13 @@
 		exit(0);
 	}
 	
-	void waitForChild() {
+	int waitForChild() {
 		int returnStatus; 
 		waitpid(solver_pid, &returnStatus, 0);
 		if (returnStatus == 1) {
 		   printf("The child process terminated with an error!.");
 		}
+		return returnStatus;
 	}
 	
 	int match(char *str1, char *str2) {
@@ -103,6 +107,207 @@
 	
 	
 	
+	/* returns the filename following flag in argv, or NULL if flag is absent */
+	char *optionValue(int argc, char **argv, char *flag) {
+		for(int i = 1; i < argc-2; i++) {
+			if(match(argv[i], flag)) {
+				return argv[i+1];
+			}
+		}
+		return NULL;
+	}
+	
+	/* grounds the instance in inputName to translationName in a child process, returns its pid */
+	int groundInstance(char *inputName, char *translationName) {
+		int pid = fork();
+		if(pid == -1) {
+		    fprintf(stderr, "[ERROR] Could not fork\n");
+		    exit(EXIT_FAILURE);
+		}
+		if(pid == 0) {
+			stdin = fopen(inputName, "r");
+			if(stdin == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", inputName);
+				exit(-1);
+			}
+			stdout = fopen(translationName, "w");
+			if(stdout == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", translationName);
+				exit(-1);
+			}
+			parser();
+			fclose(stdout);
+			exit(0);
+		}
+		return pid;
+	}
+	
+	/* translates the data in dataName for the grounded model to translationName */
+	int translateDataFile(char *dataName, char *translationName) {
+		FILE *in = fopen(dataName, "r");
+		FILE *out;
+		int ok;
+		if(in == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", dataName);
+			return 0;
+		}
+		out = fopen(translationName, "w");
+		if(out == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", translationName);
+			exit(-1);
+		}
+		ok = translateData(in, out, dataName);
+		fclose(out);
+		fclose(in);
+		return ok;
+	}
+	
+	/* waits for a grounding child, removes the translation if the instance could not be grounded */
+	void reapInstance(int *pids, int count, char *dir) {
+		char path[4096];
+		int status, i;
+		int pid = wait(&status);
+		if(pid <= 0 || (WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+			return;
+		}
+		for(i = 0; i < count; i++) {
+			if(pids[i] == pid) {
+				snprintf(path, sizeof(path), "%s/%d.csp", dir, i);
+				unlink(path);
+			}
+		}
+	}
+	
+	/*
+	  csp [OPTION]... [-j N] [-stream FORMAT DIR] [-model MODEL] -batch LIST
+	  
+	  The rewriter keeps its state in globals, so the instances in LIST are
+	  grounded in child processes, N at a time, into a temporary directory.
+	  The translations are then solved by the batch mode of the solver (see
+	  basicsolver/batch.h), which reports them by their name in LIST. An
+	  instance that can not be grounded is reported as unreadable.
+	  
+	  With -model, LIST holds data files for MODEL instead. MODEL is grounded
+	  once, the data only needs its variables translated.
+	*/
+	int batchMain(int argc, char **argv) {
+		char dir[] = "/tmp/cspbatchXXXXXX";
+		char path[4096], listName[4096], modelName[4096];
+		char *model = optionValue(argc, argv, "-model");
+		char *line = NULL, *name;
+		size_t space = 0;
+		ssize_t length;
+		int count = 0, running = 0, allocated = 0, status, i;
+		int *pids;
+		char **inputs = NULL;
+		int jobs = sysconf(_SC_NPROCESSORS_ONLN);
+		FILE *list, *translations;
+		
+		if(optionValue(argc, argv, "-j") != NULL && atoi(optionValue(argc, argv, "-j")) > 0) {
+			jobs = atoi(optionValue(argc, argv, "-j"));
+		}
+		list = fopen(argv[argc-1], "r");
+		if(list == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", argv[argc-1]);
+			exit(-1);
+		}
+		if(mkdtemp(dir) == NULL) {
+			fprintf(stderr, "[ERROR] Could not create a temporary directory\n");
+			exit(-1);
+		}
+		if(model != NULL) {
+			snprintf(modelName, sizeof(modelName), "%s/model.csp", dir);
+			stdin = fopen(model, "r");
+			if(stdin == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", model);
+				exit(-1);
+			}
+			stdout = fopen(modelName, "w");
+			parser();
+			freopen("/dev/stdin", "r", stdin);
+			freopen("/dev/stdout", "w", stdout);
+			for(i = 1; i < argc-2; i++) {
+				if(match(argv[i], "-model")) {
+					argv[i+1] = modelName;
+				}
+			}
+		}
+		snprintf(listName, sizeof(listName), "%s/list", dir);
+		translations = fopen(listName, "w");
+		if(translations == NULL) {
+			fprintf(stderr, "[ERROR] Could not open %s\n", listName);
+			exit(-1);
+		}
+		
+		while((length = getline(&line, &space, list)) != -1) {
+			while(length > 0 && (line[length-1] == '\n' || line[length-1] == '\r')) {
+				line[--length] = '\0';
+			}
+			if(length == 0) {
+				continue;
+			}
+			name = strchr(line, '\t');
+			if(name != NULL) {
+				*name++ = '\0';
+			} else {
+				name = line;
+			}
+			if(count == allocated) {
+				allocated = (allocated == 0 ? 64 : 2*allocated);
+				inputs = realloc(inputs, allocated*sizeof(char *));
+			}
+			inputs[count] = strdup(line);
+			snprintf(path, sizeof(path), "%s/%d.csp", dir, count);
+			fprintf(translations, "%s\t%s\n", path, name);
+			/* data that can not be translated is reported as unreadable */
+			if(model != NULL && !translateDataFile(line, path)) {
+				unlink(path);
+			}
+			count++;
+		}
+		fclose(translations);
+		fclose(list);
+		free(line);
+		/* the children would flush pending output again */
+		fflush(NULL);
+		
+		pids = malloc((count > 0 ? count : 1)*sizeof(int));
+		for(i = 0; i < count && model == NULL; i++) {
+			/* at most jobs children at a time */
+			if(running == jobs) {
+				reapInstance(pids, i, dir);
+				running--;
+			}
+			snprintf(path, sizeof(path), "%s/%d.csp", dir, i);
+			pids[i] = groundInstance(inputs[i], path);
+			running++;
+		}
+		for(i = 0; i < count; i++) {
+			free(inputs[i]);
+		}
+		free(inputs);
+		while(running > 0) {
+			reapInstance(pids, count, dir);
+			running--;
+		}
+		free(pids);
+		
+		argv[0] = "solver";
+		argv[argc-1] = listName;
+		status = cspSolverMain(argc, argv);
+		
+		for(i = 0; i < count; i++) {
+			snprintf(path, sizeof(path), "%s/%d.csp", dir, i);
+			unlink(path);
+		}
+		unlink(listName);
+		if(model != NULL) {
+			unlink(modelName);
+		}
+		rmdir(dir);
+		return status;
+	}
+	
 	int main(int argc, char** argv) {
 		FILE *solution_file;	
 
@@ -124,20 +329,88 @@
 			printf("-deg         Use the degree heuristic.\n");
 			printf("-arc         Keep the problem arc-consistent. Can not be combined with '-fc'\n");
 			printf("-fc          Use Forward Checking. Can not be combined with '-arc'.\n");
+			printf("-presolve    Simplify the problem before the search: remove fixed and aliased\n");
+			printf("             variables, entailed and duplicate constraints.\n");
+			printf("-alldiff     Propagate cliques of pairwise '<>' constraints as alldiff constraints.\n");
+			printf("-maxmin      Propagate R = max(..) and R = min(..) over variables by their bounds.\n");
+			printf("-trace N     Trace level in csp.log: 0 off, 1 info (default), 2 search events, 3 detail.\n");
+			printf("-profile K   Write the K most expensive constraints with their counters to csp.log.\n");
+			printf("-stats       Print search statistics on stderr when the solver exits.\n");
+			printf("-statsjson F Append the search statistics as a JSON line to F.\n");
+			printf("-writenf F   Write the grounded problem in binary normal form to F, do not solve.\n");
+			printf("-stream T F  Write solutions to F ('-' for standard output) while searching,\n");
+			printf("             in format T: text, binary or count (F is not written).\n");
+			printf("-batch L     Solve every instance listed in file L (one per line, as the last\n");
+			printf("             option), writing one JSON line per instance to standard output.\n");
+			printf("-j N         Ground and solve N batch instances at the same time.\n");
+			printf("-data D      Apply the values and domains in file D to the model, e.g.\n");
+			printf("             'b[0][1] = 5; x <- [1..3];'.\n");
+			printf("-model M     Ground M once and solve it for each data file in the batch list.\n");
+			printf("-nocache     Do not use the cache of grounded models.\n");
+			printf("-regenerate  Ground the model even if it is in the cache, and update the cache.\n");
+			printf("-cachesize N Keep the cache below N megabytes (default %d).\n", DEFAULT_CACHE_SIZE);
 			printf("\n");
 			exit(0);
 		}
+		
+		/* the cache options are handled by csp, the solver does not know them */
+		int useCache = 1, regenerate = 0, kept = 1;
+		long cacheSize = DEFAULT_CACHE_SIZE;
+		for(int i = 1; i < argc-1; i++) {
+			if(match(argv[i], "-nocache")) {
+				useCache = 0;
+			} else if(match(argv[i], "-regenerate")) {
+				regenerate = 1;
+			} else if(match(argv[i], "-cachesize")) {
+				if(i+1 >= argc-1 || atol(argv[i+1]) < 0) {
+					fprintf(stderr, "[ERROR] Expecting a size in megabytes following flag '-cachesize'.\n");
+					exit(1);
+				}
+				cacheSize = atol(argv[++i]);
+			} else {
+				argv[kept++] = argv[i];
+			}
+		}
+		argv[kept++] = argv[argc-1];
+		argv[kept] = NULL;
+		argc = kept;
+		
+		if(argc >= 3 && match(argv[argc-2], "-batch")) {
+			return batchMain(argc, argv);
+		}
 
-		stdin = fopen(argv[argc-1], "r");	
-		if(stdin == NULL) {
-			fprintf(stderr, "[ERROR] Could not open %s\n", argv[argc-1]);
-			exit(-1);
-		}		
-		stdout = fopen("translation.csp", "w");	
+		/* a model that has been grounded before is not parsed again */
+		cacheEntry entry;
+		int cached = 0;
+		useCache = useCache && openCacheEntry(argv[argc-1], &entry);
+		if(useCache && !regenerate) {
+			cached = loadCachedModel(&entry, "translation.csp");
+		}
 		
-  		parser();
-  		freopen("/dev/stdin", "r", stdin);
-  		freopen("/dev/stdout", "w", stdout);
+		struct timespec groundStart, groundEnd;
+		clock_gettime(CLOCK_MONOTONIC, &groundStart);
+		if(!cached) {
+			stdin = fopen(argv[argc-1], "r");	
+			if(stdin == NULL) {
+				fprintf(stderr, "[ERROR] Could not open %s\n", argv[argc-1]);
+				exit(-1);
+			}		
+			stdout = fopen("translation.csp", "w");	
+	  		parser();
+	  		freopen("/dev/stdin", "r", stdin);
+	  		freopen("/dev/stdout", "w", stdout);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &groundEnd);
+  		
+  		/* the data of the instance refers to the variables of the model */
+  		for(int i = 1; i < argc-2; i++) {
+  			if(match(argv[i], "-data")) {
+  				if(!translateDataFile(argv[i+1], "translation.dat")) {
+  					exit(-1);
+  				}
+  				argv[i+1] = "translation.dat";
+  			}
+  		}
   		
   		solver_pid = fork();
 		if(solver_pid == -1) {
@@ -148,19 +421,41 @@
   		if(solver_pid == 0) {		    
 		    signal(SIGKILL, exitChild);
 		    
-		    argv[argc-1] = "translation.csp";
-		    int error;
-		    if( access("./solver", F_OK ) != -1 ) { // check if file exists
-		    	argv[0] = "./solver";
-		    	error = execvp("./solver", argv);
-		    } else {
-		    	argv[0] = "solver";
-		    	error = execvp("solver", argv);
+		    argv[argc-1] = (cached ? entry.problem : "translation.csp");
+		    /* the solver reports the grounding time in its statistics */
+		    char groundTime[32];
+		    snprintf(groundTime, sizeof(groundTime), "%.6f", (groundEnd.tv_sec - groundStart.tv_sec) + 
+		    	(groundEnd.tv_nsec - groundStart.tv_nsec)*1.0e-9);
+		    setenv("CSP_GROUND_TIME", groundTime, 1);
+		    argv[0] = "solver";
+		    if(useCache && !cached) {
+		    	/* the solver writes the problem for the cache while it loads it */
+		    	char **args = safeMalloc((argc+3)*sizeof(char *));
+		    	memcpy(args, argv, (argc-1)*sizeof(char *));
+		    	args[argc-1] = "-savenf";
+		    	args[argc] = entry.temporary;
+		    	args[argc+1] = argv[argc-1];
+		    	args[argc+2] = NULL;
+		    	exit(cspSolverMain(argc+2, args));
 		    }
-			fprintf(stderr, "[ERROR] Solver executed with errorcode %d.\n", error);
+		    exit(cspSolverMain(argc, argv));
 		} else {
 			signal(SIGINT, exitParent);
-			waitForChild();
+			int status = waitForChild();
+			if(useCache && !cached) {
+				if(status == 0 && access(entry.temporary, R_OK) == 0) {
+					storeCachedModel(&entry, "translation.csp", cacheSize*1024*1024);
+				} else {
+					unlink(entry.temporary);
+				}
+			}
+			
+			char *binaryOutput = optionValue(argc, argv, "-writenf");
+			if(binaryOutput != NULL) {
+				unlink("solution.txt");
+				printf("Binary normal form written to %s\n", binaryOutput);
+				return 0;
+			}
 			
 			solution_file = fopen("solution.txt", "r");
 			if(solution_file == NULL) {
@@ -171,7 +466,10 @@
 		    fscanf(solution_file, "%d", &backtracking_points);
 		    fscanf(solution_file, "%d", &solution_count);
 		    
-		    for(int i = 0; i < solution_count; i++) {
+		    /* streamed solutions have already been written by the solver */
+		    int streamed = (optionValue(argc, argv, "-stream") != NULL);
+		    
+		    for(int i = 0; i < solution_count && !streamed; i++) {
 		    	printf("### Solution %d ###\n", i+1);
 		    	printSolution(solution_file);
 		    	printf("\n");
@@ -237,13 +535,13 @@ solvespec	:
 				{prnt("\n");}
 			;
 
-domainspec<RecursiveType> {Type type; void *data; List items = NULL;}
+domainspec<RecursiveType> {Type type; void *data; List items = NULL; List last = NULL;}
 			:	
 				[
 					forallspec<fa> 
 					[
 						domainspec<domspec> 
-						{items = addToListEnd(domspec, items);}
+						{items = addToListEnd(domspec, items, &last);}
 					]* 
 					ENDTOK {type = FORALL; fa->items = items; data = fa;}
 					| 
@@ -256,12 +554,12 @@ domainspec<RecursiveType> {Type type; void *data; List items = NULL;}
 				{LLretval = newRecursiveType(type, data);}
 			;
 			
-constraintspec<RecursiveType>  {Type type; void *data; List items = NULL;}
+constraintspec<RecursiveType>  {Type type; void *data; List items = NULL; List last = NULL;}
 			:	[
 					forallspec<fa> 
 					[
 						constraintspec<cspec>
-						{items = addToListEnd(cspec, items);}
+						{items = addToListEnd(cspec, items, &last);}
 					]* 
 					ENDTOK {type = FORALL; fa->items = items; data = fa;}
 					| 
@@ -286,13 +584,13 @@ datatype	:
 			;
 
 
-domain<List> {LLretval = NULL;}
+domain<List> {List last = NULL; LLretval = NULL;}
 			:	
 				BRACKOPEN
-				subdomain<dom> {LLretval = addToListEnd(dom, LLretval);}
+				subdomain<dom> {LLretval = addToListEnd(dom, LLretval, &last);}
 				[	
 					COMMATOK 
-					subdomain<dom> {LLretval = addToListEnd(dom, LLretval);}
+					subdomain<dom> {LLretval = addToListEnd(dom, LLretval, &last);}
 				]* 
 				BRACKCLOSE
 			;
@@ -321,22 +619,22 @@ constraint<Constraint> {NumExp exp2 = NULL; NumExp exp1 = NULL; char *op = NULL;
 				{LLretval = newConstraint(exp1, op, exp2);}
 			;
 
-numexp<NumExp> {List termList = NULL; List opList = NULL;}
+numexp<NumExp> {List termList = NULL; List opList = NULL; List termLast = NULL; List opLast = NULL;}
 		 	:	
-		 		term<t> {termList = addToListEnd(t, termList);}
+		 		term<t> {termList = addToListEnd(t, termList, &termLast);}
 		 		[
-		 			termop {opList = addToListEnd(copyToken(), opList);}
-		 			term<t> {termList = addToListEnd(t, termList);}
+		 			termop {opList = addToListEnd(copyToken(), opList, &opLast);}
+		 			term<t> {termList = addToListEnd(t, termList, &termLast);}
 		 		]*
 		 		{LLretval = newNumExp(termList, opList);}
 		 	;
 		 	
-term<Term>	{List factorList = NULL; List opList = NULL; } 
+term<Term>	{List factorList = NULL; List opList = NULL; List factorLast = NULL; List opLast = NULL; } 
 			:
-				factor<f> {factorList = addToListEnd(f, factorList);} 
+				factor<f> {factorList = addToListEnd(f, factorList, &factorLast);} 
 				[
-					factorop {opList = addToListEnd(copyToken(), opList);} 
-					factor<f> {factorList = addToListEnd(f, factorList);} 
+					factorop {opList = addToListEnd(copyToken(), opList, &opLast);} 
+					factor<f> {factorList = addToListEnd(f, factorList, &factorLast);} 
 				]*
 				{LLretval = newTerm(factorList, opList);} 
 			;
@@ -373,10 +671,10 @@ value<Value>	{Type vtype = -1; int powtok = 0; Factor powFactor = NULL; void *da
 			;
 					
 					
-constraintlist<List>	{LLretval = NULL;}
+constraintlist<List>	{List last = NULL; LLretval = NULL;}
 			:	
-				constraint<c> {LLretval = addToListEnd(c, LLretval);}
-				[COMMATOK constraint<c2> {LLretval = addToListEnd(c2, LLretval);}]*
+				constraint<c> {LLretval = addToListEnd(c, LLretval, &last);}
+				[COMMATOK constraint<c2> {LLretval = addToListEnd(c2, LLretval, &last);}]*
 			;
 
 varname<char *>	:	
@@ -387,12 +685,12 @@ indexspec<NumExp>	:
 	BRACKOPEN numexp<LLretval> BRACKCLOSE
 ;
 
-vardef(int comma) {int dims = 0; List dimsizes = NULL;}	:
+vardef(int comma) {int dims = 0; List dimsizes = NULL; List last = NULL;}	:
 	varname<name>
 	[
 		indexspec<idx> {
 			dims++; 
-			dimsizes = addToListEnd(idx, dimsizes);
+			dimsizes = addToListEnd(idx, dimsizes, &last);
 		}
 	]*
 	{
@@ -402,21 +700,21 @@ vardef(int comma) {int dims = 0; List dimsizes = NULL;}	:
 	}
 ;
 
-varcall<VarCall> {List indices = NULL; char *name;}:	
+varcall<VarCall> {List indices = NULL; List last = NULL; char *name;}:	
 	varname<name>
 	[
-		domain<dom> {indices = addToListEnd(dom, indices); }
+		domain<dom> {indices = addToListEnd(dom, indices, &last); }
 	]*
 	{LLretval = newVarCall(name, indices);}
 ;
 
-functioncall<FunctionCall> {char *funcName; Type type = -1; List argList = NULL;}	
+functioncall<FunctionCall> {char *funcName; Type type = -1; List argList = NULL; List last = NULL; List vars = NULL; List varsLast = NULL;}	
 				:	[
 						[MAXTOK | MINTOK] {funcName = copyToken(); type = MAXMIN;}
 						PARENTOPEN
-						numexp<exp1> {argList = addToListEnd(exp1, argList);}
+						numexp<exp1> {argList = addToListEnd(exp1, argList, &last);}
 						COMMATOK
-						numexp<exp2> {argList = addToListEnd(exp2, argList);}
+						numexp<exp2> {argList = addToListEnd(exp2, argList, &last);}
 						PARENTCLOSE
 						| 
 						[ALLTOK | ANYTOK] {funcName = copyToken(); type = ALLANY;}
@@ -426,7 +724,7 @@ functioncall<FunctionCall> {char *funcName; Type type = -1; List argList = NULL;
 						|
 						ABSTOK {funcName = copyToken(); type = ABS;}
 						PARENTOPEN
-						numexp<e> {argList = addToListEnd(e, argList);}
+						numexp<e> {argList = addToListEnd(e, argList, &last);}
 						PARENTCLOSE
 						|
 						[
@@ -447,18 +745,39 @@ functioncall<FunctionCall> {char *funcName; Type type = -1; List argList = NULL;
 							EQUALTOK {funcName = copyToken(); type = EQUAL;}
 						]
 						PARENTOPEN 
-						varcall<vc> {argList = addToListEnd(vc, argList);}
-						[COMMATOK varcall<vc> {argList = addToListEnd(vc, argList);}]*
+						varcall<vc> {argList = addToListEnd(vc, argList, &last);}
+						[COMMATOK varcall<vc> {argList = addToListEnd(vc, argList, &last);}]*
 						PARENTCLOSE
+						|
+						[
+							TABLETOK {funcName = copyToken(); type = TABLE;}
+							|
+							GCCTOK {funcName = copyToken(); type = GCC;}
+						]
+						PARENTOPEN
+						varcall<vc> {vars = addToListEnd(vc, vars, &varsLast);}
+						[COMMATOK varcall<vc> {vars = addToListEnd(vc, vars, &varsLast);}]*
+						COLONTOK
+						tuple<t> {argList = addToListEnd(t, argList, &last);}
+						[COMMATOK tuple<t> {argList = addToListEnd(t, argList, &last);}]*
+						PARENTCLOSE {argList = newList(vars, argList);}
+						|
+						COUNTTOK {funcName = copyToken(); type = COUNT;}
+						PARENTOPEN
+						varcall<vc> {vars = addToListEnd(vc, vars, &varsLast);}
+						[COMMATOK varcall<vc> {vars = addToListEnd(vc, vars, &varsLast);}]*
+						COLONTOK
+						numexp<e> {argList = addToListEnd(e, argList, &last);}
+						PARENTCLOSE {argList = newList(vars, argList);}
 					]
 					{LLretval = newFunctionCall(type, funcName, argList);}
 		 		;
 		 		
-varlist<List>	{LLretval = NULL;}
+varlist<List>	{List last = NULL; LLretval = NULL;}
 				:	
-					varcall<vc> {LLretval = addToListEnd(vc, LLretval);} 
+					varcall<vc> {LLretval = addToListEnd(vc, LLretval, &last);} 
 					[
-						COMMATOK varcall<vc> {LLretval = addToListEnd(vc, LLretval);} 
+						COMMATOK varcall<vc> {LLretval = addToListEnd(vc, LLretval, &last);} 
 					]*
 				;
 
@@ -480,4 +799,12 @@ factorop		:
 					STARTOK | MODTOK | DIVTOK 
 				;
 
+tuple<List>		{List last = NULL; LLretval = NULL;}
+				:
+					BRACKOPEN
+					numexp<e> {LLretval = addToListEnd(e, LLretval, &last);}
+					[COMMATOK numexp<e> {LLretval = addToListEnd(e, LLretval, &last);}]*
+					BRACKCLOSE
+				;
+
 
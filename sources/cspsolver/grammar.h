@@ -48,8 +48,11 @@
 #define EQUALTOK 299
 #define INCREASINGTOK 300
 #define DECREASINGTOK 301
+#define TABLETOK 302
+#define COUNTTOK 303
+#define GCCTOK 304
 #endif
-#define LL_MAXTOKNO 301
+#define LL_MAXTOKNO 304
 #define LL_MISSINGEOF (-1)
 #define LL_DELETE (0)
 #define LL_VERSION 0x000505L
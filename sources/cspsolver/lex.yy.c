@@ -582,6 +582,8 @@ static int acceptToken(int token) {
   return token;
 }
 
+static int identifierToken();
+
 static void printError(){
 	fprintf(stderr, "\nError in line %d: ", lineNr);
 	fseek(yyin, lastNewLine, SEEK_SET);
@@ -596,7 +598,7 @@ static void printError(){
 	exit(-1);
 }
 
-#line 600 "lex.yy.c"
+#line 602 "lex.yy.c"
 
 #define INITIAL 0
 
@@ -805,10 +807,10 @@ YY_DECL
 		}
 
 	{
-#line 63 "flex.fl"
+#line 65 "flex.fl"
 
 
-#line 812 "lex.yy.c"
+#line 814 "lex.yy.c"
 
 	while ( 1 )		/* loops until end-of-file is reached */
 		{
@@ -867,256 +869,256 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 65 "flex.fl"
+#line 67 "flex.fl"
 { column(yyleng); }
 	YY_BREAK
 case 2:
 /* rule 2 can match eol */
 YY_RULE_SETUP
-#line 67 "flex.fl"
+#line 69 "flex.fl"
 { column(yyleng); newLine(); }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 69 "flex.fl"
+#line 71 "flex.fl"
 { return acceptToken(VARSTOK); }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 70 "flex.fl"
+#line 72 "flex.fl"
 { return acceptToken(INTOK); }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 71 "flex.fl"
+#line 73 "flex.fl"
 { return acceptToken(ENDTOK); }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 72 "flex.fl"
+#line 74 "flex.fl"
 { return acceptToken(INTTYPE); }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 73 "flex.fl"
+#line 75 "flex.fl"
 { return acceptToken(BOOLTYPE); }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 74 "flex.fl"
+#line 76 "flex.fl"
 { return acceptToken(DOMAINSTOK); }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 75 "flex.fl"
+#line 77 "flex.fl"
 { return acceptToken(FORALLTOK); }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 76 "flex.fl"
+#line 78 "flex.fl"
 { return acceptToken(ALLDIFFTOK); }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 77 "flex.fl"
+#line 79 "flex.fl"
 { return acceptToken(EQUALTOK); }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 78 "flex.fl"
+#line 80 "flex.fl"
 { return acceptToken(INCREASINGTOK); }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 79 "flex.fl"
+#line 81 "flex.fl"
 { return acceptToken(DECREASINGTOK); }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 80 "flex.fl"
+#line 82 "flex.fl"
 { return acceptToken(SUMTOK); }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 81 "flex.fl"
+#line 83 "flex.fl"
 { return acceptToken(PRODUCTTOK); }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 82 "flex.fl"
+#line 84 "flex.fl"
 { return acceptToken(MAXIMUMTOK); }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 83 "flex.fl"
+#line 85 "flex.fl"
 { return acceptToken(MINIMUMTOK); }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 84 "flex.fl"
+#line 86 "flex.fl"
 { return acceptToken(CONSTRAINTSTOK); }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 85 "flex.fl"
+#line 87 "flex.fl"
 { return acceptToken(SOLVETOK); }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 86 "flex.fl"
+#line 88 "flex.fl"
 { return acceptToken(RANGETOK); }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 88 "flex.fl"
+#line 90 "flex.fl"
 { return acceptToken(BRACKOPEN); }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 89 "flex.fl"
+#line 91 "flex.fl"
 { return acceptToken(BRACKCLOSE); }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 90 "flex.fl"
+#line 92 "flex.fl"
 { return acceptToken(MINUSTOK); }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 91 "flex.fl"
+#line 93 "flex.fl"
 { return acceptToken(PLUSTOK); }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 92 "flex.fl"
+#line 94 "flex.fl"
 { return acceptToken(STARTOK); }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 93 "flex.fl"
+#line 95 "flex.fl"
 { return acceptToken(POWTOK); }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 94 "flex.fl"
+#line 96 "flex.fl"
 { return acceptToken(COMMATOK); }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 95 "flex.fl"
+#line 97 "flex.fl"
 { return acceptToken(SEMITOK); }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 96 "flex.fl"
+#line 98 "flex.fl"
 { return acceptToken(COLONTOK); }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 97 "flex.fl"
+#line 99 "flex.fl"
 { return acceptToken(ISTOK); }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 98 "flex.fl"
+#line 100 "flex.fl"
 { return acceptToken(SMALLERTOK); }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 99 "flex.fl"
+#line 101 "flex.fl"
 { return acceptToken(GREATERTOK); }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 100 "flex.fl"
+#line 102 "flex.fl"
 { return acceptToken(NEQTOK); }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 101 "flex.fl"
+#line 103 "flex.fl"
 { return acceptToken(LEQTOK); }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 102 "flex.fl"
+#line 104 "flex.fl"
 { return acceptToken(GEQTOK); }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 103 "flex.fl"
+#line 105 "flex.fl"
 { return acceptToken(MODTOK); }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 104 "flex.fl"
+#line 106 "flex.fl"
 { return acceptToken(DIVTOK); }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 105 "flex.fl"
+#line 107 "flex.fl"
 { return acceptToken(ABSTOK); }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 106 "flex.fl"
+#line 108 "flex.fl"
 { return acceptToken(MAXTOK); }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 107 "flex.fl"
+#line 109 "flex.fl"
 { return acceptToken(MINTOK); }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 108 "flex.fl"
+#line 110 "flex.fl"
 { return acceptToken(ANYTOK); }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 109 "flex.fl"
+#line 111 "flex.fl"
 { return acceptToken(ALLTOK); }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 110 "flex.fl"
+#line 112 "flex.fl"
 { return acceptToken(PARENTOPEN); }
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 111 "flex.fl"
+#line 113 "flex.fl"
 { return acceptToken(PARENTCLOSE); }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 112 "flex.fl"
+#line 114 "flex.fl"
 { return acceptToken(ARROWTOK); }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 114 "flex.fl"
-{ return acceptToken(VARNAME); }
+#line 116 "flex.fl"
+{ return acceptToken(identifierToken()); }
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 115 "flex.fl"
+#line 117 "flex.fl"
 { return acceptToken(DECTOK); }
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 116 "flex.fl"
+#line 118 "flex.fl"
 { column(yyleng); }
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
-#line 118 "flex.fl"
+#line 120 "flex.fl"
 { printError(); }
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 119 "flex.fl"
+#line 121 "flex.fl"
 ECHO;
 	YY_BREAK
-#line 1120 "lex.yy.c"
+#line 1122 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2111,10 +2113,48 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 119 "flex.fl"
+#line 121 "flex.fl"
 
 
 
+/*
+  table, count and gcc are keywords only where a call follows, as in
+  "count(x : 1)", elsewhere they are names like any other identifier.
+  The white space up to the next character is read ahead and pushed back.
+*/
+static int callFollows() {
+	char ahead[64];
+	int n = 0, c;
+	do {
+		c = input();
+		if(c == EOF) {
+			return 0;
+		}
+		ahead[n++] = c;
+	} while((c == ' ' || c == '\t' || c == '\n' || c == '\r') && n < sizeof(ahead));
+	while(n > 0) {
+		unput(ahead[--n]);
+	}
+	/* unput() overwrites the end of yytext */
+	yytext[yyleng] = '\0';
+	return (c == '(');
+}
+
+static int identifierToken() {
+	int token = VARNAME;
+	if(strcmp(yytext, "table") == 0) {
+		token = TABLETOK;
+	} else if(strcmp(yytext, "count") == 0) {
+		token = COUNTTOK;
+	} else if(strcmp(yytext, "gcc") == 0) {
+		token = GCCTOK;
+	}
+	if(token != VARNAME && !callFollows()) {
+		token = VARNAME;
+	}
+	return token;
+}
+
 /*
 int main(int argc, char** argv) {
   if(argc == 2) {
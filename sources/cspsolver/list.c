@@ -11,12 +11,13 @@ List newList(void *item, List next) {
 }
 
 void freeList(List l) {
-	if(l == NULL) {
-		return;
+	List next;
+	while(l != NULL) {
+		next = l->next;
+		free(l->item);
+		free(l);
+		l = next;
 	}
-	freeList(l->next);
-	free(l->item);
-	free(l);
 }
 
 int listLength(List l) {
@@ -28,14 +29,17 @@ int listLength(List l) {
 	return length;
 }
 
-List addToListEnd(void *data, List l) {
+/*
+  Appends data to list l in constant time. last points to the last cell of
+  l, it is updated; both are NULL for an empty list. Returns the list.
+*/
+List addToListEnd(void *data, List l, List *last) {
+	List cell = newList(data, NULL);
 	if(l == NULL) {
-		return newList(data, NULL);
-	}
-	List ptr = l;
-	while(ptr->next != NULL) {
-		ptr = ptr->next;
+		l = cell;
+	} else {
+		(*last)->next = cell;
 	}
-	ptr->next = newList(data, NULL);
+	*last = cell;
 	return l;
 }
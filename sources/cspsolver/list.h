@@ -13,6 +13,6 @@ typedef struct list {
 List newList(void *item, List next);
 void freeList(List l);
 int listLength(List l);
-List addToListEnd(void *data, List l);
+List addToListEnd(void *data, List l, List *last);
 
 #endif
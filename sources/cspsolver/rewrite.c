@@ -1,6 +1,5 @@
 #include "rewrite.h"
 #include "vardb.h"
-#include <math.h>
 
 #define DEBUG 0
 
@@ -142,6 +141,29 @@ int calcFunctionCall(FunctionCall fc, List substset) {
 	return -1;
 }
 
+/* base to the power exponent in integer arithmetic, by repeated squaring */
+static int intPower(int base, int exponent) {
+	unsigned int b = base, result = 1;
+	if(exponent < 0) {
+		if(base == 0) {
+			error("Division by zero in a power with a negative exponent.\n");
+		}
+		/* the integer part of 1/base^-exponent */
+		if(base == 1 || base == -1) {
+			return (exponent % 2 == 0 ? 1 : base);
+		}
+		return 0;
+	}
+	while(exponent > 0) {
+		if(exponent & 1) {
+			result *= b;
+		}
+		b *= b;
+		exponent >>= 1;
+	}
+	return (int) result;
+}
+
 int calcValue(Value v, List substset) {
 	int val;
 	VarCall vc;
@@ -172,7 +194,7 @@ int calcValue(Value v, List substset) {
 			error("@calcValue, value has wrong type.\n");
 	}
 	if(v->powtok) {
-		val = pow(val, calcFactor(v->exponent, substset));
+		val = intPower(val, calcFactor(v->exponent, substset));
 	}
 	return val;
 }
@@ -194,6 +216,9 @@ int calcTerm(Term t, List substset) {
 		char *operator = operatorList->item;
 		Factor t = factorList->item;
 		int factorval = calcFactor(t, substset);
+		if(factorval == 0 && strcmp(operator, "*")) {
+			error("Division by zero.\n");
+		}
 		if(!strcmp(operator, "*")) {
 			val *= factorval;
 		} else if(!strcmp(operator, "div")) {
@@ -252,6 +277,71 @@ int calcConstraint(Constraint c, List substset) {
 	return (val1 >= val2);
 }
 
+/*
+  Whether an expression is constant once the loop variables of the
+  enclosing foralls are substituted, i.e. refers to no model variable.
+  Such expressions are printed as their value.
+*/
+static int constantBase(Value v) {
+	switch(v->type) {
+		case INT:
+			return 1;
+		case VARSUBSTCALL:
+			return (getVariableFromDB(((VarCall) v->data)->name) == NULL);
+		case FUNCTIONCALL:
+			return constantFunctionCall(v->data);
+		case NUMEXP:
+			return constantNumExp(v->data);
+		default:
+			return 0;
+	}
+}
+
+int constantValue(Value v) {
+	return constantBase(v) && (!v->powtok || constantFactor(v->exponent));
+}
+
+int constantFactor(Factor f) {
+	if(f->type == VALUE) {
+		return constantValue(f->data);
+	}
+	return constantFactor(f->data);
+}
+
+int constantTerm(Term t) {
+	List factorList;
+	for(factorList = t->factorList; factorList != NULL; factorList = factorList->next) {
+		if(!constantFactor(factorList->item)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int constantNumExp(NumExp exp) {
+	List termList;
+	for(termList = exp->termList; termList != NULL; termList = termList->next) {
+		if(!constantTerm(termList->item)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* max, min and abs of constants; the other functions range over model variables */
+int constantFunctionCall(FunctionCall fc) {
+	List args;
+	if(fc->type != MAXMIN && fc->type != ABS) {
+		return 0;
+	}
+	for(args = fc->argList; args != NULL; args = args->next) {
+		if(!constantNumExp(args->item)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
 int calcElemsSize(List dimsizes, List substset) {
 	if(dimsizes == NULL) {
 		return 1;
@@ -395,11 +485,239 @@ void rewriteVarCall(VarCall vc, List substset, int domainset) {
 	free(indices.array);
 }
 
+/*
+  The indices of arrays indexed by model variables in the constraint that is
+  being rewritten. They have to stay within the array, like constant indices,
+  which is written as constraints 0 <= index <= max after the constraint.
+  Inside all or any the bounds are part of the constraint with the element
+  instead: all(c, index >= 0, index <= max).
+*/
+typedef struct indexBound {
+	NumExp index;
+	int max;
+	List substset;
+} indexBound;
+
+static List indexBounds = NULL, lastIndexBound = NULL;
+static int writingIndexBounds = 0;
+
+static void addIndexBound(NumExp index, int max, List substset) {
+	indexBound *b;
+	if(writingIndexBounds) {
+		return;
+	}
+	b = safeMalloc(sizeof(indexBound));
+	*b = (indexBound){index, max, substset};
+	indexBounds = addToListEnd(b, indexBounds, &lastIndexBound);
+}
+
+/* writes the bounds as constraints, or as arguments of all() if nested */
+static void rewriteIndexBounds(int nested) {
+	int writing = writingIndexBounds;
+	List l;
+	writingIndexBounds = 1;
+	for(l = indexBounds; l != NULL; l = l->next) {
+		indexBound *b = l->item;
+		if(nested) {
+			fprintf(stdout, ", ");
+		}
+		rewriteNumExp(b->index, b->substset);
+		fprintf(stdout, " >= 0");
+		if(nested) {
+			fprintf(stdout, ", ");
+		} else {
+			printLineEnd();
+		}
+		rewriteNumExp(b->index, b->substset);
+		fprintf(stdout, " <= %d", b->max);
+		if(!nested) {
+			printLineEnd();
+		}
+	}
+	writingIndexBounds = writing;
+	freeList(indexBounds);
+	indexBounds = NULL;
+	lastIndexBound = NULL;
+}
+
+/* whether an index of vc depends on a model variable */
+static int variableIndexed(VarCall vc) {
+	List indices, subdoms;
+	for(indices = vc->indices; indices != NULL; indices = indices->next) {
+		for(subdoms = indices->item; subdoms != NULL; subdoms = subdoms->next) {
+			Subdomain subdom = subdoms->item;
+			if(!constantNumExp(subdom->min) || !constantNumExp(subdom->max)) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+static int elementNumExp(NumExp exp);
+
+static int elementFactor(Factor f);
+
+/*
+  Whether v selects an array element by a model variable. The constraints
+  of all and any are not searched, they bound their own elements.
+*/
+static int elementValue(Value v) {
+	List args;
+	if(v->powtok && elementFactor(v->exponent)) {
+		return 1;
+	}
+	switch(v->type) {
+		case VARSUBSTCALL:
+			return (getVariableFromDB(((VarCall) v->data)->name) != NULL && variableIndexed(v->data));
+		case FUNCTIONCALL:
+			if(((FunctionCall) v->data)->type != MAXMIN && ((FunctionCall) v->data)->type != ABS) {
+				return 0;
+			}
+			for(args = ((FunctionCall) v->data)->argList; args != NULL; args = args->next) {
+				if(elementNumExp(args->item)) {
+					return 1;
+				}
+			}
+			return 0;
+		case NUMEXP:
+			return elementNumExp(v->data);
+		default:
+			return 0;
+	}
+}
+
+static int elementFactor(Factor f) {
+	if(f->type == VALUE) {
+		return elementValue(f->data);
+	}
+	return elementFactor(f->data);
+}
+
+static int elementNumExp(NumExp exp) {
+	List terms, factors;
+	for(terms = exp->termList; terms != NULL; terms = terms->next) {
+		for(factors = ((Term) terms->item)->factorList; factors != NULL; factors = factors->next) {
+			if(elementFactor(factors->item)) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/*
+  A constraint that is an argument of all or any. An element in it only
+  exists within the array where the constraint is written, so its index
+  bounds are written in the constraint: all(c, index >= 0, index <= max).
+*/
+static void rewriteNestedConstraint(Constraint c, List substset) {
+	List bounds = indexBounds, lastBound = lastIndexBound;
+	if(!elementNumExp(c->exp1) && (c->exp2 == NULL || !elementNumExp(c->exp2))) {
+		rewriteConstraint(c, substset);
+		return;
+	}
+	indexBounds = NULL;
+	lastIndexBound = NULL;
+	fprintf(stdout, "all(");
+	rewriteConstraint(c, substset);
+	rewriteIndexBounds(1);
+	fprintf(stdout, ")");
+	indexBounds = bounds;
+	lastIndexBound = lastBound;
+}
+
+/*
+  An array element selected by model variables, x[i][y] with y a variable,
+  is written as the list of the entries it can select, indexed by the
+  position among them: [X.., X..][y]. With more variable indices the
+  position is y1 * n2 + y2, with n2 the size of the dimension of y2.
+*/
+static void rewriteElement(VarCall vc, List substset) {
+	Variable var = getVariableFromDB(vc->name);
+	List dimsizes = var->dimsizes, indices = vc->indices;
+	NumExp *selectors = safeMalloc(var->dims*sizeof(NumExp));
+	int *sizes = safeMalloc(var->dims*sizeof(int));
+	int *mults = safeMalloc(var->dims*sizeof(int));
+	int base = var->globalIndex, count = 1, stride, first = 1, position, rest, global, d;
+	
+	if(listLength(indices) != var->dims) {
+		error("Type conflict: only a single value is allowed here.");
+	}
+	for(d = 0; d < var->dims; d++) {
+		List subdoms = indices->item;
+		Subdomain subdom = subdoms->item;
+		sizes[d] = calcNumExp(dimsizes->item, NULL);
+		mults[d] = calcElemsSize(dimsizes->next, substset);
+		if(subdoms->next != NULL || subdom->min != subdom->max) {
+			error("Type conflict: a variable index can not select a range of values.");
+		}
+		if(constantNumExp(subdom->min)) {
+			int idx = calcNumExp(subdom->min, substset);
+			if(idx < 0 || idx >= sizes[d]) {
+				char str[strlen(vc->name)+100];
+				strcpy(str, "Index out of bounds (variable '");
+				strcat(str, vc->name);
+				strcat(str, "')\n");
+				error(str);
+			}
+			base += idx*mults[d];
+			selectors[d] = NULL;
+		} else {
+			selectors[d] = subdom->min;
+			count *= sizes[d];
+		}
+		dimsizes = dimsizes->next;
+		indices = indices->next;
+	}
+	
+	printBracketOpen();
+	for(position = 0; position < count; position++) {
+		printComma(position > 0);
+		global = base;
+		rest = position;
+		for(d = var->dims-1; d >= 0; d--) {
+			if(selectors[d] != NULL) {
+				global += (rest % sizes[d])*mults[d];
+				rest /= sizes[d];
+			}
+		}
+		printNFVar(global);
+	}
+	printBracketClose();
+	printBracketOpen();
+	stride = count;
+	for(d = 0; d < var->dims; d++) {
+		if(selectors[d] == NULL) {
+			continue;
+		}
+		stride /= sizes[d];
+		if(!first) {
+			fprintf(stdout, " + ");
+		}
+		if(stride > 1) {
+			fprintf(stdout, "(");
+			rewriteNumExp(selectors[d], substset);
+			fprintf(stdout, ") * %d", stride);
+		} else {
+			rewriteNumExp(selectors[d], substset);
+		}
+		addIndexBound(selectors[d], sizes[d]-1, substset);
+		first = 0;
+	}
+	printBracketClose();
+	free(selectors);
+	free(sizes);
+	free(mults);
+}
+
 void rewriteVarSubstCall(VarCall vc, List substset) {
 	char *name = vc->name;
 	Variable var = getVariableFromDB(name);
 	if(var == NULL) {
 		fprintf(stdout, "%d", getSubstitution(name, substset)->val);
+	} else if(variableIndexed(vc)) {
+		rewriteElement(vc, substset);
 	} else {
 		sizedArray indices = obtainVarCallIndices(vc, substset);
 		
@@ -583,38 +901,127 @@ void rewriteProduct(List varcalls, List substset) {
 	free(indices.array);
 }
 
-void rewriteMaximum(List varcalls, List substset) {
+/* a single max or min call over all variables, a lone variable is written as is */
+static void rewriteExtremum(List varcalls, List substset, char *name, char *emptyError) {
 	sizedArray indices = mergedSets(varcalls, substset);
 	
 	if(indices.size == 0) {
-		error("@maximum: maximum over an empty set.");
+		error(emptyError);
 	}
-	for(int i = 0; i < indices.size-1; i++) {
-		fprintf(stdout, "max(");
-		printNFVar(indices.array[i]);
+	if(indices.size > 1) {
+		fprintf(stdout, "%s(", name);
+	}
+	printNFVar(indices.array[0]);
+	for(int i = 1; i < indices.size; i++) {
 		fprintf(stdout, ", ");
+		printNFVar(indices.array[i]);
 	}
-	printNFVar(indices.array[indices.size-1]);
-	for(int i = 0; i < indices.size-1; i++) {
+	if(indices.size > 1) {
 		fprintf(stdout, ")");
 	}
 	free(indices.array);
 }
 
+void rewriteMaximum(List varcalls, List substset) {
+	rewriteExtremum(varcalls, substset, "max", "@maximum: maximum over an empty set.");
+}
+
 void rewriteMinimum(List varcalls, List substset) {
-	sizedArray indices = mergedSets(varcalls, substset);
+	rewriteExtremum(varcalls, substset, "min", "@minimum: minimum over an empty set.");
+}
+
+/*
+  A table, the variables of args->item and a tuple of values for them in every
+  next item, as the disjunction of its tuples: any(all(X1 = a1, .., Xn = an), ..).
+  The solver recognizes this form and propagates it as a table constraint.
+*/
+void rewriteTable(List args, List substset) {
+	sizedArray indices = mergedSets(args->item, substset);
+	List tuples, values;
+	int i;
 	
+	fprintf(stdout, "any(");
+	for(tuples = args->next; tuples != NULL; tuples = tuples->next) {
+		if(listLength(tuples->item) != indices.size) {
+			error("@table: every tuple needs a value for each variable.");
+		}
+		printComma(tuples != args->next);
+		fprintf(stdout, "all(");
+		for(values = tuples->item, i = 0; values != NULL; values = values->next, i++) {
+			printComma(i > 0);
+			printNFVar(indices.array[i]);
+			fprintf(stdout, " = %d", calcNumExp(values->item, substset));
+		}
+		fprintf(stdout, ")");
+	}
+	fprintf(stdout, ")");
+	free(indices.array);
+}
+
+/* the number of the variables in indices that equal value, as any(X1 = v) + .. + any(Xn = v) */
+static void printCount(sizedArray indices, int value) {
 	if(indices.size == 0) {
-		error("@minimum: minimum over an empty set.");
+		fprintf(stdout, "(0)");
+		return;
 	}
-	for(int i = 0; i < indices.size-1; i++) {
-		fprintf(stdout, "min(");
+	fprintf(stdout, "(");
+	for(int i = 0; i < indices.size; i++) {
+		if(i > 0) {
+			fprintf(stdout, " + ");
+		}
+		fprintf(stdout, "any(");
 		printNFVar(indices.array[i]);
-		fprintf(stdout, ", ");
+		fprintf(stdout, " = %d)", value);
 	}
-	printNFVar(indices.array[indices.size-1]);
-	for(int i = 0; i < indices.size-1; i++) {
-		fprintf(stdout, ")");
+	fprintf(stdout, ")");
+}
+
+/*
+  A count, the number of the variables of args->item that equal the value
+  args->next->item. The solver recognizes the sum it is written as and
+  propagates its comparison as a count constraint.
+*/
+void rewriteCount(List args, List substset) {
+	sizedArray indices = mergedSets(args->item, substset);
+	
+	printCount(indices, calcNumExp(args->next->item, substset));
+	free(indices.array);
+}
+
+/*
+  A global cardinality constraint over the variables of args->item: the
+  tuples that follow are values, their least and their largest number of
+  occurrences. Written as a count per value; other values are not limited.
+*/
+void rewriteGcc(List args, List substset) {
+	sizedArray indices = mergedSets(args->item, substset);
+	List values, lows, highs;
+	
+	if(listLength(args) != 4) {
+		error("@gcc: expecting a tuple of values, of lower bounds and of upper bounds.");
+	}
+	values = args->next->item;
+	lows = args->next->next->item;
+	highs = args->next->next->next->item;
+	if(listLength(lows) != listLength(values) || listLength(highs) != listLength(values)) {
+		error("@gcc: every value needs a lower and an upper bound.");
+	}
+	for(; values != NULL; values = values->next, lows = lows->next, highs = highs->next) {
+		int value = calcNumExp(values->item, substset);
+		int low = calcNumExp(lows->item, substset);
+		int high = calcNumExp(highs->item, substset);
+		if(values != args->next->item) {
+			printLineEnd();
+		}
+		printCount(indices, value);
+		if(low == high) {
+			fprintf(stdout, " = %d", low);
+			continue;
+		}
+		fprintf(stdout, " >= %d", low);
+		printLineEnd();
+		printCount(indices, value);
+		fprintf(stdout, " <= %d", high);
 	}
 	free(indices.array);
 }
@@ -633,11 +1040,11 @@ void rewriteFunctionCall(FunctionCall fc, List substset) {
 		case ALLANY:
 			fprintf(stdout, "%s", fc->funcName);
 			fprintf(stdout, "(");
-			rewriteConstraint(args->item, substset);
+			rewriteNestedConstraint(args->item, substset);
 			args = args->next;
 			while(args != NULL) {
 				fprintf(stdout, ", ");
-				rewriteConstraint(args->item, substset);
+				rewriteNestedConstraint(args->item, substset);
 				args = args->next;
 			}
 			fprintf(stdout, ")");
@@ -672,6 +1079,15 @@ void rewriteFunctionCall(FunctionCall fc, List substset) {
 		case MINIMUM:
 			rewriteMinimum(args, substset);
 			break;
+		case TABLE:
+			rewriteTable(args, substset);
+			break;
+		case COUNT:
+			rewriteCount(args, substset);
+			break;
+		case GCC:
+			rewriteGcc(args, substset);
+			break;
 		default:
 			error("FunctionCall has wrong type.\n");
 	}
@@ -688,7 +1104,12 @@ void rewriteValue(Value v, List substset) {
 			rewriteVarSubstCall(v->data, substset);
 			break;
 		case FUNCTIONCALL:
-			rewriteFunctionCall(v->data, substset);
+			if(constantFunctionCall(v->data)) {
+				/* the base of a power, may be negative */
+				fprintf(stdout, "(%d)", calcFunctionCall(v->data, substset));
+			} else {
+				rewriteFunctionCall(v->data, substset);
+			}
 			break;
 		case NUMEXP:
 			fprintf(stdout, "(");
@@ -698,10 +1119,18 @@ void rewriteValue(Value v, List substset) {
 		default:
 			error("Value has wrong type.\n");
 	}
+	if(v->powtok) {
+		fprintf(stdout, "^");
+		rewriteFactor(v->exponent, substset);
+	}
 }
 
 void rewriteFactor(Factor f, List substset) {
 	debug("\nrewrite Factor\n");
+	if(constantFactor(f)) {
+		fprintf(stdout, "%d", calcFactor(f, substset));
+		return;
+	}
 	if(f->type == VALUE) {
 		rewriteValue(f->data, substset);
 	} else { /* f->type == NEGATION */
@@ -712,6 +1141,10 @@ void rewriteFactor(Factor f, List substset) {
 
 void rewriteTerm(Term t, List substset) {
 	debug("\nrewrite term\n");
+	if(constantTerm(t)) {
+		fprintf(stdout, "%d", calcTerm(t, substset));
+		return;
+	}
 	List factorList = t->factorList;
 	List operatorList = t->operatorList;
 	rewriteFactor(factorList->item, substset);
@@ -725,15 +1158,40 @@ void rewriteTerm(Term t, List substset) {
 }
 
 void rewriteNumExp(NumExp exp, List substset) {
-	List termList = exp->termList;
+	if(constantNumExp(exp)) {
+		fprintf(stdout, "%d", calcNumExp(exp, substset));
+		return;
+	}
+	/* 
+	  the constant terms are summed; the sum is printed in front if the
+	  expression starts with a constant, otherwise at the end
+	*/
+	Term firstTerm = exp->termList->item;
+	List termList = exp->termList->next;
 	List operatorList = exp->operatorList;
-	rewriteTerm(termList->item, substset);
-	termList = termList->next;
-	while(termList != NULL) {
-		fprintf(stdout, " %s ", (char *) operatorList->item);
-		rewriteTerm(termList->item, substset);
-		termList = termList->next;
-		operatorList = operatorList->next;
+	int constantFirst = constantTerm(firstTerm);
+	int sum = (constantFirst ? calcTerm(firstTerm, substset) : 0);
+	for(; termList != NULL; termList = termList->next, operatorList = operatorList->next) {
+		if(constantTerm(termList->item)) {
+			int termval = calcTerm(termList->item, substset);
+			sum += (strcmp(operatorList->item, "-") ? termval : -termval);
+		}
+	}
+	if(constantFirst) {
+		fprintf(stdout, "%d", sum);
+	} else {
+		rewriteTerm(firstTerm, substset);
+	}
+	termList = exp->termList->next;
+	operatorList = exp->operatorList;
+	for(; termList != NULL; termList = termList->next, operatorList = operatorList->next) {
+		if(!constantTerm(termList->item)) {
+			fprintf(stdout, " %s ", (char *) operatorList->item);
+			rewriteTerm(termList->item, substset);
+		}
+	}
+	if(!constantFirst && sum != 0) {
+		fprintf(stdout, (sum < 0 ? " - %d" : " + %d"), (sum < 0 ? -sum : sum));
 	}
 }
 
@@ -750,6 +1208,7 @@ void rewriteConstraintSpec(RecursiveType cs, List substset) {
 		Constraint c = (Constraint) cs->data;
 		rewriteConstraint(c, substset);
 		printLineEnd();
+		rewriteIndexBounds(0);
 	} else { /* cs->type == FORALL */
 		ForAll forall = cs->data;
 		char *varname = forall->varname;
@@ -22,6 +22,9 @@ void rewriteDomain(List subdoms, List substset);
 void rewriteDomainSpec(RecursiveType domspec, List substset);
 
 void rewriteAllDiff(List varcalls, List substset);
+void rewriteTable(List args, List substset);
+void rewriteCount(List args, List substset);
+void rewriteGcc(List args, List substset);
 
 
 void rewriteNumExp(NumExp, List substset);
@@ -34,11 +37,18 @@ void rewriteConstraint(Constraint c, List substset);
 
 int calcConstraint(Constraint c, List substset);
 int calcNumExp(NumExp exp, List substset);
+int dimCount(List dimsizes);
 int calcTerm(Term exp, List substset);
 int calcFactor(Factor exp, List substset);
 int calcValue(Value exp, List substset);
 int calcFunctionCall(FunctionCall exp, List substset);
 
+int constantNumExp(NumExp exp);
+int constantTerm(Term t);
+int constantFactor(Factor f);
+int constantValue(Value v);
+int constantFunctionCall(FunctionCall fc);
+
 
 void rewriteConstraintSpec(RecursiveType cs, List substset);
 void printNFVar(int idx);
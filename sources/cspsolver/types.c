@@ -100,6 +100,14 @@ Factor newFactor(Type ftype, void *data) {
 	return f;
 }
 
+/* the expression holding only the integer value */
+NumExp newConstantNumExp(int value) {
+	char *token = safeMalloc(12);
+	sprintf(token, "%d", value);
+	Factor f = newFactor(VALUE, newValue(INT, token, 0, NULL));
+	return newNumExp(newList(newTerm(newList(f, NULL), NULL), NULL), NULL);
+}
+
 FunctionCall newFunctionCall(Type type, char *funcName, List argList) {
 	FunctionCall fc = safeMalloc(sizeof(functionCall));
 	fc->type = type;
@@ -23,7 +23,7 @@ typedef struct subdomain *Subdomain;
 typedef enum {
 	FUNCTIONCALL, INT,
 	VALUE, FACTOR, NUMEXP, CONSTRAINT, FORALL, DOMSET, NEGATION, VARSUBSTCALL,
-	MAXMIN, ALLANY, ABS, ALLDIFF, SUM, PRODUCT, MAXIMUM, MINIMUM, EQUAL, INCREASING, DECREASING
+	MAXMIN, ALLANY, ABS, ALLDIFF, SUM, PRODUCT, MAXIMUM, MINIMUM, EQUAL, INCREASING, DECREASING, TABLE, COUNT, GCC
 } Type;
 
 typedef struct vardef {
@@ -118,5 +118,6 @@ NumExp newNumExp(List explist, List opList);
 Term newTerm(List factorList, List opList);
 Factor newFactor(Type ftype, void *data);
 FunctionCall newFunctionCall(Type type, char *funcName, List argList);
+NumExp newConstantNumExp(int value);
 
 #endif
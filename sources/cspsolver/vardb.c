@@ -1,9 +1,13 @@
 #include <stdio.h> 
 #include <stdlib.h> 
+#include <ctype.h>
 #include "rewrite.h"
 
 #include "vardb.h"
 
+int currentIndex;
+VarDB globalVarDB;
+
 Variable newVariable(char *name, int dims, List dimcounts) {
 	Variable var = malloc(sizeof(variable));
 	assert(var != NULL);
@@ -142,3 +146,92 @@ void checkDomainsSet() {
 		varList = varList->next;
 	}
 }
+
+static int dataError(char *path, int line, char *message, char *name) {
+	fprintf(stderr, "[ERROR] %s, line %d: %s%s\n", path, line, message, name);
+	return 0;
+}
+
+/* the next character of in that is not part of a comment */
+static int dataChar(FILE *in) {
+	int c = getc(in);
+	if(c == '#') {
+		while(c != '\n' && c != EOF) {
+			c = getc(in);
+		}
+	}
+	return c;
+}
+
+/* skips white space starting at c, counting lines */
+static int skipSpace(FILE *in, int c, int *line) {
+	while(isspace(c)) {
+		if(c == '\n') {
+			(*line)++;
+		}
+		c = dataChar(in);
+	}
+	return c;
+}
+
+/*
+  Copies instance data (see basicsolver/data.h) from in to out, replacing
+  the variables of the model, like b[2][3], by those of the normal form.
+  Returns 0 after an error has been reported.
+*/
+int translateData(FILE *in, FILE *out, char *path) {
+	char name[256];
+	int c, length, index, subidx, line = 1;
+	Variable var;
+	List dimsizes;
+
+	for(;;) {
+		c = skipSpace(in, dataChar(in), &line);
+		if(c == EOF) {
+			return 1;
+		}
+		length = 0;
+		while((c == '_' || isalnum(c)) && length < sizeof(name)-1) {
+			name[length++] = c;
+			c = dataChar(in);
+		}
+		name[length] = '\0';
+		var = getVariableFromDB(name);
+		if(var == NULL) {
+			return dataError(path, line, "unknown variable ", name);
+		}
+		index = var->globalIndex;
+		dimsizes = var->dimsizes;
+		c = skipSpace(in, c, &line);
+		while(c == '[') {
+			if(dimsizes == NULL || fscanf(in, "%d", &subidx) != 1) {
+				return dataError(path, line, "bad index of ", name);
+			}
+			if(subidx < 0 || subidx >= calcNumExp(dimsizes->item, NULL)) {
+				return dataError(path, line, "index out of bounds of ", name);
+			}
+			dimsizes = dimsizes->next;
+			index += subidx*dimCount(dimsizes);
+			if(skipSpace(in, dataChar(in), &line) != ']') {
+				return dataError(path, line, "expecting ']' after index of ", name);
+			}
+			c = skipSpace(in, dataChar(in), &line);
+		}
+		if(dimsizes != NULL) {
+			return dataError(path, line, "expecting an index for every dimension of ", name);
+		}
+		fprintf(out, "X%d ", index);
+		/* the values are copied as they are */
+		while(c != ';') {
+			if(c == EOF) {
+				return dataError(path, line, "expecting ';'", "");
+			}
+			if(c == '\n') {
+				line++;
+			}
+			fputc(c, out);
+			c = dataChar(in);
+		}
+		fprintf(out, ";\n");
+	}
+}
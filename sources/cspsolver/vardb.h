@@ -2,6 +2,7 @@
 #define VARDB_H
 
 #include <assert.h>
+#include <stdio.h>
 #include <string.h>
 #include "list.h"
 
@@ -12,8 +13,8 @@ typedef struct variable *Variable;
 typedef struct indexer *Index;
 */
 
-int currentIndex;
-VarDB globalVarDB;
+extern int currentIndex;
+extern VarDB globalVarDB;
 
 typedef struct vardb {
 	List first;
@@ -45,5 +46,6 @@ void createEmptyVarDB();
 void addVarToDB(Variable var);
 void checkDomainsSet();
 void domainVarSet(Variable var, int globalIndex);
+int translateData(FILE *in, FILE *out, char *path);
 
 #endif